@@ -0,0 +1,78 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+/**
+ * OpenGL context of the unit tests and benchmarks (without a dependency on aglet when
+ * the headless EGL backend is compiled in).
+ */
+#ifndef OGLES_GPGPU_APP_GL_CONTEXT
+#define OGLES_GPGPU_APP_GL_CONTEXT
+
+#include "ogles_gpgpu/platform/opengl/gl_definitions.h" // OGLES_GPGPU_EGL_HEADLESS
+
+#include <memory>
+
+#if defined(OGLES_GPGPU_EGL_HEADLESS)
+#include "../platform/linux/egl_headless.h" // no display server needed, see OGLES_GPGPU_EGL_API
+#else
+#include <aglet/GLContext.h>
+#endif
+
+namespace ogles_gpgpu {
+
+#if defined(OGLES_GPGPU_EGL_HEADLESS)
+/**
+ * EGLHeadless with the interface of aglet::GLContext: operator bool() checks the context
+ * and operator()() makes it current.
+ */
+struct HeadlessGLContext {
+    explicit operator bool() const {
+        return egl.isValid();
+    }
+
+    void operator()() {
+        if (egl.isValid()) {
+            egl.activate();
+        }
+    }
+
+    EGLHeadless egl;
+};
+
+typedef std::shared_ptr<HeadlessGLContext> GLContextPtr;
+
+/**
+ * Create a headless EGL context of the API of OGLES_GPGPU_EGL_API (default: the API of
+ * the library) with a <width> x <height> pbuffer. Check the result and make it current
+ * with (*context)().
+ */
+inline GLContextPtr createGLContext(int width, int height) {
+    auto context = std::make_shared<HeadlessGLContext>();
+    context->egl.setup(EGLHeadless::getDefaultAPI(), width, height);
+    return context;
+}
+#else
+#if defined(OGLES_GPGPU_OPENGL_ES2)
+static const aglet::GLContext::GLVersion kGLContextVersion = aglet::GLContext::kGLES20;
+#elif defined(OGLES_GPGPU_OPENGL_ES3)
+static const aglet::GLContext::GLVersion kGLContextVersion = aglet::GLContext::kGLES30;
+#else
+static const aglet::GLContext::GLVersion kGLContextVersion = aglet::GLContext::kGL;
+#endif
+
+typedef decltype(aglet::GLContext::create(aglet::GLContext::kAuto, {}, 0, 0, kGLContextVersion)) GLContextPtr;
+
+/**
+ * Create an aglet context of the API of the library with a <width> x <height> window or
+ * pbuffer. Check the result and make it current with (*context)().
+ */
+inline GLContextPtr createGLContext(int width, int height) {
+    return aglet::GLContext::create(aglet::GLContext::kAuto, {}, width, height, kGLContextVersion);
+}
+#endif
+}
+
+#endif
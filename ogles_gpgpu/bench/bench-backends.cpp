@@ -0,0 +1,121 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+// Backend benchmark: runs the processors that provide a compute shader on the fragment
+// and on the compute backend side by side and reports the median frame time of both.
+//
+// Usage: bench-backends [width height frames]
+
+#include "../app/gl_context.h" // headless EGL or aglet context of the library API
+
+// clang-format off
+#include "../common/proc/video.h"
+#include "../common/proc/gauss_opt.h"
+#include "../common/proc/box_opt.h"
+#include "../common/proc/separable.h"
+#include "../common/gl/caps.h"
+// clang-format on
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+using Backend = ogles_gpgpu::FilterProcBase::Backend;
+
+using ProcFactory = std::function<ogles_gpgpu::MultiPassProc*(Backend backend)>;
+
+template <typename T>
+static T* withBackend(T* proc, Backend backend) {
+    proc->setBackend(backend);
+    return proc;
+}
+
+// Returns the median frame time in ms and the backend that was used
+static double run(const ProcFactory& factory, Backend backend, const std::vector<unsigned char>& image, const ogles_gpgpu::Size2d& size, int frames, Backend& used) {
+    glActiveTexture(GL_TEXTURE0);
+    ogles_gpgpu::VideoSource video;
+
+    std::unique_ptr<ogles_gpgpu::MultiPassProc> proc(factory(backend));
+    video.set(proc.get());
+
+    std::vector<double> frameMs;
+    for (int i = 0; i < frames; i++) {
+        const auto begin = Clock::now();
+        video(size, const_cast<unsigned char*>(image.data()), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        glFinish();
+        frameMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - begin).count());
+    }
+
+    used = static_cast<ogles_gpgpu::FilterProcBase*>(proc->getOutputFilter())->getBackend();
+
+    // skip the first frame (setup)
+    std::vector<double> sorted(frameMs.begin() + 1, frameMs.end());
+    std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+    return sorted[sorted.size() / 2];
+}
+
+int main(int argc, char** argv) {
+    int width = 640, height = 480, frames = 100;
+    if (argc == 4) {
+        width = std::atoi(argv[1]);
+        height = std::atoi(argv[2]);
+        frames = std::atoi(argv[3]);
+    }
+
+    if (width <= 0 || height <= 0 || frames < 2) {
+        std::fprintf(stderr, "usage: %s [width height frames]\n", argv[0]);
+        return 1;
+    }
+
+    auto context = ogles_gpgpu::createGLContext(width, height);
+    if (!context || !(*context)) {
+        std::fprintf(stderr, "could not create an OpenGL context\n");
+        return 1;
+    }
+    (*context)();
+
+    const std::vector<std::pair<std::string, ProcFactory>> procs = {
+        { "gauss2", [](Backend b) { return withBackend(new ogles_gpgpu::GaussOptProc(2.f), b); } },
+        { "gauss7", [](Backend b) { return withBackend(new ogles_gpgpu::GaussOptProc(7.f), b); } },
+        { "box5", [](Backend b) { return withBackend(new ogles_gpgpu::BoxOptProc(5.f), b); } },
+        { "dog", [](Backend b) {
+             const auto g = ogles_gpgpu::SeparableKernel::gaussian(4, 2.f);
+             const auto dg = ogles_gpgpu::SeparableKernel::gaussianDerivative(4, 2.f);
+             return withBackend(new ogles_gpgpu::SeparableFilterProc(dg, g, 0.5f), b);
+         } },
+    };
+
+    std::vector<unsigned char> image(width * height * 4);
+    for (int i = 0; i < width * height; i++) {
+        image[i * 4 + 0] = static_cast<unsigned char>(i * 7);
+        image[i * 4 + 1] = static_cast<unsigned char>(i * 13);
+        image[i * 4 + 2] = static_cast<unsigned char>(i * 29);
+        image[i * 4 + 3] = 255;
+    }
+
+    const ogles_gpgpu::Size2d size(width, height);
+
+    std::printf("%dx%d, %d frames, compute shaders: %d\n", width, height, frames, ogles_gpgpu::GLCaps::get().computeShaders);
+    std::printf("%-10s %14s %14s %10s\n", "proc", "fragment[ms]", "compute[ms]", "speedup");
+    for (const auto& proc : procs) {
+        Backend usedFragment, usedCompute;
+        const double fragmentMs = run(proc.second, ogles_gpgpu::FilterProcBase::kFragmentBackend, image, size, frames, usedFragment);
+        const double computeMs = run(proc.second, ogles_gpgpu::FilterProcBase::kComputeBackend, image, size, frames, usedCompute);
+        if (usedCompute != ogles_gpgpu::FilterProcBase::kComputeBackend) {
+            std::printf("%-10s %14.2f %14s %10s\n", proc.first.c_str(), fragmentMs, "n/a", "");
+        } else {
+            std::printf("%-10s %14.2f %14.2f %9.2fx\n", proc.first.c_str(), fragmentMs, computeMs, fragmentMs / computeMs);
+        }
+    }
+
+    return 0;
+}
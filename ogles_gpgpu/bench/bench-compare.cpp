@@ -0,0 +1,205 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+// Benchmark comparison: compares two JSON outputs of bench-procs (or any Google Benchmark),
+// a baseline and a contender, and prints a table of the median real time of each benchmark
+// (processor, resolution, depth and transfer mode), its change and the p value of a two sided
+// Mann-Whitney U test of the repetitions. A benchmark is flagged as slower (faster) if its
+// median changed by more than <threshold> percent and p < <alpha>. Without repetitions in
+// both files there is no test and the threshold decides alone. The summary shows the
+// geometric mean of the changes of each processor. A warning is printed if the contexts of
+// the runs differ in executable, host or CPU count.
+//
+// Usage: bench-compare <baseline.json> <contender.json> [threshold alpha]
+//
+// i.e. bench-procs --benchmark_repetitions=5 --benchmark_out=new.json --benchmark_out_format=json
+// The U test can't find a difference with less than 4 repetitions at alpha = 0.05.
+//
+// Returns 0 if no benchmark is slower, 2 if one is and 1 on errors.
+
+#include "../common/stats.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+static const double kDefaultThreshold = 5.0; // percent
+static const double kDefaultAlpha = 0.05;
+
+// Real times in ms of the repetitions of one benchmark
+struct Samples {
+    std::vector<double> ms;
+
+    double getMedian() const {
+        std::vector<double> sorted = ms;
+        std::sort(sorted.begin(), sorted.end());
+        const std::size_t n = sorted.size();
+        return (n % 2) ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0;
+    }
+};
+
+// Context entries that describe the machine, absolute times of runs that differ in one of
+// them are not comparable
+static const char* kMachineContext[] = { "executable", "host_name", "num_cpus" };
+
+// Benchmark run: samples by benchmark name in order of appearance and the machine context
+struct Run {
+    std::vector<std::string> names;
+    std::map<std::string, Samples> samples;
+    std::map<std::string, std::string> context;
+};
+
+static double toMs(double time, const std::string& unit) {
+    if (unit == "ns") {
+        return time * 1e-6;
+    } else if (unit == "us") {
+        return time * 1e-3;
+    } else if (unit == "s") {
+        return time * 1e3;
+    }
+    return time;
+}
+
+static bool load(const char* filename, Run& run) {
+    std::ifstream file(filename);
+    if (!file) {
+        std::fprintf(stderr, "could not open %s\n", filename);
+        return false;
+    }
+
+    nlohmann::json json = nlohmann::json::parse(file, nullptr, false);
+    if (json.is_discarded() || json.find("benchmarks") == json.end()) {
+        std::fprintf(stderr, "%s is not a JSON benchmark output\n", filename);
+        return false;
+    }
+
+    const auto context = json.find("context");
+    if (context != json.end()) {
+        for (const char* key : kMachineContext) {
+            const auto value = context->find(key);
+            if (value != context->end()) {
+                run.context[key] = value->is_string() ? value->get<std::string>() : value->dump();
+            }
+        }
+    }
+
+    for (const auto& benchmark : json["benchmarks"]) {
+        // skip the aggregates (mean, median, ...) of repetitions and failed benchmarks
+        if (benchmark.value("run_type", "iteration") != "iteration" || benchmark.value("error_occurred", false)) {
+            continue;
+        }
+
+        const std::string name = benchmark.value("run_name", benchmark.value("name", ""));
+        const double ms = toMs(benchmark.value("real_time", 0.0), benchmark.value("time_unit", "ns"));
+        if (run.samples.find(name) == run.samples.end()) {
+            run.names.push_back(name);
+        }
+        run.samples[name].ms.push_back(ms);
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    double threshold = kDefaultThreshold, alpha = kDefaultAlpha;
+    if (argc == 5) {
+        threshold = std::atof(argv[3]);
+        alpha = std::atof(argv[4]);
+    }
+    if ((argc != 3 && argc != 5) || threshold < 0.0 || alpha <= 0.0) {
+        std::fprintf(stderr, "usage: %s <baseline.json> <contender.json> [threshold alpha]\n", argv[0]);
+        return 1;
+    }
+
+    Run baseline, contender;
+    if (!load(argv[1], baseline) || !load(argv[2], contender)) {
+        return 1;
+    }
+
+    bool differs = false;
+    for (const char* key : kMachineContext) {
+        const std::string& before = baseline.context[key];
+        const std::string& after = contender.context[key];
+        if (before != after) {
+            std::printf("warning: different %s \"%s\" and \"%s\"\n", key, before.c_str(), after.c_str());
+            differs = true;
+        }
+    }
+    if (differs) {
+        std::printf("\n");
+    }
+
+    std::size_t width = std::string("benchmark").size();
+    for (const auto& name : contender.names) {
+        width = std::max(width, name.size());
+    }
+
+    std::printf("| %-*s | %12s | %12s | %8s | %6s | %-7s |\n", int(width), "benchmark", "baseline ms", "contender ms", "change", "p", "");
+    std::printf("|%s|-------------:|-------------:|---------:|-------:|---------|\n", std::string(width + 2, '-').c_str());
+
+    int slower = 0, faster = 0, same = 0;
+    std::vector<std::string> families; // processors in order of appearance
+    std::map<std::string, std::pair<double, int>> familyChange; // sum of log ratios, count
+
+    for (const auto& name : contender.names) {
+        const auto base = baseline.samples.find(name);
+        if (base == baseline.samples.end()) {
+            continue;
+        }
+
+        const Samples& before = base->second;
+        const Samples& after = contender.samples[name];
+        const double oldMs = before.getMedian(), newMs = after.getMedian();
+        const double change = (newMs / oldMs - 1.0) * 100.0;
+
+        const bool tested = before.ms.size() > 1 && after.ms.size() > 1;
+        const double p = tested ? ogles_gpgpu::mannWhitneyUTest(before.ms, after.ms).p : 0.0;
+
+        const char* verdict = "";
+        if (p < alpha && change > threshold) {
+            verdict = "slower";
+            slower++;
+        } else if (p < alpha && change < -threshold) {
+            verdict = "faster";
+            faster++;
+        } else {
+            same++;
+        }
+
+        char pText[16] = "-";
+        if (tested) {
+            std::snprintf(pText, sizeof(pText), "%.3f", p);
+        }
+        std::printf("| %-*s | %12.3f | %12.3f | %+7.1f%% | %6s | %-7s |\n", int(width), name.c_str(), oldMs, newMs, change, pText, verdict);
+
+        const std::string family = name.substr(0, name.find('/'));
+        if (familyChange.find(family) == familyChange.end()) {
+            families.push_back(family);
+        }
+        familyChange[family].first += std::log(newMs / oldMs);
+        familyChange[family].second++;
+    }
+
+    std::printf("\n| %-20s | %8s |\n", "processor", "change");
+    std::printf("|----------------------|---------:|\n");
+    for (const auto& family : families) {
+        const auto& change = familyChange[family];
+        std::printf("| %-20s | %+7.1f%% |\n", family.c_str(), (std::exp(change.first / change.second) - 1.0) * 100.0);
+    }
+
+    const int compared = slower + faster + same;
+    std::printf("\n%d slower, %d faster, %d unchanged (threshold %.1f%%, alpha %.3f)\n", slower, faster, same, threshold, alpha);
+    std::printf("%d benchmarks only in %s, %d only in %s\n", int(baseline.names.size()) - compared, argv[1], int(contender.names.size()) - compared, argv[2]);
+
+    return slower ? 2 : 0;
+}
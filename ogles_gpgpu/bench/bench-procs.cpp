@@ -0,0 +1,299 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+// Processor throughput benchmark (Google Benchmark): runs every processor on frames from
+// VGA to 4K, as a chain of <depth> instances, with the input given as a texture ("texture"),
+// uploaded on each frame ("upload") or uploaded and read back ("roundtrip"). Each frame ends
+// with glFinish(), so the times include the GPU work. Processors with two inputs are not
+// covered.
+//
+// Usage: bench-procs [--benchmark_filter=<regex>] [--benchmark_out=<file> --benchmark_out_format=json]
+//
+// i.e. --benchmark_filter='GaussOptProc/res:1/.*/transfer:0' for all depths of GaussOptProc
+// at 720p with texture input.
+
+#include "../app/gl_context.h" // headless EGL or aglet context of the library API
+
+#include <benchmark/benchmark.h>
+
+// clang-format off
+#include "../common/proc/video.h"
+#include "../common/proc/gain.h"
+#include "../common/proc/grayscale.h"
+#include "../common/proc/rgb2luv.h"
+#include "../common/proc/rgb2hsv.h"
+#include "../common/proc/hsv2rgb.h"
+#include "../common/proc/swizzle.h"
+#include "../common/proc/letterbox.h"
+#include "../common/proc/gauss.h"
+#include "../common/proc/gauss_opt.h"
+#include "../common/proc/box_opt.h"
+#include "../common/proc/hessian.h"
+#include "../common/proc/lbp.h"
+#include "../common/proc/median.h"
+#include "../common/proc/grad.h"
+#include "../common/proc/thresh.h"
+#include "../common/proc/adapt_thresh.h"
+#include "../common/proc/lowpass.h"
+#include "../common/proc/highpass.h"
+#include "../common/proc/tensor.h"
+#include "../common/proc/shitomasi.h"
+#include "../common/proc/harris.h"
+#include "../common/proc/nms.h"
+#include "../common/proc/pyramid.h"
+#include "../common/proc/flow.h"
+#include "../common/proc/yuv2rgb.h"
+#include "../common/gl/caps.h"
+// clang-format on
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using ProcFactory = std::function<ogles_gpgpu::ProcInterface*()>;
+
+// benchmark arguments: resolution index, pipeline depth, transfer mode
+enum Transfer {
+    kTexture,
+    kUpload,
+    kRoundtrip
+};
+
+static const ogles_gpgpu::Size2d kResolutions[] = { { 640, 480 }, { 1280, 720 }, { 1920, 1080 }, { 3840, 2160 } };
+static const int kDepths[] = { 1, 4 };
+
+// Texture with the contents <data> of format <format>
+struct Texture {
+    Texture(const ogles_gpgpu::Size2d& size, GLenum format, GLint internalFormat, const unsigned char* data) {
+        glGenTextures(1, &texId);
+        glBindTexture(GL_TEXTURE_2D, texId);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, size.width, size.height, 0, format, GL_UNSIGNED_BYTE, data);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    ~Texture() {
+        glDeleteTextures(1, &texId);
+    }
+
+    GLuint texId = 0;
+};
+
+static std::vector<unsigned char> makeImage(const ogles_gpgpu::Size2d& size, int channels) {
+    std::vector<unsigned char> image(size.width * size.height * channels);
+    for (std::size_t i = 0; i < image.size(); i++) {
+        image[i] = static_cast<unsigned char>((i * 7) ^ (i >> 9));
+    }
+    return image;
+}
+
+// Checks the benchmark arguments, returns false (and skips the benchmark) if not supported
+static bool getArguments(benchmark::State& state, ogles_gpgpu::Size2d& size, int& depth, Transfer& transfer) {
+    size = kResolutions[state.range(0)];
+    depth = static_cast<int>(state.range(1));
+    transfer = static_cast<Transfer>(state.range(2));
+
+    if (std::max(size.width, size.height) > ogles_gpgpu::GLCaps::get().maxTextureSize) {
+        state.SkipWithError("resolution exceeds GL_MAX_TEXTURE_SIZE");
+        return false;
+    }
+    return true;
+}
+
+static void setCounters(benchmark::State& state, const ogles_gpgpu::Size2d& size) {
+    state.SetItemsProcessed(state.iterations() * size.width * size.height); // pixels
+    state.counters["width"] = size.width;
+    state.counters["height"] = size.height;
+}
+
+static void benchProc(benchmark::State& state, const ProcFactory& factory) {
+    ogles_gpgpu::Size2d size;
+    int depth;
+    Transfer transfer;
+    if (!getArguments(state, size, depth, transfer)) {
+        return;
+    }
+
+    std::vector<std::unique_ptr<ogles_gpgpu::ProcInterface>> chain;
+    for (int i = 0; i < depth; i++) {
+        chain.emplace_back(factory());
+        if (i > 0) {
+            chain[i - 1]->add(chain[i].get());
+        }
+    }
+
+    const auto image = makeImage(size, 4);
+    Texture input(size, OGLES_GPGPU_TEXTURE_FORMAT, GL_RGBA, image.data());
+    std::vector<unsigned char> output;
+
+    glActiveTexture(GL_TEXTURE0);
+    ogles_gpgpu::VideoSource video;
+    video.set(chain.front().get());
+
+    auto frame = [&]() {
+        if (transfer == kTexture) {
+            video(size, nullptr, false, input.texId, OGLES_GPGPU_TEXTURE_FORMAT);
+        } else {
+            video(size, const_cast<unsigned char*>(image.data()), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        }
+
+        if (transfer == kRoundtrip) {
+            const auto outSize = chain.back()->getOutFrameSize();
+            output.resize(outSize.width * outSize.height * 4);
+            chain.back()->getResultData(output.data());
+        }
+
+        glFinish();
+    };
+
+    frame(); // setup
+
+    for (auto _ : state) {
+        frame();
+    }
+
+    setCounters(state, size);
+}
+
+// NV12/NV21 conversion from separate luminance and chrominance textures (as on mobile
+// platforms), the pipeline depth does not apply
+static void benchYuv2Rgb(benchmark::State& state) {
+    ogles_gpgpu::Size2d size;
+    int depth;
+    Transfer transfer;
+    if (!getArguments(state, size, depth, transfer)) {
+        return;
+    }
+
+    const ogles_gpgpu::Size2d chromaSize(size.width / 2, size.height / 2);
+    const auto y = makeImage(size, 1);
+    const auto uv = makeImage(chromaSize, 2);
+
+#if defined(OGLES_GPGPU_OPENGL_ES3)
+    Texture luminance(size, GL_RED, GL_R8, y.data());
+    Texture chrominance(chromaSize, GL_RG, GL_RG8, uv.data());
+    const GLenum luminanceFormat = GL_RED, chrominanceFormat = GL_RG;
+    ogles_gpgpu::Yuv2RgbProc yuv2rgb(ogles_gpgpu::Yuv2RgbProc::k601VideoRange, ogles_gpgpu::Yuv2RgbProc::kRG);
+#else
+    Texture luminance(size, GL_LUMINANCE, GL_LUMINANCE, y.data());
+    Texture chrominance(chromaSize, GL_LUMINANCE_ALPHA, GL_LUMINANCE_ALPHA, uv.data());
+    const GLenum luminanceFormat = GL_LUMINANCE, chrominanceFormat = GL_LUMINANCE_ALPHA;
+    ogles_gpgpu::Yuv2RgbProc yuv2rgb(ogles_gpgpu::Yuv2RgbProc::k601VideoRange, ogles_gpgpu::Yuv2RgbProc::kLA);
+#endif
+
+    yuv2rgb.setExternalInputDataFormat(0); // for yuv
+    yuv2rgb.init(size.width, size.height, 0, true);
+    yuv2rgb.getMemTransferObj()->setOutputPixelFormat(OGLES_GPGPU_TEXTURE_FORMAT);
+    yuv2rgb.createFBOTex(false);
+
+    std::vector<unsigned char> output(size.width * size.height * 4);
+
+    auto frame = [&]() {
+        if (transfer != kTexture) {
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glBindTexture(GL_TEXTURE_2D, luminance.texId);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, size.width, size.height, luminanceFormat, GL_UNSIGNED_BYTE, y.data());
+            glBindTexture(GL_TEXTURE_2D, chrominance.texId);
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, chromaSize.width, chromaSize.height, chrominanceFormat, GL_UNSIGNED_BYTE, uv.data());
+            glBindTexture(GL_TEXTURE_2D, 0);
+        }
+
+        yuv2rgb.setTextures(luminance.texId, chrominance.texId);
+        yuv2rgb.render();
+
+        if (transfer == kRoundtrip) {
+            yuv2rgb.getResultData(output.data());
+        }
+
+        glFinish();
+    };
+
+    frame(); // setup
+
+    for (auto _ : state) {
+        frame();
+    }
+
+    setCounters(state, size);
+}
+
+template <typename Benchmark>
+static void addArguments(Benchmark* benchmark, bool withDepth) {
+    benchmark->ArgNames({ "res", "depth", "transfer" })->Unit(benchmark::kMillisecond)->UseRealTime();
+    for (int res = 0; res < static_cast<int>(sizeof(kResolutions) / sizeof(kResolutions[0])); res++) {
+        for (int depth : kDepths) {
+            if (!withDepth && depth != 1) {
+                continue;
+            }
+            for (int transfer : { kTexture, kUpload, kRoundtrip }) {
+                benchmark->Args({ res, depth, transfer });
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    auto context = ogles_gpgpu::createGLContext(640, 480);
+    if (!context || !(*context)) {
+        std::fprintf(stderr, "could not create an OpenGL context\n");
+        return 1;
+    }
+    (*context)();
+
+    std::fprintf(stderr, "%s, %s\n", reinterpret_cast<const char*>(glGetString(GL_RENDERER)), reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+    const std::vector<std::pair<std::string, ProcFactory>> procs = {
+        { "GainProc", [] { return new ogles_gpgpu::GainProc(2.f); } },
+        { "GrayscaleProc", [] { return new ogles_gpgpu::GrayscaleProc; } },
+        { "Rgb2LuvProc", [] { return new ogles_gpgpu::Rgb2LuvProc; } },
+        { "Rgb2HsvProc", [] { return new ogles_gpgpu::Rgb2HsvProc; } },
+        { "Hsv2RgbProc", [] { return new ogles_gpgpu::Hsv2RgbProc; } },
+        { "SwizzleProc", [] { return new ogles_gpgpu::SwizzleProc; } },
+        { "LetterboxProc", [] { return new ogles_gpgpu::LetterboxProc(0.5f); } },
+        { "GaussProc", [] { return new ogles_gpgpu::GaussProc; } },
+        { "GaussOptProc", [] { return new ogles_gpgpu::GaussOptProc(2.f); } },
+        { "BoxOptProc", [] { return new ogles_gpgpu::BoxOptProc(3.f); } },
+        { "HessianProc", [] { return new ogles_gpgpu::HessianProc; } },
+        { "LbpProc", [] { return new ogles_gpgpu::LbpProc; } },
+        { "MedianProc", [] { return new ogles_gpgpu::MedianProc; } },
+        { "GradProc", [] { return new ogles_gpgpu::GradProc; } },
+        { "ThreshProc", [] { return new ogles_gpgpu::ThreshProc; } },
+        { "AdaptThreshProc", [] { return new ogles_gpgpu::AdaptThreshProc; } },
+        { "LowPassFilterProc", [] { return new ogles_gpgpu::LowPassFilterProc; } },
+        { "HighPassFilterProc", [] { return new ogles_gpgpu::HighPassFilterProc; } },
+        { "TensorProc", [] { return new ogles_gpgpu::TensorProc; } },
+        { "ShiTomasiProc", [] { return new ogles_gpgpu::ShiTomasiProc; } },
+        { "HarrisProc", [] { return new ogles_gpgpu::HarrisProc; } },
+        { "NmsProc", [] { return new ogles_gpgpu::NmsProc; } },
+        { "PyramidProc", [] { return new ogles_gpgpu::PyramidProc(3); } },
+        { "FlowPipeline", [] { return new ogles_gpgpu::FlowPipeline; } },
+        { "Flow2Pipeline", [] { return new ogles_gpgpu::Flow2Pipeline; } },
+    };
+
+    for (const auto& proc : procs) {
+        const ProcFactory factory = proc.second;
+        auto* bench = benchmark::RegisterBenchmark(proc.first.c_str(), [factory](benchmark::State& state) { benchProc(state, factory); });
+        addArguments(bench, true);
+    }
+    addArguments(benchmark::RegisterBenchmark("Yuv2RgbProc", benchYuv2Rgb), false);
+
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+// Static shader cost report: runs one frame through every processor (and the variants of
+// the blur filters) and prints the cost of their shaders, as analyzed by ShaderCost: texture
+// fetches, dependent reads, ALU ops, varyings and precision per output pixel, and the
+// predicted cost per frame. The predicted cost is a weighted count of ALU ops, i.e. to choose
+// between GaussProc, GaussOptProc and BoxOptProc before profiling on a device; it is not a
+// time. Multi-pass processors are followed by their passes.
+//
+// Usage: bench-shader-cost [width height]
+
+#include "../app/gl_context.h" // headless EGL or aglet context of the library API
+
+// clang-format off
+#include "../common/proc/video.h"
+#include "../common/proc/gain.h"
+#include "../common/proc/grayscale.h"
+#include "../common/proc/rgb2luv.h"
+#include "../common/proc/rgb2hsv.h"
+#include "../common/proc/hsv2rgb.h"
+#include "../common/proc/swizzle.h"
+#include "../common/proc/letterbox.h"
+#include "../common/proc/gauss.h"
+#include "../common/proc/gauss_opt.h"
+#include "../common/proc/box_opt.h"
+#include "../common/proc/hessian.h"
+#include "../common/proc/lbp.h"
+#include "../common/proc/median.h"
+#include "../common/proc/grad.h"
+#include "../common/proc/thresh.h"
+#include "../common/proc/adapt_thresh.h"
+#include "../common/proc/lowpass.h"
+#include "../common/proc/highpass.h"
+#include "../common/proc/tensor.h"
+#include "../common/proc/shitomasi.h"
+#include "../common/proc/harris.h"
+#include "../common/proc/nms.h"
+#include "../common/proc/pyramid.h"
+#include "../common/proc/flow.h"
+#include "../common/graph.h"
+// clang-format on
+
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using ProcFactory = std::function<ogles_gpgpu::ProcInterface*()>;
+
+// Print node <index> of <graph> as <label> and its passes, indented by <depth>. The fetches
+// of a multi-pass processor are the sum of its passes, per output pixel of the processor.
+static void printNode(const ogles_gpgpu::PipelineGraph& graph, int index, const std::string& label, int depth) {
+    const auto& nodes = graph.getNodes();
+    const auto& node = nodes[index];
+
+    std::vector<int> passes;
+    for (int i = 0; i < int(nodes.size()); i++) {
+        if (nodes[i].parent == index) {
+            passes.push_back(i);
+        }
+    }
+
+    const std::string name = std::string(depth * 2, ' ') + label;
+    const double fetches = node.fetchesPerFrame / (double(node.width) * node.height);
+    if (passes.empty()) {
+        std::printf("%-28s %6d %8.1f %9d %7d %8d %9s %12.2f\n",
+            name.c_str(),
+            node.passes,
+            fetches,
+            node.dependentReads,
+            node.aluOps,
+            node.varyings,
+            node.precision.empty() ? "-" : node.precision.c_str(),
+            node.cost / 1e6);
+    } else {
+        std::printf("%-28s %6d %8.1f %9s %7s %8s %9s %12.2f\n", name.c_str(), node.passes, fetches, "", "", "", "", node.cost / 1e6);
+    }
+
+    for (int pass : passes) {
+        printNode(graph, pass, nodes[pass].name, depth + 1);
+    }
+}
+
+int main(int argc, char** argv) {
+    int width = 640, height = 480;
+    if (argc == 3) {
+        width = std::atoi(argv[1]);
+        height = std::atoi(argv[2]);
+    }
+
+    if (argc == 2 || argc > 3 || width <= 0 || height <= 0) {
+        std::fprintf(stderr, "usage: %s [width height]\n", argv[0]);
+        return 1;
+    }
+
+    auto context = ogles_gpgpu::createGLContext(width, height);
+    if (!context || !(*context)) {
+        std::fprintf(stderr, "could not create an OpenGL context\n");
+        return 1;
+    }
+    (*context)();
+
+    const std::vector<std::pair<std::string, ProcFactory>> procs = {
+        { "GainProc", [] { return new ogles_gpgpu::GainProc(2.f); } },
+        { "GrayscaleProc", [] { return new ogles_gpgpu::GrayscaleProc; } },
+        { "Rgb2LuvProc", [] { return new ogles_gpgpu::Rgb2LuvProc; } },
+        { "Rgb2HsvProc", [] { return new ogles_gpgpu::Rgb2HsvProc; } },
+        { "Hsv2RgbProc", [] { return new ogles_gpgpu::Hsv2RgbProc; } },
+        { "SwizzleProc", [] { return new ogles_gpgpu::SwizzleProc; } },
+        { "LetterboxProc", [] { return new ogles_gpgpu::LetterboxProc(0.5f); } },
+        { "GaussProc(5 tap)", [] { return new ogles_gpgpu::GaussProc(ogles_gpgpu::GaussProcPass::k5Tap); } },
+        { "GaussProc(7 tap)", [] { return new ogles_gpgpu::GaussProc(ogles_gpgpu::GaussProcPass::k7Tap); } },
+        { "GaussOptProc(1)", [] { return new ogles_gpgpu::GaussOptProc(1.f); } },
+        { "GaussOptProc(2)", [] { return new ogles_gpgpu::GaussOptProc(2.f); } },
+        { "GaussOptProc(4)", [] { return new ogles_gpgpu::GaussOptProc(4.f); } },
+        { "GaussOptProc(8)", [] { return new ogles_gpgpu::GaussOptProc(8.f); } },
+        { "BoxOptProc(1)", [] { return new ogles_gpgpu::BoxOptProc(1.f); } },
+        { "BoxOptProc(2)", [] { return new ogles_gpgpu::BoxOptProc(2.f); } },
+        { "BoxOptProc(4)", [] { return new ogles_gpgpu::BoxOptProc(4.f); } },
+        { "BoxOptProc(8)", [] { return new ogles_gpgpu::BoxOptProc(8.f); } },
+        { "HessianProc", [] { return new ogles_gpgpu::HessianProc; } },
+        { "LbpProc", [] { return new ogles_gpgpu::LbpProc; } },
+        { "MedianProc", [] { return new ogles_gpgpu::MedianProc; } },
+        { "GradProc", [] { return new ogles_gpgpu::GradProc; } },
+        { "ThreshProc", [] { return new ogles_gpgpu::ThreshProc; } },
+        { "AdaptThreshProc", [] { return new ogles_gpgpu::AdaptThreshProc; } },
+        { "LowPassFilterProc", [] { return new ogles_gpgpu::LowPassFilterProc; } },
+        { "HighPassFilterProc", [] { return new ogles_gpgpu::HighPassFilterProc; } },
+        { "TensorProc", [] { return new ogles_gpgpu::TensorProc; } },
+        { "ShiTomasiProc", [] { return new ogles_gpgpu::ShiTomasiProc; } },
+        { "HarrisProc", [] { return new ogles_gpgpu::HarrisProc; } },
+        { "NmsProc", [] { return new ogles_gpgpu::NmsProc; } },
+        { "PyramidProc", [] { return new ogles_gpgpu::PyramidProc(3); } },
+        { "FlowPipeline", [] { return new ogles_gpgpu::FlowPipeline; } },
+        { "Flow2Pipeline", [] { return new ogles_gpgpu::Flow2Pipeline; } },
+    };
+
+    std::vector<unsigned char> image(width * height * 4);
+    for (std::size_t i = 0; i < image.size(); i++) {
+        image[i] = static_cast<unsigned char>((i * 7) ^ (i >> 9));
+    }
+
+    const ogles_gpgpu::Size2d size(width, height);
+
+    std::printf("%dx%d, cost in M ALU ops per frame (a texture fetch is %d, a dependent read %d more)\n",
+        width,
+        height,
+        ogles_gpgpu::ShaderCost::kFetchWeight,
+        ogles_gpgpu::ShaderCost::kDependentReadWeight);
+    std::printf("%-28s %6s %8s %9s %7s %8s %9s %12s\n", "processor", "passes", "fetches", "dependent", "alu", "varyings", "precision", "cost[M]");
+    for (const auto& proc : procs) {
+        // the passes are prepared on the first frame
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        std::unique_ptr<ogles_gpgpu::ProcInterface> pipeline(proc.second());
+        video.set(pipeline.get());
+        video(size, image.data(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        printNode(pipeline->getGraph(), 0, proc.first, 0);
+    }
+
+    return 0;
+}
@@ -0,0 +1,182 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+// Startup latency benchmark: measures the time to the first frame and the time to steady
+// state for a set of pipelines, with a cold start and after VideoSource::warmup().
+//
+// Usage: bench-startup [width height frames]
+
+#include "../app/gl_context.h" // headless EGL or aglet context of the library API
+
+// clang-format off
+#include "../common/proc/video.h"
+#include "../common/proc/gain.h"
+#include "../common/proc/gauss_opt.h"
+#include "../common/proc/pyramid.h"
+#include "../common/proc/tensor.h"
+#include "../common/proc/shitomasi.h"
+#include "../common/proc/nms.h"
+#include "../common/proc/fifo.h"
+#include "../common/proc/iir.h"
+#include "../common/proc/flow.h"
+// clang-format on
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// A frame is in steady state if it is at most this much slower than the median:
+static const double kSteadyStateTolerance = 1.25;
+
+using Clock = std::chrono::steady_clock;
+
+static double elapsedMs(const Clock::time_point& start, const Clock::time_point& stop) {
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+// Processors of one pipeline, connected in the order of chain() calls
+struct Pipeline {
+    template <typename T>
+    T* chain(T* proc) {
+        if (!procs.empty()) {
+            procs.back()->add(proc);
+        }
+        procs.emplace_back(proc);
+        return proc;
+    }
+
+    ogles_gpgpu::ProcInterface* getInput() const {
+        return procs.front().get();
+    }
+
+    std::vector<std::unique_ptr<ogles_gpgpu::ProcInterface>> procs;
+};
+
+using PipelineFactory = std::function<void(Pipeline& pipeline)>;
+
+struct Result {
+    double warmupMs = 0.0; // time spent in warmup()
+    double firstFrameMs = 0.0; // duration of the first frame
+    double steadyFrameMs = 0.0; // median frame time
+    double toSteadyMs = 0.0; // time from setup to the end of the first steady state frame
+    int toSteadyFrames = 0;
+};
+
+static Result run(const PipelineFactory& factory, const std::vector<unsigned char>& image, const ogles_gpgpu::Size2d& size, int frames, bool warmup) {
+    Result result;
+
+    const auto start = Clock::now();
+
+    glActiveTexture(GL_TEXTURE0);
+    ogles_gpgpu::VideoSource video;
+
+    Pipeline pipeline;
+    factory(pipeline);
+    video.set(pipeline.getInput());
+
+    if (warmup) {
+        video.warmup(size);
+        result.warmupMs = elapsedMs(start, Clock::now());
+    }
+
+    // frame times and completion times (relative to start)
+    std::vector<double> frameMs, doneMs;
+    for (int i = 0; i < frames; i++) {
+        const auto begin = Clock::now();
+        video(size, const_cast<unsigned char*>(image.data()), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        glFinish();
+        const auto end = Clock::now();
+
+        frameMs.push_back(elapsedMs(begin, end));
+        doneMs.push_back(elapsedMs(start, end));
+    }
+
+    std::vector<double> sorted(frameMs.begin() + frames / 2, frameMs.end());
+    std::nth_element(sorted.begin(), sorted.begin() + sorted.size() / 2, sorted.end());
+    result.steadyFrameMs = sorted[sorted.size() / 2];
+
+    result.firstFrameMs = frameMs.front();
+
+    // the first frame after which all frames are in steady state
+    int steady = frames - 1;
+    while (steady > 0 && frameMs[steady - 1] <= result.steadyFrameMs * kSteadyStateTolerance) {
+        steady--;
+    }
+    result.toSteadyMs = doneMs[steady];
+    result.toSteadyFrames = steady + 1;
+
+    return result;
+}
+
+int main(int argc, char** argv) {
+    int width = 640, height = 480, frames = 100;
+    if (argc == 4) {
+        width = std::atoi(argv[1]);
+        height = std::atoi(argv[2]);
+        frames = std::atoi(argv[3]);
+    }
+
+    if (width <= 0 || height <= 0 || frames < 2) {
+        std::fprintf(stderr, "usage: %s [width height frames]\n", argv[0]);
+        return 1;
+    }
+
+    auto context = ogles_gpgpu::createGLContext(width, height);
+    if (!context || !(*context)) {
+        std::fprintf(stderr, "could not create an OpenGL context\n");
+        return 1;
+    }
+    (*context)();
+
+    const std::vector<std::pair<std::string, PipelineFactory>> pipelines = {
+        { "gain", [](Pipeline& p) { p.chain(new ogles_gpgpu::GainProc(1.f)); } },
+        { "gauss", [](Pipeline& p) { p.chain(new ogles_gpgpu::GaussOptProc(2.f)); } },
+        { "pyramid", [](Pipeline& p) { p.chain(new ogles_gpgpu::PyramidProc(4)); } },
+        { "corners", [](Pipeline& p) {
+             p.chain(new ogles_gpgpu::GaussOptProc(2.f));
+             p.chain(new ogles_gpgpu::TensorProc);
+             p.chain(new ogles_gpgpu::ShiTomasiProc);
+             p.chain(new ogles_gpgpu::NmsProc);
+         } },
+        { "fifo", [](Pipeline& p) { p.chain(new ogles_gpgpu::FifoProc(3)); } },
+        { "iir", [](Pipeline& p) { p.chain(new ogles_gpgpu::IirFilterProc(ogles_gpgpu::IirFilterProc::kLowPass)); } },
+        { "flow", [](Pipeline& p) { p.chain(new ogles_gpgpu::Flow2Pipeline); } },
+    };
+
+    // textured test image, so that data dependent driver paths are exercised, too
+    std::vector<unsigned char> image(width * height * 4);
+    for (int i = 0; i < width * height; i++) {
+        image[i * 4 + 0] = static_cast<unsigned char>(i * 7);
+        image[i * 4 + 1] = static_cast<unsigned char>(i * 13);
+        image[i * 4 + 2] = static_cast<unsigned char>(i * 29);
+        image[i * 4 + 3] = 255;
+    }
+
+    const ogles_gpgpu::Size2d size(width, height);
+
+    std::printf("%dx%d, %d frames\n", width, height, frames);
+    std::printf("%-10s %-5s %10s %12s %12s %16s\n", "pipeline", "mode", "warmup[ms]", "first[ms]", "steady[ms]", "to steady[ms]");
+    for (const auto& pipeline : pipelines) {
+        for (bool warmup : { false, true }) {
+            const Result result = run(pipeline.second, image, size, frames, warmup);
+            std::printf("%-10s %-5s %10.2f %12.2f %12.2f %10.2f (%3d)\n",
+                pipeline.first.c_str(),
+                warmup ? "warm" : "cold",
+                result.warmupMs,
+                result.firstFrameMs,
+                result.steadyFrameMs,
+                result.toSteadyMs,
+                result.toSteadyFrames);
+        }
+    }
+
+    return 0;
+}
@@ -9,9 +9,11 @@
 
 #include "core.h"
 
+#include "gl/shader_cache.h"
 #include "proc/disp.h"
 
 #include <algorithm>
+#include <set>
 #include <string>
 
 using namespace std;
@@ -91,6 +93,12 @@ void Core::addProcToPipeline(ProcInterface* proc) {
     pipeline.push_back(proc);
 }
 
+void Core::setGPUTiming(bool flag) {
+    for (auto& it : pipeline) {
+        it->setGPUTiming(flag);
+    }
+}
+
 Disp* Core::createRenderDisplay(int dispW, int dispH, RenderOrientation orientation) {
     assert(!renderDisp);
 
@@ -138,6 +146,18 @@ void Core::prepare(int inW, int inH, GLenum inFmt) {
     OG_LOGINF("Core", "prepare with input frame size %dx%d (POT: %d), %u processors in pipeline",
         inputFrameW, inputFrameH, inputSizeIsPOT, (unsigned int)pipeline.size());
 
+    // measure the peak memory while old and new buffers coexist
+    GPUMemory::resetPeak();
+
+    if (!prepared) {
+        // submit all programs before the first status query (in init())
+        pipeline.front()->setExternalInputDataFormat(inFmt);
+        std::set<ProcInterface*> visited;
+        for (auto& it : pipeline) {
+            it->prefetchShaders(visited);
+        }
+    }
+
     // initialize the pipeline
     ProcInterface* prevProc = nullptr;
     unsigned int num = 0;
@@ -237,11 +257,50 @@ void Core::prepare(int inW, int inH, GLenum inFmt) {
         it->printInfo();
     }
 
+    ShaderCache::releasePrefetched();
+
     glFinish();
+    OG_GL_COUNT(finishes);
+
+    prepareMemoryPeak = GPUMemory::getPeak();
+    OG_LOGINF("Core", "GPU memory: %s (peak %zu bytes during prepare)", getTotal(getMemoryReport()).toString().c_str(), prepareMemoryPeak);
 
     prepared = true;
 }
 
+MemoryReport Core::getMemoryReport() {
+    MemoryReport report;
+    std::set<ProcInterface*> visited;
+    for (auto& it : pipeline) {
+        it->getMemoryReport(report, visited);
+    }
+
+    if (renderDisp) {
+        renderDisp->getMemoryReport(report, visited);
+    }
+
+    return report;
+}
+
+PipelineGraph Core::getGraph() {
+    PipelineGraph graph;
+    std::map<ProcInterface*, int> nodes;
+    int previous = -1;
+    for (auto& it : pipeline) {
+        const int index = it->addToGraph(graph, nodes, -1);
+        if (previous >= 0) {
+            graph.addEdge(previous, index, PipelineGraph::kPass);
+        }
+        previous = index;
+    }
+
+    if (renderDisp && previous >= 0) {
+        graph.addEdge(previous, renderDisp->addToGraph(graph, nodes, -1), PipelineGraph::kPass);
+    }
+
+    return graph;
+}
+
 #pragma mark input, processing and output methods
 
 MemTransfer* Core::getInputMemTransfer() const {
@@ -262,11 +321,15 @@ void Core::setInputTexId(GLuint inTexId, GLenum inTexTarget) {
 void Core::setInputData(const unsigned char* data) {
     assert(initialized && inputTexId > 0);
 
-#ifdef OGLES_GPGPU_BENCHMARK
-    Tools::resetTimeMeasurement();
+    if (!frameStarted) {
+        stageTimings.nextFrame();
+        frameGLCalls = {};
+        frameStarted = true;
+    }
 
-    Tools::startTimeMeasurement();
-#endif
+    StageTimings::Binding binding(stageTimings);
+    StageTimings::Scope scope("upload");
+    GLCounters::Scope calls(frameGLCalls);
 
     // check set up and input data
     if (useMipmaps && !inputSizeIsPOT && !glExtNPOTMipmaps) {
@@ -297,94 +360,95 @@ void Core::setInputData(const unsigned char* data) {
     Tools::checkGLErr("Core", "set texture parameters for input data");
 
     glFinish();
-
-#ifdef OGLES_GPGPU_BENCHMARK
-    Tools::stopTimeMeasurement();
-#endif
+    OG_GL_COUNT(finishes);
 }
 
 void Core::process() {
     assert(initialized);
 
-#ifdef OGLES_GPGPU_BENCHMARK
-    Tools::startTimeMeasurement();
-#endif
+    Tools::resetGLErrCheckCount();
+
+    // the frame is started by setInputData() or here (for texture input)
+    if (!frameStarted) {
+        stageTimings.nextFrame();
+        frameGLCalls = {};
+    }
+    frameStarted = false;
+
+    StageTimings::Binding binding(stageTimings);
+    StageTimings::Scope scope("process");
+    GLCounters::Scope calls(frameGLCalls);
 
     // set input texture id
     firstProc->useTexture(inputTexId, 1, inputTexTarget);
 
     // run the processors in the pipeline
     for (auto& it : pipeline) {
-        it->render();
+        it->renderTimed();
         glFinish();
+        OG_GL_COUNT(finishes);
     }
+}
 
-#ifdef OGLES_GPGPU_BENCHMARK
-    Tools::stopTimeMeasurement();
-#endif
+void Core::warmup() {
+    assert(initialized && prepared);
+
+    process();
+
+    for (auto& it : pipeline) {
+        it->reset();
+    }
 }
 
 void Core::getInputData(unsigned char* buf) {
     assert(initialized);
 
-#ifdef OGLES_GPGPU_BENCHMARK
-    Tools::startTimeMeasurement();
-#endif
+    StageTimings::Binding binding(stageTimings);
+    StageTimings::Scope scope("input readback");
+    GLCounters::Scope calls(frameGLCalls);
 
     // will copy the result data from the GPU's memory space to <buf>
     firstProc->getMemTransferObj()->fromGPU(buf);
-
-#ifdef OGLES_GPGPU_BENCHMARK
-    Tools::stopTimeMeasurement();
-#endif
 }
 
 void Core::getOutputData(unsigned char* buf) {
     assert(initialized);
 
+    GLCounters::Scope calls(frameGLCalls);
+
     glFinish();
+    OG_GL_COUNT(finishes);
 
-#ifdef OGLES_GPGPU_BENCHMARK
-    Tools::startTimeMeasurement();
-#endif
+    StageTimings::Binding binding(stageTimings);
+    StageTimings::Scope scope("readback");
 
     // will copy the result data from the GPU's memory space to <buf>
     lastProc->getResultData(buf);
+}
 
 #ifdef OGLES_GPGPU_BENCHMARK
-    Tools::stopTimeMeasurement();
-#endif
+vector<double> Core::getTimeMeasurements() const {
+    vector<double> ms(3, 0.0);
+    for (const auto& stage : stageTimings.snapshot()) {
+        if (stage.name == "upload") {
+            ms[0] = stage.histogram.getLast();
+        } else if (stage.name == "process") {
+            ms[1] = stage.histogram.getLast();
+        } else if (stage.name == "readback") {
+            ms[2] = stage.histogram.getLast();
+        }
+    }
+    return ms;
 }
+#endif
 
 #pragma mark helper methods
 
 void Core::checkGLExtensions() {
+    const GLCaps& caps = GLCaps::query();
 
-    // get string with extensions seperated by a SPACE
-    std::string glExtString;
-    const auto * extensions = reinterpret_cast<const char *>(glGetString(GL_EXTENSIONS));
-    if(extensions != nullptr) {
-        glExtString = extensions;
-    }
-
-    // get extensions as vector
-    vector<string> glExt = Tools::split(glExtString);
-
-    // check extensions
-    //    OG_LOGINF("Core", "list of extensions:");
-    for (auto& it : glExt) {
-        // get lowercase extension string
-        string extName = it;
-        transform(extName.begin(), extName.end(), extName.begin(), ::tolower);
-
-        //        OG_LOGINF("Core", "> %s", extName.c_str());
-
-        // check for NPOT mipmapping support
-        if (it.compare("gl_arb_texture_non_power_of_two") == 0
-            || it.compare("gl_oes_texture_npot") == 0) {
-            glExtNPOTMipmaps = true;
-        }
-    }
+    // check for NPOT mipmapping support
+    glExtNPOTMipmaps = caps.npotMipmaps;
 
     OG_LOGINF("Core", "NPOT mipmaps support: %d", glExtNPOTMipmaps);
 }
@@ -15,8 +15,10 @@
 #define OGLES_GPGPU_COMMON_CORE
 
 #include "common_includes.h"
+#include "gl/caps.h"
 #include "gl/memtransfer.h"
 #include "proc/base/procinterface.h"
+#include "stats.h"
 
 #include <list>
 #include <vector>
@@ -124,6 +126,11 @@ public:
         return useMipmaps;
     }
 
+    /**
+     * Measure the GPU time of each processor in the pipeline (see ProcInterface::setGPUTiming()).
+     */
+    void setGPUTiming(bool flag);
+
     /**
      * Set input as OpenGL texture id.
      */
@@ -148,6 +155,13 @@ public:
         return lastProc->getOutputTexId();
     }
 
+    /**
+     * Process the current input once and reset the temporal state of all processors,
+     * so that the lazy driver work is done before the first real frame.
+     * Note that prepare() must have been called before.
+     */
+    void warmup();
+
     /**
      * Get input as bytes. Will copy the input texture from the GPU to <buf>.
      */
@@ -172,6 +186,13 @@ public:
         return outputFrameH;
     }
 
+    /**
+     * Get the capabilities of the current OpenGL context (i.e. for logging).
+     */
+    const GLCaps& getCaps() const {
+        return GLCaps::get();
+    }
+
     /**
      * Get pointer to OpenGL context (platform specific type).
      */
@@ -179,10 +200,49 @@ public:
         return glContextPtr;
     }
 
-#ifdef OGLES_GPGPU_BENCHMARK
-    vector<double> getTimeMeasurements() const {
-        return Tools::getTimeMeasurements();
+    /**
+     * Get the wall clock times of the stages "upload", "process" (with a stage for each
+     * processor), "readback" and "input readback", i.e. for snapshot(), reset() and
+     * setTracer().
+     */
+    StageTimings& getStageTimings() {
+        return stageTimings;
+    }
+
+    /**
+     * Get the OpenGL calls of the current (or last) frame, from setInputData() up to
+     * getOutputData(), if counting is enabled (see GLCounters).
+     */
+    const GLCallCounts& getGLCallCounts() const {
+        return frameGLCalls;
     }
+
+    /**
+     * Get the GPU memory held by each processor of the pipeline and by the render display
+     * (see ProcInterface::getMemoryReport()). getTotal() sums up the report.
+     */
+    MemoryReport getMemoryReport();
+
+    /**
+     * Get the graph of the pipeline and the render display (see ProcInterface::getGraph()),
+     * where the processors are connected in pipeline order.
+     */
+    PipelineGraph getGraph();
+
+    /**
+     * Get the peak of the GPU memory allocated by ogles_gpgpu during the last prepare() in
+     * bytes (see GPUMemory), which covers the time when the buffers for the old and for
+     * the new frame size coexist.
+     */
+    std::size_t getPrepareMemoryPeak() const {
+        return prepareMemoryPeak;
+    }
+
+#ifdef OGLES_GPGPU_BENCHMARK
+    /**
+     * Get the last time measurements in ms of the stages upload, process and readback.
+     */
+    vector<double> getTimeMeasurements() const;
 #endif
 
     /**
@@ -252,6 +312,12 @@ private:
     int outputFrameW; // output frame width
     int outputFrameH; // output frame width
 
+    StageTimings stageTimings;
+    bool frameStarted = false; // setInputData() started the next frame of stageTimings
+    GLCallCounts frameGLCalls; // OpenGL calls of the current frame
+
+    std::size_t prepareMemoryPeak = 0; // see getPrepareMemoryPeak()
+
     GLuint inputTexId; // input texture id
     GLenum inputTexTarget; // input texture target
     GLuint outputTexId; // output texture id
@@ -0,0 +1,77 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+#include "call_counters.h"
+
+#include <sstream>
+
+using namespace std;
+using namespace ogles_gpgpu;
+
+std::atomic<bool> GLCounters::enabled(false);
+
+// ########## GLCallCounts
+
+GLCallCounts& GLCallCounts::operator+=(const GLCallCounts& other) {
+    drawCalls += other.drawCalls;
+    programBinds += other.programBinds;
+    textureBinds += other.textureBinds;
+    framebufferBinds += other.framebufferBinds;
+    uniformUploads += other.uniformUploads;
+    errorChecks += other.errorChecks;
+    bufferMaps += other.bufferMaps;
+    finishes += other.finishes;
+    return *this;
+}
+
+GLCallCounts& GLCallCounts::operator-=(const GLCallCounts& other) {
+    drawCalls -= other.drawCalls;
+    programBinds -= other.programBinds;
+    textureBinds -= other.textureBinds;
+    framebufferBinds -= other.framebufferBinds;
+    uniformUploads -= other.uniformUploads;
+    errorChecks -= other.errorChecks;
+    bufferMaps -= other.bufferMaps;
+    finishes -= other.finishes;
+    return *this;
+}
+
+bool GLCallCounts::operator==(const GLCallCounts& other) const {
+    return drawCalls == other.drawCalls
+        && programBinds == other.programBinds
+        && textureBinds == other.textureBinds
+        && framebufferBinds == other.framebufferBinds
+        && uniformUploads == other.uniformUploads
+        && errorChecks == other.errorChecks
+        && bufferMaps == other.bufferMaps
+        && finishes == other.finishes;
+}
+
+std::string GLCallCounts::toString() const {
+    std::stringstream ss;
+    ss << "draws=" << drawCalls << " programs=" << programBinds << " textures=" << textureBinds;
+    ss << " fbos=" << framebufferBinds << " uniforms=" << uniformUploads << " errors=" << errorChecks;
+    ss << " maps=" << bufferMaps << " finishes=" << finishes;
+    return ss.str();
+}
+
+// ########## GLCounters
+
+GLCounters::Scope::Scope(GLCallCounts& counts)
+    : counts(counts)
+    , begin(getThreadCounts()) {
+}
+
+GLCounters::Scope::~Scope() {
+    GLCallCounts calls = getThreadCounts();
+    calls -= begin;
+    counts += calls;
+}
+
+GLCallCounts& GLCounters::getThreadCounts() {
+    static thread_local GLCallCounts counts;
+    return counts;
+}
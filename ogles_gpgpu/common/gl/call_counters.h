@@ -0,0 +1,102 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+/**
+ * OpenGL call and state change counters.
+ */
+#ifndef OGLES_GPGPU_COMMON_GL_CALL_COUNTERS
+#define OGLES_GPGPU_COMMON_GL_CALL_COUNTERS
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+namespace ogles_gpgpu {
+
+/**
+ * Number of OpenGL calls of each kind that matter for the driver overhead and for
+ * pipeline stalls (see GLCounters).
+ */
+struct GLCallCounts {
+    std::size_t drawCalls = 0; // glDrawArrays(), glDispatchCompute()
+    std::size_t programBinds = 0; // glUseProgram()
+    std::size_t textureBinds = 0; // glBindTexture(), glBindImageTexture()
+    std::size_t framebufferBinds = 0; // glBindFramebuffer()
+    std::size_t uniformUploads = 0; // glUniform*()
+    std::size_t errorChecks = 0; // glGetError()
+    std::size_t bufferMaps = 0; // glMapBuffer(), glMapBufferRange()
+    std::size_t finishes = 0; // glFinish()
+
+    GLCallCounts& operator+=(const GLCallCounts& other);
+    GLCallCounts& operator-=(const GLCallCounts& other);
+
+    bool operator==(const GLCallCounts& other) const;
+    bool operator!=(const GLCallCounts& other) const {
+        return !(*this == other);
+    }
+
+    /**
+     * Format as "draws=2 programs=2 textures=4 fbos=4 uniforms=3 errors=0 maps=0 finishes=1".
+     */
+    std::string toString() const;
+};
+
+/**
+ * Opt-in instrumentation of the OpenGL calls of ogles_gpgpu. Every call site increments
+ * a running count of the calling thread with OG_GL_COUNT() while counting is enabled,
+ * and a Scope adds the calls of a block of code to a GLCallCounts, i.e. per processor
+ * (see ProcInterface::getGLCallCounts()) or per frame (see Core::getGLCallCounts()).
+ */
+class GLCounters {
+public:
+    /**
+     * Scope that adds the calls of the current thread during its lifetime to <counts>.
+     * Scopes can be nested, the calls are counted for each of them.
+     */
+    class Scope {
+    public:
+        Scope(GLCallCounts& counts);
+        ~Scope();
+
+    private:
+        GLCallCounts& counts;
+        GLCallCounts begin;
+    };
+
+    /**
+     * Enable or disable counting for all threads (default: disabled).
+     */
+    static void setEnabled(bool flag) {
+        enabled = flag;
+    }
+
+    /**
+     * Check if counting is enabled.
+     */
+    static bool isEnabled() {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the running counts of the current thread.
+     */
+    static GLCallCounts& getThreadCounts();
+
+private:
+    static std::atomic<bool> enabled;
+};
+}
+
+// clang-format off
+#define OG_GL_COUNT(counter)                                          \
+    do {                                                              \
+        if (ogles_gpgpu::GLCounters::isEnabled()) {                   \
+            ogles_gpgpu::GLCounters::getThreadCounts().counter++;     \
+        }                                                             \
+    } while (0)
+// clang-format on
+
+#endif
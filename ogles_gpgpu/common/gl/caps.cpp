@@ -0,0 +1,166 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+#include "caps.h"
+#include "timer_query.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <sstream>
+
+using namespace std;
+using namespace ogles_gpgpu;
+
+GLCaps GLCaps::instance;
+bool GLCaps::queried = false;
+
+static string toLower(string str) {
+    transform(str.begin(), str.end(), str.begin(), ::tolower);
+    return str;
+}
+
+const GLCaps& GLCaps::get() {
+    if (!queried) {
+        query();
+    }
+    return instance;
+}
+
+const GLCaps& GLCaps::query() {
+    instance = GLCaps();
+    instance.queryCaps();
+    queried = true;
+
+    OG_LOGINF("GLCaps", "%s", instance.toString().c_str());
+
+    return instance;
+}
+
+bool GLCaps::hasExtension(const std::string& name) const {
+    return extensions.count(toLower(name)) > 0;
+}
+
+bool GLCaps::isVersion(int major, int minor) const {
+    return (versionMajor > major) || ((versionMajor == major) && (versionMinor >= minor));
+}
+
+void GLCaps::queryCaps() {
+    // version string is "OpenGL ES <major>.<minor> ..." or "<major>.<minor> ..."
+    const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    if (version) {
+        string versionStr(version);
+        isES = (versionStr.find("OpenGL ES") != string::npos);
+        size_t pos = versionStr.find_first_of("0123456789");
+        if (pos != string::npos) {
+            sscanf(versionStr.c_str() + pos, "%d.%d", &versionMajor, &versionMinor);
+        }
+    }
+
+    // extensions (the single extension string is not available in desktop core profiles)
+#if defined(GL_NUM_EXTENSIONS) && !defined(OGLES_GPGPU_OPENGL_ES2)
+    if (isVersion(3, 0)) {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; i++) {
+            const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if (name) {
+                extensions.insert(toLower(name));
+            }
+        }
+    } else
+#endif
+    {
+        const char* extString = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+        if (extString) {
+            for (const auto& name : Tools::split(extString)) {
+                if (!name.empty()) {
+                    extensions.insert(toLower(name));
+                }
+            }
+        }
+    }
+
+    // implementation limits
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxTextureUnits);
+    glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &maxCombinedTextureUnits);
+
+#if defined(OGLES_GPGPU_OPENGLES)
+    glGetIntegerv(GL_MAX_VARYING_VECTORS, &maxVaryingVectors);
+#elif defined(GL_MAX_VARYING_COMPONENTS)
+    glGetIntegerv(GL_MAX_VARYING_COMPONENTS, &maxVaryingVectors);
+    maxVaryingVectors /= 4;
+#else
+    glGetIntegerv(GL_MAX_VARYING_FLOATS, &maxVaryingVectors);
+    maxVaryingVectors /= 4;
+#endif
+
+#if defined(GL_MAX_DRAW_BUFFERS)
+    if (!isES || isVersion(3, 0)) {
+        glGetIntegerv(GL_MAX_DRAW_BUFFERS, &maxDrawBuffers);
+    }
+#endif
+
+    // features
+    if (isES) {
+        npotMipmaps = isVersion(3, 0) || hasExtension("GL_OES_texture_npot");
+        rgTextures = isVersion(3, 0) || hasExtension("GL_EXT_texture_rg");
+        floatRenderTargets = hasExtension("GL_EXT_color_buffer_float");
+        halfFloatRenderTargets = floatRenderTargets || hasExtension("GL_EXT_color_buffer_half_float");
+        pixelBufferObjects = isVersion(3, 0) || hasExtension("GL_NV_pixel_buffer_object");
+        timerQueries = hasExtension("GL_EXT_disjoint_timer_query") && GPUTimer::loadFunctions();
+        bufferStorage = hasExtension("GL_EXT_buffer_storage");
+        computeShaders = isVersion(3, 1);
+        glsl3Shaders = isVersion(3, 0);
+        debugOutput = isVersion(3, 2) || hasExtension("GL_KHR_debug");
+    } else {
+        npotMipmaps = isVersion(2, 0) || hasExtension("GL_ARB_texture_non_power_of_two");
+        rgTextures = isVersion(3, 0) || hasExtension("GL_ARB_texture_rg");
+        floatRenderTargets = isVersion(3, 0) || hasExtension("GL_ARB_color_buffer_float");
+        halfFloatRenderTargets = floatRenderTargets || hasExtension("GL_ARB_half_float_pixel");
+        pixelBufferObjects = isVersion(2, 1) || hasExtension("GL_ARB_pixel_buffer_object");
+        timerQueries = isVersion(3, 3) || hasExtension("GL_ARB_timer_query") || hasExtension("GL_EXT_timer_query");
+        bufferStorage = isVersion(4, 4) || hasExtension("GL_ARB_buffer_storage");
+        computeShaders = isVersion(4, 3) || hasExtension("GL_ARB_compute_shader");
+        glsl3Shaders = isVersion(3, 3);
+        debugOutput = isVersion(4, 3) || hasExtension("GL_KHR_debug");
+    }
+    parallelShaderCompile = hasExtension("GL_KHR_parallel_shader_compile") || hasExtension("GL_ARB_parallel_shader_compile");
+
+#if defined(GL_NUM_PROGRAM_BINARY_FORMATS)
+    if (isES ? isVersion(3, 0) : (isVersion(4, 1) || hasExtension("GL_ARB_get_program_binary"))) {
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        programBinaries = (formats > 0);
+    }
+#endif
+
+    Tools::checkGLErr("GLCaps", "query capabilities");
+}
+
+std::string GLCaps::toString() const {
+    std::stringstream ss;
+    ss << (isES ? "OpenGL ES " : "OpenGL ") << versionMajor << "." << versionMinor
+       << " (" << extensions.size() << " extensions)\n";
+    ss << "  npot mipmaps: " << npotMipmaps << "\n";
+    ss << "  rg textures: " << rgTextures << "\n";
+    ss << "  float render targets: " << floatRenderTargets << "\n";
+    ss << "  half float render targets: " << halfFloatRenderTargets << "\n";
+    ss << "  pixel buffer objects: " << pixelBufferObjects << "\n";
+    ss << "  timer queries: " << timerQueries << "\n";
+    ss << "  buffer storage: " << bufferStorage << "\n";
+    ss << "  parallel shader compile: " << parallelShaderCompile << "\n";
+    ss << "  compute shaders: " << computeShaders << "\n";
+    ss << "  glsl 3 shaders: " << glsl3Shaders << "\n";
+    ss << "  debug output: " << debugOutput << "\n";
+    ss << "  program binaries: " << programBinaries << "\n";
+    ss << "  max texture size: " << maxTextureSize << "\n";
+    ss << "  max texture units: " << maxTextureUnits << " (combined " << maxCombinedTextureUnits << ")\n";
+    ss << "  max varying vectors: " << maxVaryingVectors << "\n";
+    ss << "  max draw buffers: " << maxDrawBuffers;
+    return ss.str();
+}
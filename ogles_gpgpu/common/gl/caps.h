@@ -0,0 +1,86 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+/**
+ * OpenGL capability registry.
+ */
+#ifndef OGLES_GPGPU_COMMON_GL_CAPS
+#define OGLES_GPGPU_COMMON_GL_CAPS
+
+#include "../common_includes.h"
+
+#include <set>
+#include <string>
+
+namespace ogles_gpgpu {
+
+/**
+ * Capabilities of the current OpenGL context, derived from the context version,
+ * the extension list and implementation limits. The registry is queried on first
+ * use by get() and again on query() (Core::init() does this), so it must only be
+ * accessed with a current OpenGL context.
+ *
+ * Processors and memory transfer objects consult it to select the fastest path
+ * that is supported at runtime.
+ */
+class GLCaps {
+public:
+    /**
+     * Get the capabilities of the current context (queried on first call).
+     */
+    static const GLCaps& get();
+
+    /**
+     * (Re-)query the capabilities of the current context.
+     */
+    static const GLCaps& query();
+
+    /**
+     * Check for extension <name> (i.e. "GL_OES_texture_npot"), case insensitive.
+     */
+    bool hasExtension(const std::string& name) const;
+
+    /**
+     * Return a human readable summary (i.e. for logging).
+     */
+    std::string toString() const;
+
+    bool isES = false; // OpenGL ES context?
+    int versionMajor = 0; // context version
+    int versionMinor = 0;
+
+    bool npotMipmaps = false; // mipmaps for NPOT textures
+    bool rgTextures = false; // GL_RED / GL_RG textures
+    bool floatRenderTargets = false; // 32 bit float color attachments
+    bool halfFloatRenderTargets = false; // 16 bit float color attachments
+    bool pixelBufferObjects = false; // GL_PIXEL_{PACK,UNPACK}_BUFFER
+    bool timerQueries = false; // GL_TIME_ELAPSED queries
+    bool bufferStorage = false; // immutable (persistently mappable) buffer storage
+    bool parallelShaderCompile = false; // {KHR,ARB}_parallel_shader_compile
+    bool computeShaders = false; // compute shaders
+    bool glsl3Shaders = false; // GLSL ES 3.00 / GLSL 3.30 shaders (see OG_GLSL3_VERSION)
+    bool debugOutput = false; // KHR_debug message callbacks
+    bool programBinaries = false; // glGetProgramBinary() / glProgramBinary() with at least one binary format
+
+    int maxTextureSize = 0; // GL_MAX_TEXTURE_SIZE
+    int maxTextureUnits = 0; // GL_MAX_TEXTURE_IMAGE_UNITS (fragment shader)
+    int maxCombinedTextureUnits = 0; // GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS
+    int maxVaryingVectors = 0; // GL_MAX_VARYING_VECTORS
+    int maxDrawBuffers = 1; // GL_MAX_DRAW_BUFFERS (multiple render targets)
+
+    std::set<std::string> extensions; // lowercase extension names
+
+private:
+    void queryCaps();
+
+    bool isVersion(int major, int minor) const;
+
+    static GLCaps instance;
+    static bool queried;
+};
+}
+
+#endif
@@ -8,6 +8,8 @@
 //
 
 #include "fbo.h"
+#include "call_counters.h"
+#include "caps.h"
 #include "ogles_gpgpu/platform/opengl/gl_includes.h"
 
 using namespace std;
@@ -39,11 +41,13 @@ FBO::~FBO() {
 
 void FBO::bind() {
     glBindFramebuffer(GL_FRAMEBUFFER, id);
+    OG_GL_COUNT(framebufferBinds);
     Tools::checkGLErr("FBO", "glBindFrameBuffer");
 }
 
 void FBO::unbind() {
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    OG_GL_COUNT(framebufferBinds);
 }
 
 void FBO::destroyFramebuffer() {
@@ -72,8 +76,8 @@ void FBO::attach(GLuint texId, GLenum attachment, GLenum target) {
 void FBO::createAttachedTex(int w, int h, bool genMipmap, GLenum attachment, GLenum target) {
     assert(memTransfer && w > 0 && h > 0);
 
-    // get a corrected width and height when we use a mipmap
-    if (genMipmap && core->getUseMipmaps()) {
+    // get a corrected width and height when we use a mipmap on hardware without NPOT mipmaps
+    if (genMipmap && core->getUseMipmaps() && !GLCaps::get().npotMipmaps) {
         w = Tools::getBiggerPOTValue(w);
         h = Tools::getBiggerPOTValue(h);
     }
@@ -81,6 +85,8 @@ void FBO::createAttachedTex(int w, int h, bool genMipmap, GLenum attachment, GLe
     texW = w;
     texH = h;
 
+    renderTargetTexId = 0;
+
     // bind FBO
     bind();
 
@@ -124,6 +130,20 @@ void FBO::createAttachedTex(int w, int h, bool genMipmap, GLenum attachment, GLe
     unbind();
 }
 
+void FBO::setRenderTarget(GLuint texId) {
+    if (texId == renderTargetTexId) {
+        return; // no change
+    }
+
+    renderTargetTexId = texId;
+
+    // the external texture matches the attached one, so skip the completeness check
+    bind();
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, getAttachedTexId(), 0);
+    Tools::checkGLErr("FBO", "setRenderTarget");
+    unbind();
+}
+
 void FBO::readBuffer(unsigned char* buf, int index) {
     assert(memTransfer && attachedTexId > 0 && texW > 0 && texH > 0);
 
@@ -42,10 +42,10 @@ public:
     virtual ~FBO();
 
     /**
-     * Get output texture id.
+     * Get output texture id (the current render target, see setRenderTarget()).
      */
     int getAttachedTexId() const {
-        return attachedTexId;
+        return renderTargetTexId ? renderTargetTexId : attachedTexId;
     }
 
     /**
@@ -97,6 +97,12 @@ public:
      */
     virtual void createAttachedTex(int w, int h, bool genMipmap = false, GLenum attachment = GL_COLOR_ATTACHMENT0, GLenum target = GL_TEXTURE_2D);
 
+    /**
+     * Render into the external texture <texId> instead of the attached texture.
+     * The texture must have the same size and format. Pass 0 to restore the attached texture.
+     */
+    virtual void setRenderTarget(GLuint texId);
+
     /**
      * Copy the framebuffer data which was written to the framebuffer texture back to
      * main memory at <buf>.
@@ -152,6 +158,7 @@ protected:
     GLuint id; // OpenGL FBO id
     GLuint glTexUnit; // GL texture unit (to be used in glActiveTexture()) for output texture
     GLuint attachedTexId; // output texture id
+    GLuint renderTargetTexId = 0; // external output texture id (0 : use attachedTexId)
 
     int texW; // output texture width
     int texH; // output texture height
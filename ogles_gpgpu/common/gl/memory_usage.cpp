@@ -0,0 +1,173 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+#include "memory_usage.h"
+
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+using namespace ogles_gpgpu;
+
+std::atomic<std::size_t> GPUMemory::current(0);
+std::atomic<std::size_t> GPUMemory::peak(0);
+
+struct TextureFormat {
+    GLenum format;
+    const char* name;
+    std::size_t bytesPerPixel;
+};
+
+// clang-format off
+static const TextureFormat kTextureFormats[] = {
+    { GL_RGBA, "RGBA", 4 },
+    { GL_RGB, "RGB", 3 },
+    { GL_LUMINANCE_ALPHA, "LUMINANCE_ALPHA", 2 },
+    { GL_LUMINANCE, "LUMINANCE", 1 },
+    { GL_ALPHA, "ALPHA", 1 },
+    { GL_RGB565, "RGB565", 2 },
+    { GL_RGBA4, "RGBA4", 2 },
+    { GL_RGB5_A1, "RGB5_A1", 2 },
+    { GL_DEPTH_COMPONENT16, "DEPTH_COMPONENT16", 2 },
+#if defined(GL_BGRA)
+    { GL_BGRA, "BGRA", 4 },
+#endif
+#if defined(GL_RGBA8)
+    { GL_RGBA8, "RGBA8", 4 },
+#endif
+#if defined(GL_R8)
+    { GL_R8, "R8", 1 },
+    { GL_RG8, "RG8", 2 },
+#endif
+#if defined(GL_RGBA16F)
+    { GL_R16F, "R16F", 2 },
+    { GL_RGBA16F, "RGBA16F", 8 },
+    { GL_R32F, "R32F", 4 },
+    { GL_RGBA32F, "RGBA32F", 16 },
+#endif
+#if defined(GL_DEPTH24_STENCIL8)
+    { GL_DEPTH24_STENCIL8, "DEPTH24_STENCIL8", 4 },
+#endif
+};
+// clang-format on
+
+static const TextureFormat* findFormat(GLenum internalFormat) {
+    for (const auto& format : kTextureFormats) {
+        if (format.format == internalFormat) {
+            return &format;
+        }
+    }
+    return nullptr;
+}
+
+static std::string formatBytes(std::size_t bytes) {
+    static const char* units[] = { "B", "KB", "MB", "GB" };
+
+    double value = static_cast<double>(bytes);
+    int unit = 0;
+    while (value >= 1024.0 && unit < 3) {
+        value /= 1024.0;
+        unit++;
+    }
+
+    std::stringstream ss;
+    ss << std::setprecision(unit ? 1 : 0) << std::fixed << value << units[unit];
+    return ss.str();
+}
+
+// ########## MemoryUsage
+
+std::size_t MemoryUsage::getBytesPerPixel(GLenum internalFormat) {
+    const TextureFormat* format = findFormat(internalFormat);
+    return format ? format->bytesPerPixel : 4;
+}
+
+std::string MemoryUsage::getFormatName(GLenum internalFormat) {
+    const TextureFormat* format = findFormat(internalFormat);
+    if (format) {
+        return format->name;
+    }
+
+    std::stringstream ss;
+    ss << "0x" << std::hex << internalFormat;
+    return ss.str();
+}
+
+void MemoryUsage::addTexture(GLenum internalFormat, int width, int height) {
+    assert(width >= 0 && height >= 0);
+    textures[internalFormat] += static_cast<std::size_t>(width) * height * getBytesPerPixel(internalFormat);
+}
+
+std::size_t MemoryUsage::getTextureBytes() const {
+    std::size_t bytes = 0;
+    for (const auto& texture : textures) {
+        bytes += texture.second;
+    }
+    return bytes;
+}
+
+std::size_t MemoryUsage::getTotal() const {
+    return getTextureBytes() + pixelBuffers + renderbuffers;
+}
+
+MemoryUsage& MemoryUsage::operator+=(const MemoryUsage& other) {
+    for (const auto& texture : other.textures) {
+        textures[texture.first] += texture.second;
+    }
+    pixelBuffers += other.pixelBuffers;
+    renderbuffers += other.renderbuffers;
+    return *this;
+}
+
+std::string MemoryUsage::toString() const {
+    std::stringstream ss;
+    ss << "total=" << formatBytes(getTotal()) << " textures=" << formatBytes(getTextureBytes());
+    if (!textures.empty()) {
+        const char* separator = " (";
+        for (const auto& texture : textures) {
+            ss << separator << getFormatName(texture.first) << "=" << formatBytes(texture.second);
+            separator = " ";
+        }
+        ss << ")";
+    }
+    ss << " pbos=" << formatBytes(pixelBuffers) << " renderbuffers=" << formatBytes(renderbuffers);
+    return ss.str();
+}
+
+MemoryUsage ogles_gpgpu::getTotal(const MemoryReport& report) {
+    MemoryUsage total;
+    for (const auto& entry : report) {
+        total += entry.second;
+    }
+    return total;
+}
+
+// ########## GPUMemory
+
+void GPUMemory::allocate(std::size_t bytes) {
+    const std::size_t now = (current += bytes);
+
+    std::size_t max = peak.load();
+    while (now > max && !peak.compare_exchange_weak(max, now)) {
+    }
+}
+
+void GPUMemory::release(std::size_t bytes) {
+    assert(current >= bytes);
+    current -= bytes;
+}
+
+std::size_t GPUMemory::getCurrent() {
+    return current;
+}
+
+std::size_t GPUMemory::getPeak() {
+    return peak;
+}
+
+void GPUMemory::resetPeak() {
+    peak = current.load();
+}
@@ -0,0 +1,119 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+/**
+ * GPU memory accounting.
+ */
+#ifndef OGLES_GPGPU_COMMON_GL_MEMORY_USAGE
+#define OGLES_GPGPU_COMMON_GL_MEMORY_USAGE
+
+#include "../common_includes.h"
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ogles_gpgpu {
+
+/**
+ * GPU memory in bytes that is held by a processor or a pipeline, estimated from the size
+ * and format of its textures, pixel buffer objects and renderbuffers. Driver overhead
+ * (alignment, padding, compression) is not included.
+ */
+struct MemoryUsage {
+    std::map<GLenum, std::size_t> textures; // texture bytes by internal format
+    std::size_t pixelBuffers = 0; // pixel buffer object bytes
+    std::size_t renderbuffers = 0; // renderbuffer bytes
+
+    /**
+     * Return the bytes per pixel of the (sized or unsized) internal format <internalFormat>.
+     * Unknown formats count as 4 bytes per pixel.
+     */
+    static std::size_t getBytesPerPixel(GLenum internalFormat);
+
+    /**
+     * Return the name of the internal format <internalFormat>, i.e. "RGBA8".
+     */
+    static std::string getFormatName(GLenum internalFormat);
+
+    /**
+     * Add a texture of size <width>x<height> with internal format <internalFormat>.
+     */
+    void addTexture(GLenum internalFormat, int width, int height);
+
+    /**
+     * Return the bytes of all textures.
+     */
+    std::size_t getTextureBytes() const;
+
+    /**
+     * Return the bytes of all textures, pixel buffer objects and renderbuffers.
+     */
+    std::size_t getTotal() const;
+
+    /**
+     * Add the memory of <other>.
+     */
+    MemoryUsage& operator+=(const MemoryUsage& other);
+
+    /**
+     * Format as "total=1.2MB textures=1.2MB (RGBA8=1.2MB) pbos=0B renderbuffers=0B".
+     */
+    std::string toString() const;
+};
+
+/**
+ * Memory of each processor in a pipeline, as (name, memory) in pipeline order
+ * (see ProcInterface::getMemoryReport()).
+ */
+using MemoryReport = std::vector<std::pair<std::string, MemoryUsage>>;
+
+/**
+ * Return the total memory of all entries of <report>.
+ */
+MemoryUsage getTotal(const MemoryReport& report);
+
+/**
+ * Global counters of the GPU memory that is currently allocated by all ogles_gpgpu objects,
+ * i.e. to find the peak memory while a pipeline is (re)initialized. Thread safe.
+ */
+class GPUMemory {
+public:
+    /**
+     * Count <bytes> newly allocated bytes.
+     */
+    static void allocate(std::size_t bytes);
+
+    /**
+     * Count <bytes> released bytes.
+     */
+    static void release(std::size_t bytes);
+
+    /**
+     * Return the currently allocated bytes.
+     */
+    static std::size_t getCurrent();
+
+    /**
+     * Return the maximum of the allocated bytes since the last resetPeak().
+     */
+    static std::size_t getPeak();
+
+    /**
+     * Restart the peak measurement at the currently allocated bytes.
+     */
+    static void resetPeak();
+
+private:
+    static std::atomic<std::size_t> current;
+    static std::atomic<std::size_t> peak;
+};
+}
+
+#endif
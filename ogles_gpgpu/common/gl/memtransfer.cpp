@@ -8,6 +8,7 @@
 //
 
 #include "memtransfer.h"
+#include "call_counters.h"
 #include "fbo.h"
 
 // clang-format off
@@ -18,6 +19,14 @@
 
 using namespace ogles_gpgpu;
 
+// clang-format off
+#if defined(OGLES_GPGPU_OPENGL)
+static const GLenum kOutputInternalFormat = GL_RGBA8; // sized format, i.e. for compute shader image writes
+#else
+static const GLenum kOutputInternalFormat = GL_RGBA;
+#endif
+// clang-format on
+
 #pragma mark static methods
 
 bool MemTransfer::initPlatformOptimizations() {
@@ -47,6 +56,9 @@ MemTransfer::~MemTransfer() {
     // release in- and output
     releaseInput();
     releaseOutput();
+
+    // memory that a platform specific subclass did not report as released
+    GPUMemory::release(trackedBytes);
 }
 
 /**
@@ -56,6 +68,7 @@ MemTransfer::~MemTransfer() {
 void MemTransfer::resizePBO(int count) {
 #if defined(OGLES_GPGPU_OPENGL_ES3)
     pboReaders.resize(count);
+    updateMemoryUsage();
 #endif
 }
 
@@ -90,6 +103,7 @@ GLuint MemTransfer::prepareInput(int inTexW, int inTexH, GLenum inputPxFormat, v
     }
 
     glBindTexture(GL_TEXTURE_2D, inputTexId);
+    OG_GL_COUNT(textureBinds);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -99,14 +113,18 @@ GLuint MemTransfer::prepareInput(int inTexW, int inTexH, GLenum inputPxFormat, v
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, inputW, inputH, 0, inputPixelFormat, GL_UNSIGNED_BYTE, nullptr);
 #endif
     glBindTexture(GL_TEXTURE_2D, 0);
+    OG_GL_COUNT(textureBinds);
 
 #if defined(OGLES_GPGPU_OPENGL_ES3)
     // ::::::: allocate ::::::::::
-    pboWrite = std::unique_ptr<OPBO>(new OPBO(inputW, inputH));
+    if (usePixelBufferObjects) {
+        pboWrite = std::unique_ptr<OPBO>(new OPBO(inputW, inputH));
+    }
 #endif // defined(OGLES_GPGPU_OPENGL_ES3)
 
     // done
     preparedInput = true;
+    updateMemoryUsage();
 
     // Texture data to be upladed with Core::setInputData(...)
     return inputTexId;
@@ -143,7 +161,7 @@ GLuint MemTransfer::prepareOutput(int outTexW, int outTexH) {
 
     // create empty texture space on GPU
     glTexImage2D(GL_TEXTURE_2D, 0,
-        GL_RGBA,
+        kOutputInternalFormat,
         outTexW, outTexH, 0,
         rgbFormat, GL_UNSIGNED_BYTE,
         NULL); // we do not need to pass texture data -> it will be generated!
@@ -152,13 +170,16 @@ GLuint MemTransfer::prepareOutput(int outTexW, int outTexH) {
 
 #if defined(OGLES_GPGPU_OPENGL_ES3)
     // ::::::: allocate ::::::::::
-    for (auto& pbo : pboReaders) {
-        pbo = std::unique_ptr<IPBO>(new IPBO(outputW, outputH));
+    if (usePixelBufferObjects) {
+        for (auto& pbo : pboReaders) {
+            pbo = std::unique_ptr<IPBO>(new IPBO(outputW, outputH));
+        }
     }
 #endif // OGLES_GPGPU_OPENGL_ES3
 
     // done
     preparedOutput = true;
+    updateMemoryUsage();
 
     return outputTexId;
 }
@@ -174,6 +195,8 @@ void MemTransfer::releaseInput() {
         pboWrite.reset();
     }
 #endif // defined(OGLES_GPGPU_OPENGL_ES3)
+
+    updateMemoryUsage();
 }
 
 void MemTransfer::releaseOutput() {
@@ -189,33 +212,83 @@ void MemTransfer::releaseOutput() {
         }
     }
 #endif // defined(OGLES_GPGPU_OPENGL_ES3)
+
+    updateMemoryUsage();
 }
 
-void MemTransfer::toGPU(const unsigned char* buf) {
-    assert(preparedInput && inputTexId > 0 && buf);
+GLenum MemTransfer::getOutputInternalFormat() const {
+    return kOutputInternalFormat;
+}
+
+void MemTransfer::addMemoryUsage(MemoryUsage& usage) const {
+    if (preparedInput && inputTexId > 0) {
+        usage.addTexture(GL_RGBA, inputW, inputH);
+    }
+
+    // YUV input (platform specific subclasses): full size Y and half size interleaved UV planes
+    if (preparedInput && luminanceTexId > 0) {
+        usage.addTexture(GL_LUMINANCE, inputW, inputH);
+    }
+    if (preparedInput && chrominanceTexId > 0) {
+        usage.addTexture(GL_LUMINANCE_ALPHA, inputW / 2, inputH / 2);
+    }
+
+    if (preparedOutput && outputTexId > 0) {
+        usage.addTexture(kOutputInternalFormat, outputW, outputH);
+    }
 
 #if defined(OGLES_GPGPU_OPENGL_ES3)
+    if (pboWrite) {
+        usage.pixelBuffers += static_cast<std::size_t>(inputW) * inputH * 4;
+    }
+    for (const auto& pbo : pboReaders) {
+        if (pbo) {
+            usage.pixelBuffers += static_cast<std::size_t>(outputW) * outputH * 4;
+        }
+    }
+#endif // defined(OGLES_GPGPU_OPENGL_ES3)
+}
 
-    pboWrite->bind();
-    Tools::checkGLErr("MemTransfer", "toGPU (PBO::bind())");
+void MemTransfer::updateMemoryUsage() {
+    MemoryUsage usage;
+    addMemoryUsage(usage);
 
-    pboWrite->write(buf, inputTexId);
-    Tools::checkGLErr("MemTransfer", "toGPU (PBO::write())");
+    const std::size_t bytes = usage.getTotal();
+    if (bytes > trackedBytes) {
+        GPUMemory::allocate(bytes - trackedBytes);
+    } else {
+        GPUMemory::release(trackedBytes - bytes);
+    }
+    trackedBytes = bytes;
+}
 
-    pboWrite->unbind();
-    Tools::checkGLErr("MemTransfer", "toGPU (PBO::unbind())");
+void MemTransfer::toGPU(const unsigned char* buf) {
+    assert(preparedInput && inputTexId > 0 && buf);
 
-#else // defined(OGLES_GPGPU_OPENGL_ES3)
-    // set input texture
-    glBindTexture(GL_TEXTURE_2D, inputTexId); // bind input texture
+#if defined(OGLES_GPGPU_OPENGL_ES3)
+    if (pboWrite) {
+        pboWrite->bind();
+        Tools::checkGLErr("MemTransfer", "toGPU (PBO::bind())");
 
-    // copy data as texture to GPU (tested: OS X)
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, inputW, inputH, 0, inputPixelFormat, GL_UNSIGNED_BYTE, buf);
+        pboWrite->write(buf, inputTexId);
+        Tools::checkGLErr("MemTransfer", "toGPU (PBO::write())");
 
-    // check for error
-    Tools::checkGLErr("MemTransfer", "toGPU (glTexImage2D)");
+        pboWrite->unbind();
+        Tools::checkGLErr("MemTransfer", "toGPU (PBO::unbind())");
+    } else
 #endif // defined(OGLES_GPGPU_OPENGL_ES3)
+    {
+        // set input texture
+        glBindTexture(GL_TEXTURE_2D, inputTexId); // bind input texture
+        OG_GL_COUNT(textureBinds);
+
+        // copy data as texture to GPU (tested: OS X)
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, inputW, inputH, 0, inputPixelFormat, GL_UNSIGNED_BYTE, buf);
+
+        // check for error
+        Tools::checkGLErr("MemTransfer", "toGPU (glTexImage2D)");
+    }
 
     setCommonTextureParams(0);
 }
@@ -224,35 +297,50 @@ void MemTransfer::fromGPU(unsigned char* buf, int index) {
     assert(preparedOutput && outputTexId);
 
 #if defined(OGLES_GPGPU_OPENGL_ES3)
-    assert(index < pboReaders.size());
-
-    pboReaders[index]->bind();
-    Tools::checkGLErr("MemTransfer", "toGPU (PBO::bind())");
-
-    if (buf) {
-        if (pboReaders[index]->isReadingAsynchronously()) {
-            pboReaders[index]->finish(buf);
+    if (usePixelBufferObjects) {
+        assert(index >= 0 && index < static_cast<int>(pboReaders.size()));
+
+        pboReaders[index]->bind();
+        Tools::checkGLErr("MemTransfer", "toGPU (PBO::bind())");
+
+        if (buf) {
+            if (pboReaders[index]->isReadingAsynchronously()) {
+                pboReaders[index]->finish(buf);
+            } else {
+                pboReaders[index]->read(buf);
+            }
         } else {
-            pboReaders[index]->read(buf);
+            pboReaders[index]->start();
         }
-    } else {
-        pboReaders[index]->start();
-    }
 
-    Tools::checkGLErr("MemTransfer", "toGPU (PBO::read())");
+        Tools::checkGLErr("MemTransfer", "toGPU (PBO::read())");
+
+        pboReaders[index]->unbind();
+        Tools::checkGLErr("MemTransfer", "toGPU (PBO::unbind())");
+        return;
+    }
+#endif // defined(OGLES_GPGPU_OPENGL_ES3)
 
-    pboReaders[index]->unbind();
-    Tools::checkGLErr("MemTransfer", "toGPU (PBO::unbind())");
+    if (!buf) {
+        return; // asynchronous reads require PBOs
+    }
 
-#else // defined(OGLES_GPGPU_OPENGL_ES3)
-    assert(buf);
     glBindTexture(GL_TEXTURE_2D, outputTexId);
+    OG_GL_COUNT(textureBinds);
     Tools::checkGLErr("MemTransfer", "fromGPU: (glBindTexture)");
 
     // default (and slow) way using glReadPixels:
     glReadPixels(0, 0, outputW, outputH, outputPixelFormat, GL_UNSIGNED_BYTE, buf);
     Tools::checkGLErr("MemTransfer", "fromGPU: (glReadPixels)");
+}
+
+bool MemTransfer::isReadingAsynchronously(int index) const {
+#if defined(OGLES_GPGPU_OPENGL_ES3)
+    if (usePixelBufferObjects && index >= 0 && index < static_cast<int>(pboReaders.size())) {
+        return pboReaders[index]->isReadingAsynchronously();
+    }
 #endif // defined(OGLES_GPGPU_OPENGL_ES3)
+    return false;
 }
 
 // The zero copy fromGPU() call is not possibly with generic glReadPixels() access
@@ -273,6 +361,7 @@ void MemTransfer::setOutputPixelFormat(GLenum outputPxFormat) {
 void MemTransfer::setCommonTextureParams(GLuint texId, GLenum target) {
     if (texId > 0) {
         glBindTexture(target, texId);
+        OG_GL_COUNT(textureBinds);
         Tools::checkGLErr("MemTransfer", "setCommonTextureParams (glBindTexture)");
     }
 
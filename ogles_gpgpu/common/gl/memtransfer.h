@@ -15,6 +15,7 @@
 #define OGLES_GPGPU_COMMON_GL_MEMTRANSFER
 
 #include "../common_includes.h"
+#include "memory_usage.h"
 
 #include <functional>
 #include <memory>
@@ -161,6 +162,11 @@ public:
         return outputPixelFormat;
     }
 
+    /**
+     * Get the internal format of the output texture (i.e., GL_RGBA8)
+     */
+    virtual GLenum getOutputInternalFormat() const;
+
     /**
      * Inidcates whether or not this MemTransfer implementation
      * support zero copy texture access (i.e., MemTransferIOS)
@@ -188,6 +194,34 @@ public:
      */
     virtual void resizePBO(int count);
 
+    /**
+     * Use pixel buffer objects for up- and downloads if <flag> is true and they are compiled in
+     * (OpenGL ES 3.0), else use glTexImage2D() / glReadPixels(). Must be set before prepareInput()
+     * and prepareOutput(). MemTransferFactory sets this according to GLCaps.
+     */
+    virtual void setUsePixelBufferObjects(bool flag) {
+        usePixelBufferObjects = flag;
+    }
+
+    /**
+     * Return true if an asynchronous read of PBO <index> was started with fromGPU() and
+     * not finished yet.
+     */
+    bool isReadingAsynchronously(int index = 0) const;
+
+    /**
+     * Return true if pixel buffer objects are used.
+     */
+    bool getUsePixelBufferObjects() const {
+        return usePixelBufferObjects;
+    }
+
+    /**
+     * Add the GPU memory held by this object (input and output textures, pixel buffer
+     * objects) to <usage>.
+     */
+    virtual void addMemoryUsage(MemoryUsage& usage) const;
+
     /**
      * Try to initialize platform optimizations. Returns true on success, else false.
      * Is only fully implemented in platform-specialized classes of MemTransfer.
@@ -201,6 +235,12 @@ protected:
      */
     virtual void setCommonTextureParams(GLuint texId, GLenum target = GL_TEXTURE_2D);
 
+    /**
+     * Report the change of addMemoryUsage() since the last call to GPUMemory. Must be called
+     * after allocating or releasing textures or pixel buffer objects.
+     */
+    void updateMemoryUsage();
+
     bool initialized; // is initialized?
 
     bool preparedInput; // input is prepared?
@@ -222,6 +262,10 @@ protected:
 
     bool useRawPixels = false;
 
+    bool usePixelBufferObjects = true; // use PBOs where compiled in (see setUsePixelBufferObjects())
+
+    std::size_t trackedBytes = 0; // memory reported to GPUMemory (see updateMemoryUsage())
+
 #if defined(OGLES_GPGPU_OPENGL_ES3)
     FBO* fbo = nullptr;
 
@@ -9,6 +9,7 @@
 
 #include "memtransfer_factory.h"
 #include "../core.h"
+#include "caps.h"
 
 // clang-off
 #if defined(OGLES_GPGPU_IOS)
@@ -37,6 +38,9 @@ std::unique_ptr<MemTransfer> MemTransferFactory::createInstance() {
         instance = std::unique_ptr<MemTransfer>(new MemTransfer);
     }
 
+    // select the transfer path supported by the current context
+    instance->setUsePixelBufferObjects(GLCaps::get().pixelBufferObjects);
+
     return instance;
 }
 
@@ -7,6 +7,7 @@
 // Copyright (c) 2017, David Hirvonen (this file)
 
 #include "pbo.h"
+#include "call_counters.h"
 #include "ogles_gpgpu/platform/opengl/gl_includes.h"
 
 #include <iostream>
@@ -82,8 +83,10 @@ void IPBO::finish(GLubyte* buffer) {
 #if defined(OGLES_GPGPU_OSX)
         // Note: glMapBufferRange does not seem to work in OS X
         GLubyte* ptr = static_cast<GLubyte*>(glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY));
+        OG_GL_COUNT(bufferMaps);
 #else
         GLubyte* ptr = static_cast<GLubyte*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, pbo_size, GL_MAP_READ_BIT));
+        OG_GL_COUNT(bufferMaps);
 #endif
         Tools::checkGLErr("IPBO::finish", "glMapBufferRange()");
 
@@ -150,9 +153,11 @@ void OPBO::write(const GLubyte* buffer, GLuint texId) {
 #if defined(OGLES_GPGPU_OSX)
     // TODO: glMapBufferRange does not seem to work in OS X
     GLubyte* ptr = static_cast<GLubyte*>(glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY));
+    OG_GL_COUNT(bufferMaps);
     Tools::checkGLErr("OPBO::write", "glMapBuffer()");
 #else
     GLubyte* ptr = static_cast<GLubyte*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, pbo_size, GL_MAP_WRITE_BIT));
+    OG_GL_COUNT(bufferMaps);
     Tools::checkGLErr("OPBO::write", "glMapBufferRange()");
 #endif
 
@@ -163,6 +168,7 @@ void OPBO::write(const GLubyte* buffer, GLuint texId) {
         Tools::checkGLErr("OPBO::write", "glUnmapBuffer()");
 
         glBindTexture(GL_TEXTURE_2D, texId);
+        OG_GL_COUNT(textureBinds);
         Tools::checkGLErr("OPBO::write", "glBindTexture()");
 
         glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, OGLES_GPGPU_TEXTURE_FORMAT, GL_UNSIGNED_BYTE, 0);
@@ -0,0 +1,204 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+#include "program_cache.h"
+#include "call_counters.h"
+#include "caps.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <process.h> // _getpid()
+#else
+#include <unistd.h> // getpid()
+#endif
+
+// clang-format off
+#if defined(OGLES_GPGPU_OPENGL_ES3) || (defined(OGLES_GPGPU_OPENGL) && defined(GL_VERSION_4_1) && !defined(__APPLE__))
+#  define OGLES_GPGPU_PROGRAM_BINARY 1
+#endif
+// clang-format on
+
+using namespace std;
+using namespace ogles_gpgpu;
+
+std::string ProgramBinaryCache::directory;
+unsigned int ProgramBinaryCache::hitCount = 0;
+unsigned int ProgramBinaryCache::missCount = 0;
+
+namespace {
+
+const uint32_t kMagic = 0x4250474f; // "OGPB"
+const uint32_t kFileVersion = 1;
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t format;
+    uint32_t length;
+};
+
+// 64 bit FNV-1a
+uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+uint64_t hashString(uint64_t hash, const char* str) {
+    str = str ? str : "";
+    return hashBytes(hash, str, strlen(str) + 1); // include the terminator as separator
+}
+
+uint64_t parseKey(const std::string& key) {
+    return strtoull(key.c_str(), nullptr, 16);
+}
+}
+
+void ProgramBinaryCache::setDirectory(const std::string& dir) {
+    directory = dir;
+}
+
+bool ProgramBinaryCache::isEnabled() {
+#if defined(OGLES_GPGPU_PROGRAM_BINARY)
+    return !directory.empty() && GLCaps::get().programBinaries;
+#else
+    return false;
+#endif
+}
+
+std::string ProgramBinaryCache::makeKey(const char* vshSrc, const char* fshSrc, const Shader::Attributes& attributes) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    // driver identity: a driver update invalidates all entries
+    hash = hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+    hash = hashString(hash, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    hash = hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+    hash = hashString(hash, vshSrc);
+    hash = hashString(hash, fshSrc);
+    for (const auto& attribute : attributes) {
+        hash = hashBytes(hash, &attribute.first, sizeof(attribute.first));
+        hash = hashString(hash, attribute.second);
+    }
+
+    char key[17];
+    snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(hash));
+    return key;
+}
+
+std::string ProgramBinaryCache::getFilePath(const std::string& key) {
+    return directory + "/" + key + ".bin";
+}
+
+GLuint ProgramBinaryCache::load(const std::string& key) {
+#if defined(OGLES_GPGPU_PROGRAM_BINARY)
+    if (!isEnabled()) {
+        return 0;
+    }
+
+    ifstream file(getFilePath(key), ios::binary);
+
+    FileHeader header;
+    if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || header.magic != kMagic || header.version != kFileVersion || header.key != parseKey(key)) {
+        missCount++;
+        return 0;
+    }
+
+    std::vector<char> binary(header.length);
+    if (!file.read(binary.data(), binary.size())) {
+        missCount++;
+        return 0;
+    }
+
+    GLuint programId = glCreateProgram();
+    glProgramBinary(programId, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    // the driver rejects binaries of other driver versions or formats
+    GLint linkStatus = GL_FALSE;
+    glGetProgramiv(programId, GL_LINK_STATUS, &linkStatus);
+    OG_GL_COUNT(errorChecks);
+    if (glGetError() != GL_NO_ERROR || linkStatus != GL_TRUE) {
+        OG_LOGINF("ProgramBinaryCache", "binary for %s rejected by driver", key.c_str());
+        glDeleteProgram(programId);
+        missCount++;
+        return 0;
+    }
+
+    OG_LOGINF("ProgramBinaryCache", "loaded program %d from %s", programId, key.c_str());
+
+    hitCount++;
+    return programId;
+#else
+    return 0;
+#endif
+}
+
+void ProgramBinaryCache::store(const std::string& key, GLuint programId) {
+#if defined(OGLES_GPGPU_PROGRAM_BINARY)
+    if (!isEnabled()) {
+        return;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(programId, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        OG_LOGERR("ProgramBinaryCache", "program %d has no binary", programId);
+        return;
+    }
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(programId, length, &written, &format, binary.data());
+    Tools::checkGLErr("ProgramBinaryCache", "glGetProgramBinary()");
+
+    FileHeader header = { kMagic, kFileVersion, parseKey(key), format, static_cast<uint32_t>(written) };
+
+    // write to a temporary file of this process first, so concurrent readers never see
+    // partial entries and concurrent writers never write to the same file
+    const std::string path = getFilePath(key);
+    std::stringstream ss;
+#if defined(_WIN32) || defined(_WIN64)
+    ss << path << "." << _getpid() << ".tmp";
+#else
+    ss << path << "." << getpid() << ".tmp";
+#endif
+    const std::string tmpPath = ss.str();
+    {
+        ofstream file(tmpPath, ios::binary | ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), written);
+        if (!file) {
+            OG_LOGERR("ProgramBinaryCache", "could not write %s", tmpPath.c_str());
+            return;
+        }
+    }
+
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        OG_LOGERR("ProgramBinaryCache", "could not write %s", path.c_str());
+        std::remove(tmpPath.c_str());
+    }
+#endif
+}
+
+void ProgramBinaryCache::setRetrievableHint(GLuint programId) {
+#if defined(OGLES_GPGPU_PROGRAM_BINARY)
+    if (isEnabled()) {
+        glProgramParameteri(programId, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+#endif
+}
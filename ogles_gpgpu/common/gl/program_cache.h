@@ -0,0 +1,104 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+/**
+ * On-disk shader program binary cache.
+ */
+#ifndef OGLES_GPGPU_COMMON_GL_PROGRAM_CACHE
+#define OGLES_GPGPU_COMMON_GL_PROGRAM_CACHE
+
+#include "../common_includes.h"
+
+#include "shader.h"
+
+#include <string>
+
+namespace ogles_gpgpu {
+
+/**
+ * Stores linked shader programs as driver specific binaries (glGetProgramBinary())
+ * in a user specified directory and restores them with glProgramBinary() instead
+ * of compiling and linking the sources again.
+ *
+ * Entries are keyed by a hash of the shader sources, the attribute bindings and the
+ * driver identity (GL_VENDOR, GL_RENDERER, GL_VERSION), so a driver update results
+ * in cache misses. Binaries that are rejected by the driver count as misses, too,
+ * and are replaced after the program was built from source.
+ *
+ * The cache is disabled by default. It requires OpenGL ES 3.0 or OpenGL 4.1 and a
+ * driver that supports at least one program binary format (see GLCaps).
+ */
+class ProgramBinaryCache {
+public:
+    /**
+     * Set the cache directory <dir> (must exist). An empty string disables the cache.
+     */
+    static void setDirectory(const std::string& dir);
+
+    /**
+     * Get the cache directory.
+     */
+    static const std::string& getDirectory() {
+        return directory;
+    }
+
+    /**
+     * Return true if a directory is set and the current context supports program binaries.
+     */
+    static bool isEnabled();
+
+    /**
+     * Create the cache key for a program with sources <vshSrc>, <fshSrc> and <attributes>.
+     */
+    static std::string makeKey(const char* vshSrc, const char* fshSrc, const Shader::Attributes& attributes);
+
+    /**
+     * Create a linked program from the binary stored for <key>. Returns 0 on a cache miss.
+     */
+    static GLuint load(const std::string& key);
+
+    /**
+     * Store the binary of linked program <programId> for <key>.
+     */
+    static void store(const std::string& key, GLuint programId);
+
+    /**
+     * Request a retrievable binary for program <programId> (call before linking).
+     */
+    static void setRetrievableHint(GLuint programId);
+
+    /**
+     * Get the number of cache hits.
+     */
+    static unsigned int getHitCount() {
+        return hitCount;
+    }
+
+    /**
+     * Get the number of cache misses.
+     */
+    static unsigned int getMissCount() {
+        return missCount;
+    }
+
+    /**
+     * Reset hit and miss counts.
+     */
+    static void resetCounts() {
+        hitCount = missCount = 0;
+    }
+
+private:
+    static std::string getFilePath(const std::string& key);
+
+    static std::string directory;
+
+    static unsigned int hitCount;
+    static unsigned int missCount;
+};
+}
+
+#endif
@@ -8,12 +8,20 @@
 //
 
 #include "shader.h"
+#include "call_counters.h"
+#include "caps.h"
+#include "program_cache.h"
+
+#ifndef GL_COMPLETION_STATUS_KHR
+#  define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
 
 using namespace std;
 using namespace ogles_gpgpu;
 
 Shader::Shader() {
     programId = 0;
+    vshId = fshId = 0;
 }
 
 Shader::~Shader() {
@@ -24,13 +32,95 @@ Shader::~Shader() {
 }
 
 bool Shader::buildFromSrc(const char* vshSrc, const char* fshSrc, const std::vector<Attribute>& attributes) {
+    submit(vshSrc, fshSrc, attributes);
+    return finish();
+}
+
+#if defined(OGLES_GPGPU_COMPUTE)
+bool Shader::buildComputeFromSrc(const char* cshSrc) {
+    assert(programId == 0);
+
+    GLuint cshId = compile(GL_COMPUTE_SHADER, cshSrc);
+    if (cshId == 0 || !checkCompileStatus(cshId, cshSrc)) {
+        return false;
+    }
+
+    programId = glCreateProgram();
+    if (programId == 0) {
+        OG_LOGERR("Shader", "could not create shader program");
+        glDeleteShader(cshId);
+        return false;
+    }
+
+    glAttachShader(programId, cshId);
+    glLinkProgram(programId);
+    glDeleteShader(cshId); // released with the program
+
+    if (!checkLinkStatus(programId)) {
+        glDeleteProgram(programId);
+        programId = 0;
+    }
+
+    return (programId > 0);
+}
+#endif
+
+void Shader::submit(const char* vshSrc, const char* fshSrc, const std::vector<Attribute>& attributes) {
+    assert(programId == 0);
+
+    cacheKey.clear();
+    if (ProgramBinaryCache::isEnabled()) {
+        cacheKey = ProgramBinaryCache::makeKey(vshSrc, fshSrc, attributes);
+        programId = ProgramBinaryCache::load(cacheKey);
+        if (programId > 0) {
+            return; // linked already
+        }
+    }
+
     programId = create(vshSrc, fshSrc, &vshId, &fshId, attributes);
 
+    if (programId > 0) {
+        pending = true;
+        this->vshSrc = vshSrc;
+        this->fshSrc = fshSrc;
+    }
+}
+
+bool Shader::isReady() const {
+    if (!pending || !GLCaps::get().parallelShaderCompile) {
+        return true;
+    }
+
+    GLint completionStatus = GL_FALSE;
+    glGetProgramiv(programId, GL_COMPLETION_STATUS_KHR, &completionStatus);
+    return (completionStatus == GL_TRUE);
+}
+
+bool Shader::finish() {
+    if (!pending) {
+        return (programId > 0);
+    }
+
+    pending = false;
+
+    // these are the first status queries, which wait for the driver
+    bool compiled = checkCompileStatus(vshId, vshSrc) && checkCompileStatus(fshId, fshSrc);
+    if (!compiled || !checkLinkStatus(programId)) {
+        glDeleteProgram(programId);
+        programId = 0;
+    } else if (!cacheKey.empty()) {
+        ProgramBinaryCache::store(cacheKey, programId);
+    }
+
+    vshSrc.clear();
+    fshSrc.clear();
+
     return (programId > 0);
 }
 
 void Shader::use() {
     glUseProgram(programId);
+    OG_GL_COUNT(programBinds);
 }
 
 GLint Shader::getParam(ShaderParamType type, const char* name) const {
@@ -49,6 +139,10 @@ Shader::create(const char* vshSrc, const char* fshSrc, GLuint* vshId, GLuint* fs
     *vshId = compile(GL_VERTEX_SHADER, vshSrc);
     *fshId = compile(GL_FRAGMENT_SHADER, fshSrc);
 
+    if (*vshId == 0 || *fshId == 0) {
+        return 0;
+    }
+
     // create shader program
     GLuint programId = glCreateProgram();
 
@@ -66,23 +160,9 @@ Shader::create(const char* vshSrc, const char* fshSrc, GLuint* vshId, GLuint* fs
         glBindAttribLocation(programId, attributes[i].first, attributes[i].second);
     }
 
-    glLinkProgram(programId); // link both shaders to a full program
-
-    // check link status
-    GLint linkStatus;
-    glGetProgramiv(programId, GL_LINK_STATUS, &linkStatus);
-    if (linkStatus != GL_TRUE) {
-        OG_LOGERR("Shader", "could not link shader program. error log:");
-        GLchar infoLogBuf[1024];
-        GLsizei infoLogLen;
-        glGetProgramInfoLog(programId, 1024, &infoLogLen, infoLogBuf);
-        cerr << infoLogBuf << endl
-             << endl;
+    ProgramBinaryCache::setRetrievableHint(programId);
 
-        glDeleteProgram(programId);
-
-        return 0;
-    }
+    glLinkProgram(programId); // link both shaders to a full program
 
     return programId;
 }
@@ -102,7 +182,10 @@ GLuint Shader::compile(GLenum type, const char* src) {
     // compile the shader
     glCompileShader(shId);
 
-    // check compile status
+    return shId;
+}
+
+bool Shader::checkCompileStatus(GLuint shId, const std::string& src) {
     GLint compileStatus;
     glGetShaderiv(shId, GL_COMPILE_STATUS, &compileStatus);
 
@@ -119,8 +202,25 @@ GLuint Shader::compile(GLenum type, const char* src) {
 
         glDeleteShader(shId);
 
-        return 0;
+        return false;
     }
 
-    return shId;
+    return true;
+}
+
+bool Shader::checkLinkStatus(GLuint programId) {
+    GLint linkStatus;
+    glGetProgramiv(programId, GL_LINK_STATUS, &linkStatus);
+    if (linkStatus != GL_TRUE) {
+        OG_LOGERR("Shader", "could not link shader program. error log:");
+        GLchar infoLogBuf[1024];
+        GLsizei infoLogLen;
+        glGetProgramInfoLog(programId, 1024, &infoLogLen, infoLogBuf);
+        cerr << infoLogBuf << endl
+             << endl;
+
+        return false;
+    }
+
+    return true;
 }
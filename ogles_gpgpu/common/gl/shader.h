@@ -15,6 +15,10 @@
 
 #include "../common_includes.h"
 
+#include <map>
+#include <string>
+#include <vector>
+
 #if OGLES_GPGPU_OPENGLES
 #define OGLES_GPGPU_LOWP lowp
 #define OGLES_GPGPU_MEDIUMP mediump
@@ -25,6 +29,12 @@
 #define OGLES_GPGPU_HIGHP
 #endif
 
+// clang-format off
+#if defined(OGLES_GPGPU_OPENGL) && defined(GL_VERSION_4_3) && !defined(__APPLE__)
+#  define OGLES_GPGPU_COMPUTE 1 // compute shaders (see GLCaps::computeShaders)
+#endif
+// clang-format on
+
 namespace ogles_gpgpu {
 
 typedef enum {
@@ -40,6 +50,14 @@ public:
     typedef std::pair<int, const char*> Attribute;
     typedef std::vector<Attribute> Attributes;
 
+    /**
+     * Value that was last uploaded to a uniform of the program (see Uniform).
+     */
+    struct UniformValue {
+        std::size_t size = 0; // 0: not uploaded yet
+        unsigned char data[16 * sizeof(GLfloat)];
+    };
+
     /**
      * Constructor.
      */
@@ -56,6 +74,39 @@ public:
      */
     bool buildFromSrc(const char* vshSrc, const char* fshSrc, const std::vector<Attribute>& attributes = {});
 
+#if defined(OGLES_GPGPU_COMPUTE)
+    /**
+     * Build an OpenGL program from compute shader source code <cshSrc>.
+     */
+    bool buildComputeFromSrc(const char* cshSrc);
+#endif
+
+    /**
+     * Compile and link a program from <vshSrc> and <fshSrc>, but do not wait for the
+     * result. The status is checked in finish(), so that the driver can build several
+     * submitted programs in parallel (i.e. with KHR_parallel_shader_compile).
+     */
+    void submit(const char* vshSrc, const char* fshSrc, const std::vector<Attribute>& attributes = {});
+
+    /**
+     * Return true if a submitted program can be finished without waiting for the driver.
+     * This is only known with KHR_parallel_shader_compile, otherwise returns true.
+     */
+    bool isReady() const;
+
+    /**
+     * Return true if the program was submitted, but not finished yet.
+     */
+    bool isPending() const {
+        return pending;
+    }
+
+    /**
+     * Check the compile and link status of a submitted program.
+     * Returns false and releases the program on errors.
+     */
+    bool finish();
+
     /**
      * Use the shader program.
      */
@@ -67,6 +118,14 @@ public:
      */
     GLint getParam(ShaderParamType type, const char* name) const;
 
+    /**
+     * Get the value store of the uniform at <location>, or nullptr for location -1.
+     * The store lives as long as the program.
+     */
+    UniformValue* getUniformValue(GLint location) {
+        return (location < 0) ? nullptr : &uniformValues[location];
+    }
+
     /**
      * Get a shader parameter position for a parameter of type <type> and with
      * <name>.
@@ -77,19 +136,37 @@ public:
 
 private:
     /**
-     * Create a shader program from sources <vshSrc> and <fshSrc>. Save shader ids in
-     * <vshId> and <fshId>.
+     * Create a shader program from sources <vshSrc> and <fshSrc> and link it. Save shader
+     * ids in <vshId> and <fshId>. The status is not checked.
      */
     static GLuint create(const char* vshSrc, const char* fshSrc, GLuint* vshId, GLuint* fshId, const Attributes& attributes = {});
 
     /**
      * Compile a shader of type <type> and source <src> and return its id.
+     * The status is not checked.
      */
     static GLuint compile(GLenum type, const char* src);
 
+    /**
+     * Check the compile status of shader <shId> with source <src>.
+     */
+    static bool checkCompileStatus(GLuint shId, const std::string& src);
+
+    /**
+     * Check the link status of program <programId>.
+     */
+    static bool checkLinkStatus(GLuint programId);
+
     GLuint programId; // full shader program id
     GLuint vshId; // vertex shader id
     GLuint fshId; // fragment shader id
+
+    bool pending = false; // submitted, but status not checked yet
+    std::string vshSrc; // sources of a pending program (for the error log)
+    std::string fshSrc;
+    std::string cacheKey; // ProgramBinaryCache key of a pending program
+
+    std::map<GLint, UniformValue> uniformValues; // last uploaded uniform values by location
 };
 }
 
@@ -0,0 +1,92 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+#include "shader_cache.h"
+
+#include <sstream>
+
+using namespace std;
+using namespace ogles_gpgpu;
+
+std::map<std::string, std::weak_ptr<Shader>> ShaderCache::programs;
+std::vector<std::shared_ptr<Shader>> ShaderCache::prefetched;
+unsigned int ShaderCache::hitCount = 0;
+unsigned int ShaderCache::missCount = 0;
+
+std::string ShaderCache::makeKey(const char* vShSrc, const char* fShSrc, const Shader::Attributes& attributes) {
+    // key: all inputs of the program, '\0' separated (the texture target is part of the sources)
+    std::stringstream ss;
+    ss << vShSrc << '\0' << fShSrc;
+    for (const auto& attribute : attributes) {
+        ss << '\0' << attribute.first << ':' << attribute.second;
+    }
+    return ss.str();
+}
+
+std::shared_ptr<Shader> ShaderCache::acquire(const char* vShSrc, const char* fShSrc, const Shader::Attributes& attributes) {
+    const std::string key = makeKey(vShSrc, fShSrc, attributes);
+
+    auto iter = programs.find(key);
+    if (iter != programs.end()) {
+        if (auto shader = iter->second.lock()) {
+            if (shader->isPending()) { // prefetched
+                OG_LOGINF("ShaderCache", "program %d prefetched (ready: %d)", shader->getProgramId(), shader->isReady());
+                if (!shader->finish()) {
+                    programs.erase(iter);
+                    return shader;
+                }
+            }
+            hitCount++;
+            return shader;
+        }
+        programs.erase(iter); // released by all users
+    }
+
+    auto shader = std::make_shared<Shader>();
+    bool compiled = shader->buildFromSrc(vShSrc, fShSrc, attributes);
+
+    if (compiled) {
+        programs[key] = shader;
+    }
+
+    missCount++;
+    return shader;
+}
+
+void ShaderCache::prefetch(const char* vShSrc, const char* fShSrc, const Shader::Attributes& attributes) {
+    const std::string key = makeKey(vShSrc, fShSrc, attributes);
+
+    auto iter = programs.find(key);
+    if (iter != programs.end() && !iter->second.expired()) {
+        return; // in use or prefetched already
+    }
+
+    auto shader = std::make_shared<Shader>();
+    shader->submit(vShSrc, fShSrc, attributes);
+
+    if (shader->getProgramId() > 0) {
+        programs[key] = shader;
+        prefetched.push_back(shader);
+        missCount++;
+    }
+}
+
+void ShaderCache::releasePrefetched() {
+    prefetched.clear();
+}
+
+std::size_t ShaderCache::size() {
+    std::size_t count = 0;
+    for (auto iter = programs.begin(); iter != programs.end();) {
+        if (iter->second.expired()) {
+            iter = programs.erase(iter);
+        } else {
+            ++count;
+            ++iter;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,95 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+/**
+ * Process-wide shader program cache.
+ */
+#ifndef OGLES_GPGPU_COMMON_GL_SHADER_CACHE
+#define OGLES_GPGPU_COMMON_GL_SHADER_CACHE
+
+#include "../common_includes.h"
+
+#include "shader.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ogles_gpgpu {
+
+/**
+ * Reference counted cache of linked shader programs. Processors with equal vertex and
+ * fragment shader sources and attribute bindings share one program,
+ * which is deleted when the last user releases it. Uniform values are part of the
+ * program state, so users must set all of their uniforms before each draw (as
+ * FilterProcBase::render() does via setUniforms()). Uniform::set() skips values the
+ * program holds already.
+ *
+ * Programs are shared by all processors of the process, so all of them must be used
+ * with the same OpenGL context (or contexts of one share group).
+ *
+ * prefetch() submits programs ahead of time without waiting for the driver, so that
+ * several programs can be compiled in parallel. The status of a prefetched program is
+ * checked when it is acquired.
+ */
+class ShaderCache {
+public:
+    /**
+     * Get a program for the sources <vShSrc> and <fShSrc> and <attributes>. Compiles and
+     * links the program if it is not in use already.
+     */
+    static std::shared_ptr<Shader> acquire(const char* vShSrc, const char* fShSrc, const Shader::Attributes& attributes = {});
+
+    /**
+     * Submit a program for the given sources and attributes (see acquire()) if it
+     * is not in use already. The cache keeps the program until releasePrefetched().
+     */
+    static void prefetch(const char* vShSrc, const char* fShSrc, const Shader::Attributes& attributes = {});
+
+    /**
+     * Release all prefetched programs that were not acquired.
+     */
+    static void releasePrefetched();
+
+    /**
+     * Get the number of programs currently in use.
+     */
+    static std::size_t size();
+
+    /**
+     * Get the number of acquire() calls that were served by a shared program.
+     */
+    static unsigned int getHitCount() {
+        return hitCount;
+    }
+
+    /**
+     * Get the number of acquire() calls that built a new program.
+     */
+    static unsigned int getMissCount() {
+        return missCount;
+    }
+
+    /**
+     * Reset hit and miss counts.
+     */
+    static void resetCounts() {
+        hitCount = missCount = 0;
+    }
+
+private:
+    static std::string makeKey(const char* vShSrc, const char* fShSrc, const Shader::Attributes& attributes);
+
+    static std::map<std::string, std::weak_ptr<Shader>> programs;
+    static std::vector<std::shared_ptr<Shader>> prefetched; // strong refs. until acquired
+
+    static unsigned int hitCount;
+    static unsigned int missCount;
+};
+}
+
+#endif
@@ -0,0 +1,335 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+#include "shader_cost.h"
+
+#include <cctype>
+#include <cstring>
+#include <map>
+#include <set>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+using namespace ogles_gpgpu;
+
+typedef std::vector<std::string> Tokens;
+
+struct Macro {
+    bool function = false; // function-like: NAME(a, b)
+    Tokens params;
+    Tokens body;
+};
+
+typedef std::map<std::string, Macro> Macros;
+
+static const int kMaxExpansionDepth = 16;
+
+// longest first
+static const char* kOperators[] = {
+    "<<=", ">>=", "++", "--", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=",
+    "==", "!=", "<=", ">=", "&&", "||", "^^", "<<", ">>"
+};
+
+static const std::set<std::string> kBinaryOperators = {
+    "+", "-", "*", "/", "%", "<", ">", "<=", ">=", "==", "!=", "&&", "||", "^^", "&", "|", "^", "<<", ">>"
+};
+
+static const std::set<std::string> kUpdateOperators = {
+    "++", "--", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "<<=", ">>=", "?", "!", "~"
+};
+
+static const std::set<std::string> kTranscendentals = {
+    "exp", "exp2", "log", "log2", "pow", "sqrt", "inversesqrt", "sin", "cos", "tan", "asin", "acos", "atan",
+    "sinh", "cosh", "tanh", "asinh", "acosh", "atanh", "length", "distance", "normalize"
+};
+
+static const std::set<std::string> kBuiltins = {
+    "radians", "degrees", "abs", "sign", "floor", "ceil", "fract", "trunc", "round", "roundEven", "mod", "modf",
+    "min", "max", "clamp", "mix", "step", "smoothstep", "dot", "cross", "reflect", "refract", "faceforward",
+    "matrixCompMult", "lessThan", "lessThanEqual", "greaterThan", "greaterThanEqual", "equal", "notEqual",
+    "any", "all", "not", "dFdx", "dFdy", "fwidth"
+};
+
+static bool isIdentifier(const std::string& token) {
+    return !token.empty() && (std::isalpha(static_cast<unsigned char>(token[0])) || token[0] == '_');
+}
+
+static bool isNumber(const std::string& token) {
+    return !token.empty() && (std::isdigit(static_cast<unsigned char>(token[0])) || (token[0] == '.' && token.size() > 1));
+}
+
+static bool isLookup(const std::string& name) {
+    const bool lookup = (name.compare(0, 7, "texture") == 0 || name.compare(0, 10, "texelFetch") == 0 || name == "imageLoad");
+    const bool query = (name == "textureSize" || name.compare(0, 12, "textureQuery") == 0);
+    return lookup && !query;
+}
+
+static void tokenize(const std::string& src, Tokens& tokens) {
+    std::size_t i = 0;
+    while (i < src.size()) {
+        const unsigned char c = src[i];
+        if (std::isspace(c)) {
+            i++;
+            continue;
+        }
+
+        std::size_t end = i + 1;
+        if (std::isalpha(c) || c == '_') {
+            while (end < src.size() && (std::isalnum(static_cast<unsigned char>(src[end])) || src[end] == '_')) {
+                end++;
+            }
+        } else if (std::isdigit(c) || (c == '.' && i + 1 < src.size() && std::isdigit(static_cast<unsigned char>(src[i + 1])))) {
+            // 1, 1.0, .5, 1e-3, 0x1F, 1u
+            while (end < src.size() && (std::isalnum(static_cast<unsigned char>(src[end])) || src[end] == '.' || ((src[end] == '-' || src[end] == '+') && (src[end - 1] == 'e' || src[end - 1] == 'E')))) {
+                end++;
+            }
+        } else {
+            for (const char* op : kOperators) {
+                const std::size_t len = std::strlen(op);
+                if (src.compare(i, len, op) == 0) {
+                    end = i + len;
+                    break;
+                }
+            }
+        }
+
+        tokens.push_back(src.substr(i, end - i));
+        i = end;
+    }
+}
+
+// Replace the comments of <src> by spaces and join continued lines
+static std::string stripComments(const std::string& src) {
+    std::string out;
+    out.reserve(src.size());
+    std::size_t i = 0;
+    while (i < src.size()) {
+        if (src.compare(i, 2, "//") == 0) {
+            i = src.find('\n', i);
+            i = (i == std::string::npos) ? src.size() : i;
+        } else if (src.compare(i, 2, "/*") == 0) {
+            i = src.find("*/", i + 2);
+            i = (i == std::string::npos) ? src.size() : i + 2;
+            out += ' ';
+        } else if (src.compare(i, 2, "\\\n") == 0) {
+            i += 2;
+        } else {
+            out += src[i++];
+        }
+    }
+    return out;
+}
+
+// Parse a "#define" line <line> (without the '#') into <macros>
+static void parseDefine(const std::string& line, Macros& macros) {
+    std::size_t i = line.find_first_not_of(" \t", line.find("define") + 6);
+    std::size_t end = i;
+    while (end < line.size() && (std::isalnum(static_cast<unsigned char>(line[end])) || line[end] == '_')) {
+        end++;
+    }
+    if (i == std::string::npos || end == i) {
+        return;
+    }
+
+    Macro& macro = macros[line.substr(i, end - i)];
+    if (end < line.size() && line[end] == '(') { // no space before '(' for a function-like macro
+        const std::size_t close = line.find(')', end);
+        if (close == std::string::npos) {
+            return;
+        }
+        Tokens params;
+        tokenize(line.substr(end + 1, close - end - 1), params);
+        for (const std::string& param : params) {
+            if (param != ",") {
+                macro.params.push_back(param);
+            }
+        }
+        macro.function = true;
+        end = close + 1;
+    }
+    tokenize(line.substr(end), macro.body);
+}
+
+static void expand(const Tokens& in, const Macros& macros, Tokens& out, int depth) {
+    for (std::size_t i = 0; i < in.size(); i++) {
+        const auto macro = macros.find(in[i]);
+        if (macro == macros.end() || depth >= kMaxExpansionDepth) {
+            out.push_back(in[i]);
+            continue;
+        }
+
+        if (!macro->second.function) {
+            expand(macro->second.body, macros, out, depth + 1);
+            continue;
+        }
+        if (i + 1 == in.size() || in[i + 1] != "(") {
+            out.push_back(in[i]); // name of a function-like macro without arguments
+            continue;
+        }
+
+        // split the arguments at the commas outside of parentheses
+        std::vector<Tokens> args(1);
+        std::size_t j = i + 2;
+        for (int level = 0; j < in.size(); j++) {
+            if (in[j] == ")" && level == 0) {
+                break;
+            } else if (in[j] == "," && level == 0) {
+                args.emplace_back();
+                continue;
+            }
+            level += (in[j] == "(") - (in[j] == ")");
+            args.back().push_back(in[j]);
+        }
+        i = j;
+
+        Tokens body;
+        const Tokens& params = macro->second.params;
+        for (const std::string& token : macro->second.body) {
+            std::size_t k = 0;
+            while (k < params.size() && params[k] != token) {
+                k++;
+            }
+            if (k < params.size() && k < args.size()) {
+                body.insert(body.end(), args[k].begin(), args[k].end());
+            } else {
+                body.push_back(token);
+            }
+        }
+        expand(body, macros, out, depth + 1);
+    }
+}
+
+// Tokenize <src> with the "#define" macros expanded and the other directives removed
+static Tokens preprocess(const std::string& src) {
+    Macros macros;
+    Tokens tokens;
+
+    std::stringstream lines(stripComments(src));
+    std::string line;
+    while (std::getline(lines, line)) {
+        const std::size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos) {
+            continue;
+        }
+        if (line[start] == '#') {
+            const std::size_t directive = line.find_first_not_of(" \t", start + 1);
+            if (directive != std::string::npos && line.compare(directive, 6, "define") == 0) {
+                parseDefine(line.substr(directive), macros);
+            }
+            continue;
+        }
+        Tokens lineTokens;
+        tokenize(line, lineTokens);
+        expand(lineTokens, macros, tokens, 0);
+    }
+    return tokens;
+}
+
+// ALU ops in the function bodies of <tokens>
+static int countAluOps(const Tokens& tokens) {
+    int ops = 0;
+    int depth = 0;
+    for (std::size_t i = 0; i < tokens.size(); i++) {
+        const std::string& token = tokens[i];
+        depth += (token == "{") - (token == "}");
+        if (depth == 0) {
+            continue;
+        }
+
+        if (kBinaryOperators.count(token)) {
+            // sign of an operand, a free source modifier
+            const std::string prev = i ? tokens[i - 1] : std::string();
+            const bool operand = (isIdentifier(prev) && prev != "return") || isNumber(prev) || prev == ")" || prev == "]";
+            ops += (operand || (token != "-" && token != "+")) ? 1 : 0;
+        } else if (kUpdateOperators.count(token)) {
+            ops++;
+        } else if (i + 1 < tokens.size() && tokens[i + 1] == "(") {
+            // constructors, lookups and own functions are free, their bodies are counted
+            ops += kTranscendentals.count(token) ? ShaderCost::kTranscendentalWeight : int(kBuiltins.count(token));
+        }
+    }
+    return ops;
+}
+
+// Is the lookup coordinate <coord> a varying, i.e. "uv", "uv.xy" or "uv[2]"?
+static bool isVarying(const Tokens& coord, const std::set<std::string>& varyings) {
+    if (coord.empty() || !varyings.count(coord[0])) {
+        return false;
+    }
+    std::size_t k = 1;
+    if (k + 2 < coord.size() && coord[k] == "[" && isNumber(coord[k + 1]) && coord[k + 2] == "]") {
+        k += 3;
+    }
+    if (k + 1 < coord.size() && coord[k] == "." && isIdentifier(coord[k + 1])) {
+        k += 2;
+    }
+    return k == coord.size();
+}
+
+ShaderCost ShaderCost::analyze(const std::string& vshSrc, const std::string& fshSrc) {
+    ShaderCost cost;
+    cost.vertexAluOps = countAluOps(preprocess(vshSrc));
+
+    const Tokens tokens = preprocess(fshSrc);
+    cost.aluOps = countAluOps(tokens);
+
+    std::set<std::string> declared, used;
+    int depth = 0, level = 0;
+    for (std::size_t i = 0; i < tokens.size(); i++) {
+        const std::string& token = tokens[i];
+        depth += (token == "{") - (token == "}");
+        level += (token == "(") - (token == ")");
+
+        if (depth == 0) {
+            if (token == "precision" && i + 2 < tokens.size() && tokens[i + 2] == "float" && cost.precision.empty()) {
+                cost.precision = tokens[i + 1];
+            } else if (level == 0 && (token == "varying" || token == "in")) {
+                // "varying highp vec2 a, b[4];": the names are followed by ';', ',' or '['
+                for (i++; i < tokens.size() && tokens[i] != ";"; i++) {
+                    const std::string next = (i + 1 < tokens.size()) ? tokens[i + 1] : std::string();
+                    if (isIdentifier(tokens[i]) && (next == ";" || next == "," || next == "[")) {
+                        declared.insert(tokens[i]);
+                    }
+                }
+            }
+            continue;
+        }
+
+        if (declared.count(token)) {
+            used.insert(token);
+        }
+
+        if (isLookup(token) && i + 1 < tokens.size() && tokens[i + 1] == "(") {
+            cost.textureFetches++;
+
+            // the coordinate is the second argument
+            Tokens coord;
+            int arg = 0, l = 0;
+            for (std::size_t j = i + 2; j < tokens.size() && arg < 2; j++) {
+                if (l == 0 && (tokens[j] == "," || tokens[j] == ")")) {
+                    arg += (tokens[j] == ",") ? 1 : 2; // ')' ends the arguments
+                    continue;
+                }
+                l += (tokens[j] == "(") - (tokens[j] == ")");
+                if (arg == 1) {
+                    coord.push_back(tokens[j]);
+                }
+            }
+            cost.dependentReads += isVarying(coord, declared) ? 0 : 1;
+        }
+    }
+    cost.varyings = static_cast<int>(used.size());
+
+    return cost;
+}
+
+std::string ShaderCost::toString() const {
+    std::stringstream ss;
+    ss << "fetches=" << textureFetches << " dependent=" << dependentReads << " alu=" << aluOps;
+    ss << " vertex_alu=" << vertexAluOps << " varyings=" << varyings << " precision=" << (precision.empty() ? "-" : precision);
+    return ss.str();
+}
@@ -0,0 +1,61 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+/**
+ * Static shader cost analysis.
+ */
+#ifndef OGLES_GPGPU_COMMON_GL_SHADER_COST
+#define OGLES_GPGPU_COMMON_GL_SHADER_COST
+
+#include "../common_includes.h"
+
+#include <string>
+
+namespace ogles_gpgpu {
+
+/**
+ * Cost of a shader program estimated from its GLSL sources, i.e. to compare processor
+ * variants (GaussProc, GaussOptProc, BoxOptProc, ...) before profiling them on a device.
+ *
+ * The counts are static: a statement in a loop counts once and both sides of a branch
+ * count as taken. "#define" macros are expanded, but the other directives are dropped
+ * without evaluation, so the code of both sides of an "#if" / "#else" counts.
+ */
+struct ShaderCost {
+    static const int kFetchWeight = 4; // ALU ops per texture fetch
+    static const int kDependentReadWeight = 4; // additional ALU ops per dependent read
+    static const int kTranscendentalWeight = 4; // ALU ops per exp(), pow(), sqrt(), sin(), ...
+
+    int textureFetches = 0; // texture lookups per fragment (texture2D(), texture(), texelFetch(), imageLoad(), ...)
+    int dependentReads = 0; // lookups with coordinates computed in the fragment shader, not a varying
+    int aluOps = 0; // arithmetic and comparison operators and built-in function calls per fragment
+    int vertexAluOps = 0; // the same per vertex
+    int varyings = 0; // varyings read by the fragment shader (an array counts once)
+    std::string precision; // default float precision of the fragment shader, empty if none (desktop OpenGL)
+
+    /**
+     * Analyze the vertex shader source <vshSrc> and the fragment shader source <fshSrc>.
+     * A compute shader can be passed as <fshSrc>, its invocations count as fragments.
+     */
+    static ShaderCost analyze(const std::string& vshSrc, const std::string& fshSrc);
+
+    /**
+     * Get the estimated cost of one fragment in ALU ops, with a texture fetch and a
+     * dependent read weighted as kFetchWeight and kDependentReadWeight ALU ops. The
+     * vertex shader runs for four vertices per pass and is not included.
+     */
+    double getCostPerPixel() const {
+        return aluOps + textureFetches * kFetchWeight + dependentReads * kDependentReadWeight;
+    }
+
+    /**
+     * Format as "fetches=9 dependent=0 alu=12 vertex_alu=18 varyings=5 precision=highp".
+     */
+    std::string toString() const;
+};
+}
+
+#endif
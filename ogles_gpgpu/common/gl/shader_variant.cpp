@@ -0,0 +1,28 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+#include "shader_variant.h"
+
+using namespace std;
+using namespace ogles_gpgpu;
+
+ShaderVariants::Registrar::Registrar(const ShaderVariant* variants, std::size_t count) {
+    getRegistry().insert(getRegistry().end(), variants, variants + count);
+}
+
+std::vector<ShaderVariant>& ShaderVariants::getRegistry() {
+    static std::vector<ShaderVariant> registry; // constructed on first use (static initialization order)
+    return registry;
+}
+
+const ShaderVariant* ShaderVariants::find(const std::string& family, const std::string& name) {
+    for (const auto& variant : getRegistry()) {
+        if (family == variant.family && name == variant.name) {
+            return &variant;
+        }
+    }
+    return nullptr;
+}
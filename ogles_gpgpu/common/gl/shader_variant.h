@@ -0,0 +1,82 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+/**
+ * Compile time shader variants.
+ */
+#ifndef OGLES_GPGPU_COMMON_GL_SHADER_VARIANT
+#define OGLES_GPGPU_COMMON_GL_SHADER_VARIANT
+
+#include "../common_includes.h"
+
+#include <string>
+#include <vector>
+
+// A shader variant is one GLSL source, specialized by GLSL preprocessor definitions that
+// are prepended as string literals, so that all variants are string constants built by
+// the compiler (i.e. OG_GLSL_DEFINE(OG_CHANNEL, g) OG_GLSL_PRECISION(highp) body):
+
+// "#define <name> <value>" line
+#define OG_GLSL_DEFINE(name, value) "#define " #name " " #value "\n"
+
+// default float precision line (OpenGL ES only)
+#if defined(OGLES_GPGPU_OPENGLES)
+#define OG_GLSL_PRECISION(precision) "precision " #precision " float;\n"
+#else
+#define OG_GLSL_PRECISION(precision) ""
+#endif
+
+// GLSL ES 3.00 (OpenGL ES 3.0) / GLSL 3.30 (OpenGL 3.3) version line, must come first
+// (see GLCaps::glsl3Shaders)
+#if defined(OGLES_GPGPU_OPENGLES)
+#define OG_GLSL3_VERSION "#version 300 es\n"
+#else
+#define OG_GLSL3_VERSION "#version 330\n"
+#endif
+
+namespace ogles_gpgpu {
+
+/**
+ * Shader variant of a processor (see ShaderVariants).
+ */
+struct ShaderVariant {
+    const char* family; // i.e. the processor name
+    const char* name; // specialization, i.e. "r" for a red channel variant
+    const char* vshSrc; // vertex shader source (nullptr: processor default)
+    const char* fshSrc; // fragment shader source
+};
+
+/**
+ * Registry of all shader variants that exist, i.e. to list or prefetch them.
+ * Processors register their variants with a static ShaderVariants::Registrar.
+ */
+class ShaderVariants {
+public:
+    /**
+     * Registers <count> variants at <variants> during static initialization.
+     */
+    struct Registrar {
+        Registrar(const ShaderVariant* variants, std::size_t count);
+    };
+
+    /**
+     * Get all registered variants.
+     */
+    static const std::vector<ShaderVariant>& getAll() {
+        return getRegistry();
+    }
+
+    /**
+     * Find the variant <name> of <family>, or return nullptr.
+     */
+    static const ShaderVariant* find(const std::string& family, const std::string& name);
+
+private:
+    static std::vector<ShaderVariant>& getRegistry();
+};
+}
+
+#endif
@@ -13,15 +13,32 @@ include(sugar_files)
 
 sugar_files(
     OGLES_GPGPU_SRCS
+    call_counters.cpp
+    call_counters.h
+    caps.cpp
+    caps.h
     fbo.cpp
     fbo.h
+    memory_usage.cpp
+    memory_usage.h
     memtransfer.cpp
     memtransfer.h
     memtransfer_factory.cpp
     memtransfer_factory.h
     memtransfer_optimized.h
+    program_cache.cpp
+    program_cache.h
     shader.cpp
     shader.h
+    shader_cache.cpp
+    shader_cache.h
+    shader_cost.cpp
+    shader_cost.h
+    shader_variant.cpp
+    shader_variant.h
+    timer_query.cpp
+    timer_query.h
+    uniform.h
 )
 
 if (OGLES_GPGPU_OPENGL_ES3)
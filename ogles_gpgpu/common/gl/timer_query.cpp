@@ -0,0 +1,242 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+#include "timer_query.h"
+#include "caps.h"
+
+// clang-format off
+#if defined(OGLES_GPGPU_OPENGL) && defined(GL_VERSION_3_3) && !defined(__APPLE__)
+#  define OGLES_GPGPU_TIME_ELAPSED GL_TIME_ELAPSED
+#  define OGLES_GPGPU_QUERY_RESULT GL_QUERY_RESULT
+#  define OGLES_GPGPU_QUERY_RESULT_AVAILABLE GL_QUERY_RESULT_AVAILABLE
+#  define OGLES_GPGPU_GEN_QUERIES glGenQueries
+#  define OGLES_GPGPU_DELETE_QUERIES glDeleteQueries
+#  define OGLES_GPGPU_BEGIN_QUERY glBeginQuery
+#  define OGLES_GPGPU_END_QUERY glEndQuery
+#  define OGLES_GPGPU_GET_QUERY_OBJECT_UIV glGetQueryObjectuiv
+#  define OGLES_GPGPU_GET_QUERY_OBJECT_UI64V glGetQueryObjectui64v
+#  define OGLES_GPGPU_TIMESTAMP GL_TIMESTAMP
+#  define OGLES_GPGPU_QUERY_COUNTER glQueryCounter
+#  define OGLES_GPGPU_GET_INTEGER64V glGetInteger64v
+#elif defined(OGLES_GPGPU_ANDROID) && defined(GL_EXT_disjoint_timer_query)
+#  include <EGL/egl.h>
+#  define OGLES_GPGPU_TIMER_QUERY_PROCS 1 // loaded by GPUTimer::loadFunctions()
+#  define OGLES_GPGPU_TIME_ELAPSED GL_TIME_ELAPSED_EXT
+#  define OGLES_GPGPU_QUERY_RESULT GL_QUERY_RESULT_EXT
+#  define OGLES_GPGPU_QUERY_RESULT_AVAILABLE GL_QUERY_RESULT_AVAILABLE_EXT
+#  define OGLES_GPGPU_GEN_QUERIES procs.genQueries
+#  define OGLES_GPGPU_DELETE_QUERIES procs.deleteQueries
+#  define OGLES_GPGPU_BEGIN_QUERY procs.beginQuery
+#  define OGLES_GPGPU_END_QUERY procs.endQuery
+#  define OGLES_GPGPU_GET_QUERY_OBJECT_UIV procs.getQueryObjectuiv
+#  define OGLES_GPGPU_GET_QUERY_OBJECT_UI64V procs.getQueryObjectui64v
+#  define OGLES_GPGPU_TIMESTAMP GL_TIMESTAMP_EXT
+#  define OGLES_GPGPU_QUERY_COUNTER procs.queryCounter
+#  define OGLES_GPGPU_GET_INTEGER64V procs.getInteger64v
+#  define OGLES_GPGPU_GPU_DISJOINT GL_GPU_DISJOINT_EXT
+#endif
+// clang-format on
+
+using namespace std;
+using namespace ogles_gpgpu;
+
+#if defined(OGLES_GPGPU_TIMER_QUERY_PROCS)
+// the EXT_disjoint_timer_query entry points are not exported by libGLESv2
+static struct {
+    PFNGLGENQUERIESEXTPROC genQueries;
+    PFNGLDELETEQUERIESEXTPROC deleteQueries;
+    PFNGLBEGINQUERYEXTPROC beginQuery;
+    PFNGLENDQUERYEXTPROC endQuery;
+    PFNGLGETQUERYOBJECTUIVEXTPROC getQueryObjectuiv;
+    PFNGLGETQUERYOBJECTUI64VEXTPROC getQueryObjectui64v;
+    PFNGLQUERYCOUNTEREXTPROC queryCounter;
+    PFNGLGETINTEGER64VEXTPROC getInteger64v;
+} procs;
+
+template <typename T>
+static bool loadProc(T& proc, const char* name) {
+    proc = reinterpret_cast<T>(eglGetProcAddress(name));
+    return proc != nullptr;
+}
+#endif
+
+const std::size_t GPUTimer::kMaxPending;
+
+bool GPUTimer::active = false;
+unsigned int GPUTimer::disjointGeneration = 0;
+
+GPUTimer::~GPUTimer() {
+#if defined(OGLES_GPGPU_TIME_ELAPSED)
+    pool.insert(pool.end(), pending.begin(), pending.end());
+    if (running) {
+        pool.push_back(running);
+        active = false;
+    }
+
+    if (!pool.empty()) {
+        OGLES_GPGPU_DELETE_QUERIES(static_cast<GLsizei>(pool.size()), pool.data());
+    }
+#endif
+}
+
+bool GPUTimer::loadFunctions() {
+#if defined(OGLES_GPGPU_TIMER_QUERY_PROCS)
+    bool loaded = loadProc(procs.genQueries, "glGenQueriesEXT");
+    loaded = loadProc(procs.deleteQueries, "glDeleteQueriesEXT") && loaded;
+    loaded = loadProc(procs.beginQuery, "glBeginQueryEXT") && loaded;
+    loaded = loadProc(procs.endQuery, "glEndQueryEXT") && loaded;
+    loaded = loadProc(procs.getQueryObjectuiv, "glGetQueryObjectuivEXT") && loaded;
+    loaded = loadProc(procs.getQueryObjectui64v, "glGetQueryObjectui64vEXT") && loaded;
+    loaded = loadProc(procs.queryCounter, "glQueryCounterEXT") && loaded;
+    loaded = loadProc(procs.getInteger64v, "glGetInteger64vEXT") && loaded;
+    return loaded;
+#else
+    return true;
+#endif
+}
+
+bool GPUTimer::isSupported() {
+#if defined(OGLES_GPGPU_TIME_ELAPSED)
+    return GLCaps::get().timerQueries;
+#else
+    return false;
+#endif
+}
+
+bool GPUTimer::begin() {
+    assert(!running);
+
+#if defined(OGLES_GPGPU_TIME_ELAPSED)
+    if (active || (pending.size() >= kMaxPending) || !isSupported()) {
+        return false;
+    }
+
+    if (pool.empty()) {
+        GLuint query = 0;
+        OGLES_GPGPU_GEN_QUERIES(1, &query);
+        pool.push_back(query);
+    }
+
+    running = pool.back();
+    pool.pop_back();
+
+    OGLES_GPGPU_BEGIN_QUERY(OGLES_GPGPU_TIME_ELAPSED, running);
+    Tools::checkGLErr("GPUTimer", "begin query");
+
+    active = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void GPUTimer::end() {
+    assert(running);
+
+#if defined(OGLES_GPGPU_TIME_ELAPSED)
+    OGLES_GPGPU_END_QUERY(OGLES_GPGPU_TIME_ELAPSED);
+    Tools::checkGLErr("GPUTimer", "end query");
+
+    pending.push_back(running);
+    running = 0;
+    active = false;
+#endif
+}
+
+void GPUTimer::collect(TimingStats& stats) {
+#if defined(OGLES_GPGPU_TIME_ELAPSED)
+#if defined(OGLES_GPGPU_GPU_DISJOINT)
+    // a disjoint operation (i.e. a frequency change) invalidates all results in flight,
+    // also those of the other timers, which will not see the flag again
+    GLint disjoint = 0;
+    glGetIntegerv(OGLES_GPGPU_GPU_DISJOINT, &disjoint);
+    if (disjoint) {
+        disjointGeneration++;
+    }
+#endif
+
+    if (generation != disjointGeneration) {
+        pool.insert(pool.end(), pending.begin(), pending.end());
+        pending.clear();
+        generation = disjointGeneration;
+        return;
+    }
+
+    // results become available in submission order
+    while (!pending.empty()) {
+        GLuint available = 0;
+        OGLES_GPGPU_GET_QUERY_OBJECT_UIV(pending.front(), OGLES_GPGPU_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            break;
+        }
+
+        GLuint64 ns = 0;
+        OGLES_GPGPU_GET_QUERY_OBJECT_UI64V(pending.front(), OGLES_GPGPU_QUERY_RESULT, &ns);
+        stats.add(static_cast<double>(ns) / 1.0e6);
+
+        pool.push_back(pending.front());
+        pending.pop_front();
+    }
+#endif
+}
+
+// ########## GPUTimestamp
+
+bool GPUTimestamp::isSupported() {
+    return GPUTimer::isSupported();
+}
+
+std::int64_t GPUTimestamp::getCurrent() {
+#if defined(OGLES_GPGPU_TIMESTAMP)
+    GLint64 ns = 0;
+    if (isSupported()) {
+        OGLES_GPGPU_GET_INTEGER64V(OGLES_GPGPU_TIMESTAMP, &ns);
+    }
+    return ns;
+#else
+    return 0;
+#endif
+}
+
+GLuint GPUTimestamp::create() {
+    GLuint query = 0;
+#if defined(OGLES_GPGPU_TIMESTAMP)
+    OGLES_GPGPU_GEN_QUERIES(1, &query);
+#endif
+    return query;
+}
+
+void GPUTimestamp::destroy(GLuint query) {
+#if defined(OGLES_GPGPU_TIMESTAMP)
+    OGLES_GPGPU_DELETE_QUERIES(1, &query);
+#endif
+}
+
+void GPUTimestamp::record(GLuint query) {
+#if defined(OGLES_GPGPU_TIMESTAMP)
+    OGLES_GPGPU_QUERY_COUNTER(query, OGLES_GPGPU_TIMESTAMP);
+    Tools::checkGLErr("GPUTimestamp", "query counter");
+#endif
+}
+
+bool GPUTimestamp::getResult(GLuint query, std::int64_t& ns, bool wait) {
+#if defined(OGLES_GPGPU_TIMESTAMP)
+    if (!wait) {
+        GLuint available = 0;
+        OGLES_GPGPU_GET_QUERY_OBJECT_UIV(query, OGLES_GPGPU_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            return false;
+        }
+    }
+
+    GLuint64 result = 0;
+    OGLES_GPGPU_GET_QUERY_OBJECT_UI64V(query, OGLES_GPGPU_QUERY_RESULT, &result);
+    ns = static_cast<std::int64_t>(result);
+    return true;
+#else
+    return false;
+#endif
+}
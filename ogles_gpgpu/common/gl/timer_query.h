@@ -0,0 +1,114 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+/**
+ * GPU timer queries.
+ */
+#ifndef OGLES_GPGPU_COMMON_GL_TIMER_QUERY
+#define OGLES_GPGPU_COMMON_GL_TIMER_QUERY
+
+#include "../common_includes.h"
+#include "../stats.h"
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace ogles_gpgpu {
+
+/**
+ * Measures the GPU time of a sequence of OpenGL commands with GL_TIME_ELAPSED queries
+ * (OpenGL 3.3 / EXT_disjoint_timer_query on OpenGL ES).
+ *
+ * Each begin() / end() pair takes a query object from a pool. The results are read back
+ * by collect() only once they are available, i.e. a few frames late, so that timing never
+ * stalls the pipeline.
+ */
+class GPUTimer {
+public:
+    static const std::size_t kMaxPending = 8; // measurements in flight before begin() skips a frame
+
+    /**
+     * Deletes the query objects (needs the OpenGL context that created them).
+     */
+    ~GPUTimer();
+
+    /**
+     * Check if timer queries are compiled in and supported by the current context.
+     */
+    static bool isSupported();
+
+    /**
+     * Load the entry points of the timer queries where they are not linked (the
+     * EXT_disjoint_timer_query functions on Android). GLCaps calls this when the context
+     * has the extension. Returns false if one is missing.
+     */
+    static bool loadFunctions();
+
+    /**
+     * Start a measurement. Returns false (and end() must not be called) if timer queries
+     * are not supported, too many results are pending or another measurement is running,
+     * since time elapsed queries cannot be nested.
+     */
+    bool begin();
+
+    /**
+     * End the measurement that was started by begin().
+     */
+    void end();
+
+    /**
+     * Add all available results to <stats> in milliseconds, without blocking.
+     */
+    void collect(TimingStats& stats);
+
+private:
+    std::vector<GLuint> pool; // free query objects
+    std::deque<GLuint> pending; // ended queries, oldest first
+    GLuint running = 0;
+    unsigned int generation = disjointGeneration; // disjoint operations seen by collect()
+
+    static bool active; // a query of any timer is running
+    static unsigned int disjointGeneration; // disjoint operations seen by any timer (reading the flag clears it)
+};
+
+/**
+ * GPU timestamps with GL_TIMESTAMP queries (same availability as GPUTimer), i.e. to place
+ * the GPU work on a CPU timeline. All times are in ns of the GPU clock.
+ */
+class GPUTimestamp {
+public:
+    /**
+     * Check if timestamp queries are compiled in and supported by the current context.
+     */
+    static bool isSupported();
+
+    /**
+     * Get the current GPU time (when all previous commands have reached the GPU, not when
+     * they are finished). Returns 0 if not supported.
+     */
+    static std::int64_t getCurrent();
+
+    /**
+     * Create / delete a query object for record().
+     */
+    static GLuint create();
+    static void destroy(GLuint query);
+
+    /**
+     * Record the time at which the GPU has finished all previous commands into <query>.
+     */
+    static void record(GLuint query);
+
+    /**
+     * Get the result of <query> into <ns>. Returns false if it is not available yet,
+     * unless <wait> is set.
+     */
+    static bool getResult(GLuint query, std::int64_t& ns, bool wait);
+};
+}
+
+#endif
@@ -0,0 +1,117 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+/**
+ * Typed shader uniforms.
+ */
+#ifndef OGLES_GPGPU_COMMON_GL_UNIFORM
+#define OGLES_GPGPU_COMMON_GL_UNIFORM
+
+#include "../common_includes.h"
+
+#include "call_counters.h"
+#include "shader.h"
+
+#include <cstring>
+
+namespace ogles_gpgpu {
+
+/**
+ * glUniform*() call for uniform type T.
+ */
+template <typename T>
+struct UniformTraits;
+
+template <>
+struct UniformTraits<GLint> {
+    static void upload(GLint location, const GLint& value) {
+        glUniform1i(location, value);
+    }
+};
+
+template <>
+struct UniformTraits<GLfloat> {
+    static void upload(GLint location, const GLfloat& value) {
+        glUniform1f(location, value);
+    }
+};
+
+template <>
+struct UniformTraits<Vec2f> {
+    static void upload(GLint location, const Vec2f& value) {
+        glUniform2fv(location, 1, value.data);
+    }
+};
+
+template <>
+struct UniformTraits<Vec3f> {
+    static void upload(GLint location, const Vec3f& value) {
+        glUniform3fv(location, 1, value.data);
+    }
+};
+
+template <>
+struct UniformTraits<Mat33f> {
+    static void upload(GLint location, const Mat33f& value) {
+        glUniformMatrix3fv(location, 1, GL_FALSE, &value.data[0][0]);
+    }
+};
+
+template <>
+struct UniformTraits<Mat44f> {
+    static void upload(GLint location, const Mat44f& value) {
+        glUniformMatrix4fv(location, 1, GL_FALSE, &value.data[0][0]);
+    }
+};
+
+/**
+ * Shader uniform of type T with a cached location. The last uploaded value is kept
+ * with the program (see Shader::getUniformValue()), so that set() only calls glUniform*()
+ * if the value changed, also if the program is shared by several processors (see ShaderCache).
+ */
+template <typename T>
+class Uniform {
+public:
+    /**
+     * Look up the uniform <name> of program <shader>. Must be called again if the
+     * program changes.
+     */
+    void init(Shader* shader, const char* name) {
+        location = shader->getParam(UNIF, name);
+        current = shader->getUniformValue(location);
+    }
+
+    /**
+     * Upload <value>, if it differs from the current value. The program must be in use.
+     */
+    void set(const T& value) {
+        static_assert(sizeof(T) <= sizeof(Shader::UniformValue::data), "unsupported uniform type");
+
+        if (!current || (current->size == sizeof(T) && memcmp(current->data, &value, sizeof(T)) == 0)) {
+            return; // inactive uniform or unchanged value
+        }
+
+        UniformTraits<T>::upload(location, value);
+        OG_GL_COUNT(uniformUploads);
+
+        memcpy(current->data, &value, sizeof(T));
+        current->size = sizeof(T);
+    }
+
+    /**
+     * Get the uniform location (-1 if the program has no active uniform of that name).
+     */
+    GLint getLocation() const {
+        return location;
+    }
+
+private:
+    GLint location = -1;
+    Shader::UniformValue* current = nullptr; // value store of the program
+};
+}
+
+#endif
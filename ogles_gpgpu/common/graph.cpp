@@ -0,0 +1,231 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+#include "graph.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+using namespace ogles_gpgpu;
+
+static const char* kEdgeTypeNames[] = { "subscriber", "delayed", "pass" };
+
+// Write <str> as a quoted JSON or DOT string (a line break is "\n" in both)
+static void writeString(std::ostream& os, const std::string& str) {
+    os << '"';
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            os << '\\' << c;
+        } else if (c == '\n') {
+            os << "\\n";
+        } else if (static_cast<unsigned char>(c) >= 0x20) {
+            os << c;
+        }
+    }
+    os << '"';
+}
+
+// Format <value> with a K, M or G suffix, i.e. "1.2M"
+static std::string formatCount(double value) {
+    static const char* units[] = { "", "K", "M", "G" };
+    int unit = 0;
+    while (value >= 1000.0 && unit < 3) {
+        value /= 1000.0;
+        unit++;
+    }
+
+    std::stringstream ss;
+    ss << std::setprecision(unit ? 3 : 0) << std::fixed << value << units[unit];
+    return ss.str();
+}
+
+int PipelineGraph::addNode(const Node& node) {
+    nodes.push_back(node);
+    return static_cast<int>(nodes.size()) - 1;
+}
+
+void PipelineGraph::addEdge(int from, int to, EdgeType type, int position, int delay, int output) {
+    edges.push_back({ from, to, type, position, delay, output });
+}
+
+void PipelineGraph::addChildCosts(int index) {
+    Node& node = nodes[index];
+    for (const Node& child : nodes) {
+        if (child.parent == index) {
+            node.passes += child.passes;
+            node.fetchesPerFrame += child.fetchesPerFrame;
+            node.cost += child.cost;
+        }
+    }
+}
+
+double PipelineGraph::getTime(int index) const {
+    const Node& node = nodes[index];
+    return (node.gpuMs >= 0.0) ? node.gpuMs : node.cpuMs;
+}
+
+void PipelineGraph::writeDotNode(std::ostream& os, int index, double maxTime, double maxCost, int indent) const {
+    const Node& node = nodes[index];
+    const std::string pad(indent * 2, ' ');
+
+    bool cluster = false;
+    for (const Node& child : nodes) {
+        cluster |= (child.parent == index);
+    }
+
+    if (cluster) {
+        os << pad << "subgraph cluster_" << index << " {\n";
+        os << pad << "  style=dashed;\n";
+        os << pad << "  label=";
+        writeString(os, node.name);
+        os << ";\n";
+    }
+
+    std::stringstream label;
+    label << node.name;
+    if (node.type != node.name) {
+        label << " (" << node.type << ")";
+    }
+    label << "\n" << node.width << "x" << node.height << " " << node.format << " " << formatCount(double(node.bytes)) << "B";
+    label << "\n" << node.passes << ((node.passes == 1) ? " pass, " : " passes, ");
+    if (node.fetches) {
+        label << node.fetches << " fetches/px, ";
+    }
+    label << formatCount(node.fetchesPerFrame) << " fetches";
+    if (node.fetches || node.aluOps) {
+        label << "\n" << node.aluOps << " alu/px";
+        if (node.dependentReads) {
+            label << ", " << node.dependentReads << " dependent";
+        }
+        label << ", " << node.varyings << " varyings";
+        if (!node.precision.empty()) {
+            label << ", " << node.precision;
+        }
+    }
+    if (node.cost > 0.0) {
+        label << "\ncost " << formatCount(node.cost);
+    }
+
+    label << std::fixed << std::setprecision(3);
+    if (node.cpuMs >= 0.0) {
+        label << "\ncpu " << node.cpuMs << " ms";
+    }
+    if (node.gpuMs >= 0.0) {
+        label << ((node.cpuMs >= 0.0) ? ", gpu " : "\ngpu ") << node.gpuMs << " ms";
+    }
+
+    // white to red by the share of the most expensive node, by the predicted cost if nothing was timed
+    const double time = getTime(index);
+    double heat = (time > 0.0 && maxTime > 0.0) ? time / maxTime : 0.0;
+    if (maxTime <= 0.0 && maxCost > 0.0) {
+        heat = node.cost / maxCost;
+    }
+
+    os << pad << (cluster ? "  " : "") << "n" << index << " [label=";
+    writeString(os, label.str());
+    os << ", fillcolor=\"0.000 " << std::fixed << std::setprecision(3) << heat << " 1.000\"";
+    if (cluster) {
+        os << ", shape=box3d";
+    }
+    if (!node.active) {
+        os << ", style=\"rounded,filled,dashed\"";
+    }
+    os << "];\n";
+
+    if (cluster) {
+        for (int i = 0; i < int(nodes.size()); i++) {
+            if (nodes[i].parent == index) {
+                writeDotNode(os, i, maxTime, maxCost, indent + 1);
+            }
+        }
+        os << pad << "}\n";
+    }
+}
+
+void PipelineGraph::writeDot(std::ostream& os) const {
+    double maxTime = 0.0, maxCost = 0.0;
+    for (int i = 0; i < int(nodes.size()); i++) {
+        maxTime = std::max(maxTime, getTime(i));
+        maxCost = std::max(maxCost, nodes[i].cost);
+    }
+
+    os << "digraph pipeline {\n";
+    os << "  node [shape=box, style=\"rounded,filled\", fontname=\"Helvetica\", fontsize=10];\n";
+    os << "  edge [fontname=\"Helvetica\", fontsize=9];\n";
+
+    for (int i = 0; i < int(nodes.size()); i++) {
+        if (nodes[i].parent < 0) {
+            writeDotNode(os, i, maxTime, maxCost, 1);
+        }
+    }
+
+    for (const Edge& edge : edges) {
+        std::stringstream attributes;
+        if (edge.type == kDelayed) {
+            attributes << "label=\"delay " << edge.delay << "\", style=dashed";
+        } else if (edge.type == kPass) {
+            attributes << "style=dotted";
+        } else if (edge.position != 0) {
+            attributes << "label=\"" << edge.position << "\"";
+        }
+        if (edge.output != 0) {
+            attributes << (attributes.tellp() > 0 ? ", " : "") << "taillabel=\"" << edge.output << "\"";
+        }
+
+        os << "  n" << edge.from << " -> n" << edge.to;
+        if (attributes.tellp() > 0) {
+            os << " [" << attributes.str() << "]";
+        }
+        os << ";\n";
+    }
+
+    os << "}\n";
+}
+
+void PipelineGraph::writeJSON(std::ostream& os) const {
+    os << std::fixed << std::setprecision(3);
+    os << "{\"nodes\":[";
+    for (int i = 0; i < int(nodes.size()); i++) {
+        const Node& node = nodes[i];
+        os << (i ? ",\n" : "\n") << "{\"id\":" << i << ",\"name\":";
+        writeString(os, node.name);
+        os << ",\"type\":";
+        writeString(os, node.type);
+        os << ",\"parent\":" << node.parent << ",\"width\":" << node.width << ",\"height\":" << node.height;
+        os << ",\"format\":";
+        writeString(os, node.format);
+        os << ",\"bytes\":" << node.bytes << ",\"passes\":" << node.passes << ",\"fetches\":" << node.fetches;
+        os << ",\"dependentReads\":" << node.dependentReads << ",\"aluOps\":" << node.aluOps << ",\"varyings\":" << node.varyings;
+        os << ",\"precision\":";
+        writeString(os, node.precision);
+        os << ",\"fetchesPerFrame\":" << std::setprecision(0) << node.fetchesPerFrame << ",\"cost\":" << node.cost << std::setprecision(3);
+        os << ",\"cpuMs\":" << node.cpuMs << ",\"gpuMs\":" << node.gpuMs;
+        os << ",\"active\":" << (node.active ? "true" : "false") << "}";
+    }
+
+    os << "\n],\"edges\":[";
+    for (std::size_t i = 0; i < edges.size(); i++) {
+        const Edge& edge = edges[i];
+        os << (i ? ",\n" : "\n") << "{\"from\":" << edge.from << ",\"to\":" << edge.to;
+        os << ",\"type\":\"" << kEdgeTypeNames[edge.type] << "\",\"position\":" << edge.position;
+        os << ",\"delay\":" << edge.delay << ",\"output\":" << edge.output << "}";
+    }
+    os << "\n]}\n";
+}
+
+std::string PipelineGraph::toDot() const {
+    std::stringstream ss;
+    writeDot(ss);
+    return ss.str();
+}
+
+std::string PipelineGraph::toJSON() const {
+    std::stringstream ss;
+    writeJSON(ss);
+    return ss.str();
+}
@@ -0,0 +1,124 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+/**
+ * Pipeline introspection.
+ */
+#ifndef OGLES_GPGPU_COMMON_GRAPH
+#define OGLES_GPGPU_COMMON_GRAPH
+
+#include "common_includes.h"
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ogles_gpgpu {
+
+/**
+ * Processor graph of a pipeline with the cost of each processor, i.e. to find the
+ * expensive processors of a large graph (see ProcInterface::getGraph()). It can be
+ * written as GraphViz DOT, where the nodes are shaded by their time and multi-pass
+ * processors are clusters of their passes, or as JSON.
+ */
+class PipelineGraph {
+public:
+    struct Node {
+        std::string name; // stage name (see ProcInterface::getStageName())
+        std::string type; // processor name (see ProcInterface::getProcName())
+        int parent = -1; // enclosing multi-pass processor (-1: none)
+        int width = 0; // output size
+        int height = 0;
+        std::string format; // output texture format, i.e. "RGBA8"
+        std::size_t bytes = 0; // GPU memory, including the passes (see ProcInterface::getMemoryUsage())
+        int passes = 0; // render passes per frame, including the passes
+        int fetches = 0; // texture fetches per output pixel of the shader (see ProcInterface::getShaderCost())
+        int dependentReads = 0; // dependent texture reads per output pixel
+        int aluOps = 0; // ALU ops per output pixel
+        int varyings = 0; // varyings read by the fragment shader
+        std::string precision; // default float precision of the fragment shader
+        double fetchesPerFrame = 0.0; // texture fetches per frame, including the passes
+        double cost = 0.0; // predicted cost per frame in ALU ops, including the passes (see ShaderCost::getCostPerPixel())
+        double cpuMs = -1.0; // CPU time of the last render() (-1: not rendered, see ProcInterface::getRenderTime())
+        double gpuMs = -1.0; // GPU time of the last measured render() (-1: not measured, see ProcInterface::setGPUTiming())
+        bool active = true;
+    };
+
+    enum EdgeType {
+        kSubscriber, // output to input (see ProcInterface::add())
+        kDelayed, // delayed output of a FifoProc (see FifoProc::addWithDelay())
+        kPass // rendered in sequence, i.e. a multi-pass processor and its passes or Core
+    };
+
+    struct Edge {
+        int from;
+        int to;
+        EdgeType type;
+        int position; // input position of <to>
+        int delay; // kDelayed: the time of FifoProc::addWithDelay()
+        int output; // output of <from> (see MultiTargetProc::addToOutput())
+    };
+
+    /**
+     * Add node <node> and return its index.
+     */
+    int addNode(const Node& node);
+
+    /**
+     * Add an edge from node <from> to node <to>.
+     */
+    void addEdge(int from, int to, EdgeType type = kSubscriber, int position = 0, int delay = 0, int output = 0);
+
+    /**
+     * Sum up the passes, the fetches per frame and the cost of the nodes with parent
+     * <index> into node <index>.
+     */
+    void addChildCosts(int index);
+
+    /**
+     * Get the time of node <index> in ms: the GPU time if measured, otherwise the CPU
+     * time, or -1 if neither is known.
+     */
+    double getTime(int index) const;
+
+    const std::vector<Node>& getNodes() const {
+        return nodes;
+    }
+
+    std::vector<Node>& getNodes() {
+        return nodes;
+    }
+
+    const std::vector<Edge>& getEdges() const {
+        return edges;
+    }
+
+    /**
+     * Write the graph as GraphViz DOT to <os> (i.e. for "dot -Tsvg"). Without measured
+     * times, the nodes are shaded by their predicted cost.
+     */
+    void writeDot(std::ostream& os) const;
+
+    /**
+     * Write the graph as JSON to <os>: {"nodes":[{"id":0, "name":..., ...}], "edges":[...]}
+     * with the fields of Node and Edge.
+     */
+    void writeJSON(std::ostream& os) const;
+
+    std::string toDot() const;
+
+    std::string toJSON() const;
+
+private:
+    void writeDotNode(std::ostream& os, int index, double maxTime, double maxCost, int indent) const;
+
+    std::vector<Node> nodes;
+    std::vector<Edge> edges;
+};
+}
+
+#endif
@@ -0,0 +1,173 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+#include "latency.h"
+#include "gl/call_counters.h"
+#include "gl/timer_query.h"
+
+#include <algorithm>
+#include <sstream>
+
+using namespace std;
+using namespace ogles_gpgpu;
+
+const std::size_t LatencyTracker::kMaxPending;
+
+static thread_local std::uint64_t currentFrameId = 0;
+
+static double elapsedMs(const LatencyTracker::Clock::time_point& start, const LatencyTracker::Clock::time_point& stop) {
+    return std::max(0.0, std::chrono::duration<double, std::milli>(stop - start).count());
+}
+
+std::string FrameLatency::toString() const {
+    std::stringstream ss;
+    ss << "frame=" << frameId << " total=" << getTotal() << "ms queue=" << queue << "ms upload=" << upload;
+    ss << "ms gpu=" << gpu << "ms readback=" << readback << "ms";
+    return ss.str();
+}
+
+// ########## LatencyTracker
+
+LatencyTracker::FrameScope::FrameScope(std::uint64_t frameId)
+    : previous(currentFrameId) {
+    currentFrameId = frameId;
+}
+
+LatencyTracker::FrameScope::~FrameScope() {
+    currentFrameId = previous;
+}
+
+std::uint64_t LatencyTracker::getCurrentFrameId() {
+    return currentFrameId;
+}
+
+LatencyTracker::~LatencyTracker() {
+    reset();
+    for (GLuint query : queryPool) {
+        GPUTimestamp::destroy(query);
+    }
+}
+
+void LatencyTracker::setEnabled(bool flag) {
+    if (flag && !enabled) {
+        calibrated = false;
+    }
+    enabled = flag;
+}
+
+void LatencyTracker::begin(std::uint64_t frameId, Clock::time_point captureTime) {
+    if (!enabled) {
+        return;
+    }
+
+    if (!calibrated && GPUTimestamp::isSupported()) {
+        glFinish(); // the GPU is idle, so that the current GPU time is now
+        OG_GL_COUNT(finishes);
+        gpuOrigin = GPUTimestamp::getCurrent();
+        cpuOrigin = Clock::now();
+        calibrated = true;
+    }
+
+    while (pending.size() >= kMaxPending) {
+        release(pending.front());
+        pending.pop_front();
+    }
+
+    const Clock::time_point now = Clock::now();
+    pending.push_back({ frameId, (captureTime == Clock::time_point()) ? now : captureTime, now, now, now, 0 });
+}
+
+void LatencyTracker::uploaded() {
+    if (enabled && !pending.empty()) {
+        pending.back().uploaded = Clock::now();
+    }
+}
+
+void LatencyTracker::submitted() {
+    if (!enabled || pending.empty()) {
+        return;
+    }
+
+    Frame& frame = pending.back();
+    frame.submitted = Clock::now();
+    if (calibrated) {
+        if (queryPool.empty()) {
+            frame.query = GPUTimestamp::create();
+        } else {
+            frame.query = queryPool.back();
+            queryPool.pop_back();
+        }
+        GPUTimestamp::record(frame.query);
+    }
+}
+
+bool LatencyTracker::complete(std::uint64_t frameId, FrameLatency* latency) {
+    auto frame = std::find_if(pending.begin(), pending.end(), [&](const Frame& f) { return f.id == frameId; });
+    if (frame == pending.end()) {
+        return false;
+    }
+
+    const Clock::time_point now = Clock::now();
+
+    // end of the GPU stage: the GPU timestamp on the CPU clock, or the submission
+    Clock::time_point gpuDone = frame->submitted;
+    std::int64_t ns = 0;
+    if (frame->query && GPUTimestamp::getResult(frame->query, ns, true)) {
+        gpuDone = cpuOrigin + std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(ns - gpuOrigin));
+        gpuDone = std::min(std::max(gpuDone, frame->uploaded), now);
+    }
+
+    FrameLatency result;
+    result.frameId = frameId;
+    result.queue = elapsedMs(frame->capture, frame->begin);
+    result.upload = elapsedMs(frame->begin, frame->uploaded);
+    result.gpu = elapsedMs(frame->uploaded, gpuDone);
+    result.readback = elapsedMs(gpuDone, now);
+
+    queueStats.add(result.queue);
+    uploadStats.add(result.upload);
+    gpuStats.add(result.gpu);
+    readbackStats.add(result.readback);
+    totalStats.add(result.getTotal());
+
+    release(*frame);
+    pending.erase(frame);
+
+    if (latency) {
+        *latency = result;
+    }
+    return true;
+}
+
+void LatencyTracker::reset() {
+    for (Frame& frame : pending) {
+        release(frame);
+    }
+    pending.clear();
+
+    queueStats.reset();
+    uploadStats.reset();
+    gpuStats.reset();
+    readbackStats.reset();
+    totalStats.reset();
+}
+
+std::string LatencyTracker::toString() const {
+    std::stringstream ss;
+    ss << "total: " << totalStats.toString() << "\n";
+    ss << "queue: " << queueStats.toString() << "\n";
+    ss << "upload: " << uploadStats.toString() << "\n";
+    ss << "gpu: " << gpuStats.toString() << "\n";
+    ss << "readback: " << readbackStats.toString() << "\n";
+    return ss.str();
+}
+
+void LatencyTracker::release(Frame& frame) {
+    if (frame.query) {
+        queryPool.push_back(frame.query);
+        frame.query = 0;
+    }
+}
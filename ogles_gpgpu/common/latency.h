@@ -0,0 +1,181 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+/**
+ * End-to-end frame latency.
+ */
+#ifndef OGLES_GPGPU_COMMON_LATENCY
+#define OGLES_GPGPU_COMMON_LATENCY
+
+#include "common_includes.h"
+#include "stats.h"
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace ogles_gpgpu {
+
+/**
+ * Latency of one frame from its capture to its result in milliseconds, broken down
+ * into its stages (see LatencyTracker).
+ */
+struct FrameLatency {
+    std::uint64_t frameId = 0;
+    double queue = 0.0; // capture until VideoSource::operator()
+    double upload = 0.0; // upload, YUV conversion and (re)configuration of the pipeline
+    double gpu = 0.0; // process() until the GPU finished the frame
+    double readback = 0.0; // GPU finished until the result was delivered
+
+    double getTotal() const {
+        return queue + upload + gpu + readback;
+    }
+
+    /**
+     * Format as "frame=12 total=9.1ms queue=1.2ms upload=0.8ms gpu=5.9ms readback=1.2ms".
+     */
+    std::string toString() const;
+};
+
+/**
+ * Follows frames from capture to result. VideoSource calls begin(), uploaded() and
+ * submitted() for each frame (see FrameInput::frameId and FrameInput::captureTime) and
+ * the caller calls complete() once it has the result of a frame, i.e. after a (possibly
+ * asynchronous) getResultData() of the frame ProcInterface::getResultFrameId().
+ *
+ * The GPU stage ends when the GPU finished the commands of process(), measured with
+ * GL_TIMESTAMP queries without stalling the pipeline. Without timestamp queries it ends
+ * when process() returns, and the readback includes the wait for the GPU.
+ *
+ * Up to kMaxPending frames can wait for complete(), older ones are dropped. All calls
+ * need the OpenGL context of the pipeline.
+ */
+class LatencyTracker {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static const std::size_t kMaxPending = 16;
+
+    /**
+     * Sets the frame that the calling thread is processing for the lifetime of the scope
+     * (see getCurrentFrameId()).
+     */
+    class FrameScope {
+    public:
+        FrameScope(std::uint64_t frameId);
+        ~FrameScope();
+
+    private:
+        std::uint64_t previous;
+    };
+
+    /**
+     * Get the frame that the calling thread is processing (0: none), i.e. to stamp the
+     * output of the processors (see ProcInterface::getFrameId()).
+     */
+    static std::uint64_t getCurrentFrameId();
+
+    /**
+     * Deletes the query objects (needs the OpenGL context that recorded the frames).
+     */
+    ~LatencyTracker();
+
+    /**
+     * Enable or disable the tracking (default: disabled). The first frame after enabling
+     * synchronizes the CPU and GPU clocks with glFinish().
+     */
+    void setEnabled(bool flag);
+
+    bool isEnabled() const {
+        return enabled;
+    }
+
+    /**
+     * Start frame <frameId>, captured at <captureTime> (default: now, no queueing).
+     */
+    void begin(std::uint64_t frameId, Clock::time_point captureTime = {});
+
+    /**
+     * The frame of begin() was uploaded.
+     */
+    void uploaded();
+
+    /**
+     * The commands of the frame of begin() were submitted, i.e. after process().
+     */
+    void submitted();
+
+    /**
+     * The result of frame <frameId> was delivered: add its latency to the statistics and
+     * optionally return it in <latency>. Waits for the GPU timestamp of the frame if it
+     * is not available yet. Returns false if the frame is not tracked (anymore).
+     */
+    bool complete(std::uint64_t frameId, FrameLatency* latency = nullptr);
+
+    /**
+     * Remove all statistics and pending frames.
+     */
+    void reset();
+
+    /**
+     * Get the statistics (with rolling percentiles) of each stage and of the total.
+     */
+    const TimingStats& getQueueStats() const {
+        return queueStats;
+    }
+
+    const TimingStats& getUploadStats() const {
+        return uploadStats;
+    }
+
+    const TimingStats& getGPUStats() const {
+        return gpuStats;
+    }
+
+    const TimingStats& getReadbackStats() const {
+        return readbackStats;
+    }
+
+    const TimingStats& getTotalStats() const {
+        return totalStats;
+    }
+
+    /**
+     * Return a human readable summary of all stages (i.e. for logging).
+     */
+    std::string toString() const;
+
+private:
+    struct Frame {
+        std::uint64_t id;
+        Clock::time_point capture;
+        Clock::time_point begin;
+        Clock::time_point uploaded;
+        Clock::time_point submitted;
+        GLuint query; // GPU timestamp after the commands of process() (0: none)
+    };
+
+    void release(Frame& frame);
+
+    bool enabled = false;
+    bool calibrated = false; // gpuOrigin and cpuOrigin are set
+    std::int64_t gpuOrigin = 0; // GPU time (ns) at cpuOrigin
+    Clock::time_point cpuOrigin;
+
+    std::deque<Frame> pending; // oldest first, the last one may still be in progress
+    std::vector<GLuint> queryPool;
+
+    TimingStats queueStats;
+    TimingStats uploadStats;
+    TimingStats gpuStats;
+    TimingStats readbackStats;
+    TimingStats totalStats;
+};
+}
+
+#endif
@@ -8,6 +8,8 @@
 //
 
 #include "filterprocbase.h"
+#include "../../gl/caps.h"
+#include "../../gl/shader_cache.h"
 
 #include <memory.h> // for memcpy on linux
 
@@ -97,9 +99,28 @@ void FilterProcBase::useTexture(GLuint id, GLuint useTexUnit, GLenum target, int
         if (fragShaderSrcForCompilation) { // recreate shader with new texture target
             auto vShaderSrc = vertexShaderSrcForCompilation ? vertexShaderSrcForCompilation : vshaderDefault;
             filterShaderSetup(vShaderSrc, fragShaderSrcForCompilation, target);
+
+            // the uniforms refer to the previous program
+            getUniforms();
         }
         texTarget = target;
+
+        if (shader) { // the compute backend takes GL_TEXTURE_2D input only
+            computeSetup();
+        }
+    }
+}
+
+void FilterProcBase::prefetchShaders(std::set<ProcInterface*>& visited) {
+    const char* fShaderSrc = getFragmentShaderSource();
+    if (!shader && fShaderSrc && !visited.count(this)) {
+        const char* vShaderSrc = getVertexShaderSource();
+        string vSrcStr(vShaderSrc ? vShaderSrc : vshaderDefault), fSrcStr(fShaderSrc);
+        adaptShaderSources(vSrcStr, fSrcStr, texTarget);
+        ShaderCache::prefetch(vSrcStr.c_str(), fSrcStr.c_str());
     }
+
+    ProcInterface::prefetchShaders(visited);
 }
 
 #pragma mark protected methods
@@ -117,12 +138,12 @@ void FilterProcBase::filterInit(const char* vShaderSrc, const char* fShaderSrc,
 
 void FilterProcBase::filterShaderSetup(const char* vShaderSrc, const char* fShaderSrc, GLenum target) {
     // create shader object
-    ProcBase::createShader(vShaderSrc, fShaderSrc, target);
+    createShader(vShaderSrc, fShaderSrc, target);
 
     // TODO: Support uniform reads through virtual API call:
     shParamAPos = shader->getParam(ATTR, "aPos");
     shParamATexCoord = shader->getParam(ATTR, "aTexCoord");
-    shParamUInputTex = shader->getParam(UNIF, "uInputTex");
+    shParamUInputTex.init(shader.get(), "uInputTex");
 
     // remember used shader source
     vertexShaderSrcForCompilation = vShaderSrc;
@@ -139,6 +160,13 @@ void FilterProcBase::getUniforms() {
 int FilterProcBase::render(int position) {
     OG_LOGINF(getProcName(), "input tex %d, target %d, framebuffer of size %dx%d", texId, texTarget, outFrameW, outFrameH);
 
+    updateRenderTarget();
+
+    if (computeShader) {
+        computeRender();
+        return 0;
+    }
+
     filterRenderPrepare();
     Tools::checkGLErr(getProcName(), "render prepare");
 
@@ -207,9 +235,10 @@ void FilterProcBase::filterRenderPrepare() {
     // set input texture
     glActiveTexture(GL_TEXTURE0 + texUnit);
     glBindTexture(texTarget, texId); // bind input texture
+    OG_GL_COUNT(textureBinds);
 
     // set common uniforms
-    glUniform1i(shParamUInputTex, texUnit);
+    shParamUInputTex.set(texUnit);
 }
 
 void FilterProcBase::filterRenderSetCoords() {
@@ -238,6 +267,7 @@ void FilterProcBase::filterRenderSetCoords() {
 void FilterProcBase::filterRenderDraw() {
     // draw
     glDrawArrays(GL_TRIANGLE_STRIP, 0, OGLES_GPGPU_QUAD_VERTICES);
+    OG_GL_COUNT(drawCalls);
 }
 
 void FilterProcBase::filterRenderCleanup() {
@@ -264,5 +294,60 @@ int FilterProcBase::init(int inW, int inH, unsigned int order, bool prepareForEx
     // Get shader specific uniforms
     getUniforms();
 
+    // Build the compute shader for the compute backend
+    computeSetup();
+
     return 1;
 }
+
+void FilterProcBase::computeSetup() {
+    computeShader.reset();
+
+#if defined(OGLES_GPGPU_COMPUTE)
+    // the compute shaders sample output pixel centers, without the texture coordinates of
+    // render orientations and without mipmaps for scaled outputs
+    const bool unscaled = (procParamOutW == 0 && procParamOutH == 0 && procParamOutScale == 1.0f);
+    const char* cShaderSrc = (backend == kComputeBackend && unscaled) ? getComputeShaderSource() : nullptr;
+    if (!cShaderSrc || !GLCaps::get().computeShaders || texTarget != GL_TEXTURE_2D || renderOrientation != RenderOrientationStd) {
+        return; // fragment backend
+    }
+
+    computeShader = std::unique_ptr<Shader>(new Shader);
+    if (!computeShader->buildComputeFromSrc(cShaderSrc)) {
+        OG_LOGERR(getProcName(), "compute shader not available, using the fragment backend");
+        computeShader.reset();
+        return;
+    }
+
+    glGetProgramiv(computeShader->getProgramId(), GL_COMPUTE_WORK_GROUP_SIZE, computeWorkGroupSize);
+    computeShaderCost = ShaderCost::analyze(std::string(), cShaderSrc);
+    shParamUComputeInputTex.init(computeShader.get(), "inputImageTexture");
+
+    OG_LOGINF(getProcName(), "compute shader program %d ready", computeShader->getProgramId());
+#endif
+}
+
+void FilterProcBase::computeRender() {
+#if defined(OGLES_GPGPU_COMPUTE)
+    computeShader->use();
+
+    // set input texture
+    glActiveTexture(GL_TEXTURE0 + texUnit);
+    glBindTexture(texTarget, texId);
+    OG_GL_COUNT(textureBinds);
+    shParamUComputeInputTex.set(texUnit);
+
+    glBindImageTexture(0, getOutputTexId(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_RGBA8);
+    OG_GL_COUNT(textureBinds);
+    Tools::checkGLErr(getProcName(), "compute prepare");
+
+    const GLuint groupsX = (outFrameW + computeWorkGroupSize[0] - 1) / computeWorkGroupSize[0];
+    const GLuint groupsY = (outFrameH + computeWorkGroupSize[1] - 1) / computeWorkGroupSize[1];
+    glDispatchCompute(groupsX, groupsY, 1);
+    OG_GL_COUNT(drawCalls);
+
+    // make the image writes visible to texture reads, framebuffer reads and read backs
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT | GL_PIXEL_BUFFER_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT);
+    Tools::checkGLErr(getProcName(), "compute dispatch");
+#endif
+}
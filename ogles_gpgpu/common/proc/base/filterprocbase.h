@@ -22,9 +22,19 @@ namespace ogles_gpgpu {
 /**
  * Base class for filter processors. Such processors implement image processing
  * tasks with fragment shaders. They output is rendered on a fullscreen quad.
+ * Processors that also provide a compute shader can run on the compute backend
+ * instead (see setBackend()).
  */
 class FilterProcBase : public ProcBase {
 public:
+    /**
+     * Execution backends.
+     */
+    enum Backend {
+        kFragmentBackend, // fragment shader on a fullscreen quad
+        kComputeBackend // compute shader (see getComputeShaderSource())
+    };
+
     FilterProcBase()
         : ProcBase()
         , fragShaderSrcForCompilation(NULL) {
@@ -47,6 +57,37 @@ public:
      */
     virtual int render(int position = 0);
 
+    /**
+     * Submit the program for getVertexShaderSource() and getFragmentShaderSource(),
+     * see ProcInterface::prefetchShaders().
+     */
+    using ProcInterface::prefetchShaders;
+    virtual void prefetchShaders(std::set<ProcInterface*>& visited);
+
+    /**
+     * Select the execution backend (default: kFragmentBackend). The compute backend is
+     * used if the processor has a compute shader and the OpenGL context supports compute
+     * shaders, for GL_TEXTURE_2D input, the standard render orientation and an output of
+     * input size. Otherwise the fragment backend is used. Must be called before init().
+     */
+    void setBackend(Backend newBackend) {
+        backend = newBackend;
+    }
+
+    /**
+     * Get the execution backend in use (after init()).
+     */
+    Backend getBackend() const {
+        return computeShader ? kComputeBackend : kFragmentBackend;
+    }
+
+    /**
+     * Return the static cost per output pixel of the shader of the backend in use.
+     */
+    virtual ShaderCost getShaderCost() {
+        return computeShader ? computeShaderCost : shaderCost;
+    }
+
 protected:
     /**
      * Perform a standard shader initialization.
@@ -67,6 +108,16 @@ protected:
         return 0;
     }
 
+    /**
+     * Get the compute shader source for the compute backend, or nullptr if the processor
+     * has none. The shader reads "inputImageTexture" and writes each output pixel to the
+     * rgba8 image "outputImage" at image unit 0. The number of work groups is derived from
+     * its local size and the output frame size.
+     */
+    virtual const char* getComputeShaderSource() {
+        return nullptr;
+    }
+
     /**
      * Set additional uniforms.
      */
@@ -106,6 +157,16 @@ protected:
     virtual void filterRenderDraw();
     virtual void filterRenderCleanup();
 
+    /**
+     * Build the compute shader, if the compute backend was selected and can be used.
+     */
+    void computeSetup();
+
+    /**
+     * Run the compute shader on the input texture.
+     */
+    void computeRender();
+
     static const char* vshaderFilter3x3Src; // GPUImage vertex shader (3x3 access)
     static const char* vshaderGPUImage; // GPUImage vertex shader (shader compatibility)
     static const char* vshaderDefault; // default vertex shader to render a fullscreen quad
@@ -118,6 +179,12 @@ protected:
 
     GLfloat vertexBuf[OGLES_GPGPU_QUAD_VERTEX_BUFSIZE]; // vertex data buffer for a quad
     GLfloat texCoordBuf[OGLES_GPGPU_QUAD_TEX_BUFSIZE]; // texture coordinate data buffer for a quad
+
+    Backend backend = kFragmentBackend; // selected backend
+    std::unique_ptr<Shader> computeShader; // compute backend program (nullptr: fragment backend)
+    GLint computeWorkGroupSize[3] = { 1, 1, 1 }; // local size of the compute shader
+    ShaderCost computeShaderCost; // static cost of the compute shader per output pixel
+    Uniform<GLint> shParamUComputeInputTex; // compute shader input texture sampler
 };
 }
 
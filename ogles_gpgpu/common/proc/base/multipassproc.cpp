@@ -113,7 +113,17 @@ void MultiPassProc::createFBOTex(bool genMipmap) {
     }
 }
 
+void MultiPassProc::setBackend(FilterProcBase::Backend backend) {
+    for (auto& it : procPasses) {
+        if (auto filter = dynamic_cast<FilterProcBase*>(it)) {
+            filter->setBackend(backend);
+        }
+    }
+}
+
 int MultiPassProc::render(int position) {
+    updateRenderTarget();
+
     for (auto& it : procPasses) {
         it->render(position);
     }
@@ -135,6 +145,12 @@ void MultiPassProc::useTexture(GLuint id, GLuint useTexUnit, GLenum target, int
     }
 }
 
+void MultiPassProc::reset() {
+    for (auto& it : procPasses) {
+        it->reset();
+    }
+}
+
 bool MultiPassProc::getWillDownscale() const {
     for (auto& it : procPasses) {
         if (it->getWillDownscale()) {
@@ -14,6 +14,7 @@
 #define OGLES_GPGPU_COMMON_PROC_MULTIPASSPROC
 
 #include "../../common_includes.h"
+#include "filterprocbase.h"
 #include "multiprocinterface.h"
 
 #include <list>
@@ -58,6 +59,12 @@ public:
      */
     virtual void createFBOTex(bool genMipmap);
 
+    /**
+     * Select the execution backend of all filter passes (see FilterProcBase::setBackend()).
+     * Must be called before init().
+     */
+    void setBackend(FilterProcBase::Backend backend);
+
     /**
      * Render a result, i.e. run the shader on the input texture.
      * Abstract method.
@@ -69,6 +76,11 @@ public:
      */
     virtual void useTexture(GLuint id, GLuint useTexUnit = 1, GLenum target = GL_TEXTURE_2D, int position = 0);
 
+    /**
+     * Reset the temporal state of all passes.
+     */
+    virtual void reset();
+
     /**
      * Returns true if output size < input size.
      */
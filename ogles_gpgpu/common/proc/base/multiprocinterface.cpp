@@ -1,9 +1,63 @@
 #include "multiprocinterface.h"
 
+#include <algorithm>
+
 BEGIN_OGLES_GPGPU
 
 // ######### MultiProcInterface
 
+void MultiProcInterface::prefetchShaders(std::set<ProcInterface*>& visited) {
+    if (!visited.count(this)) {
+        // all passes, and the internal filter chain (if any)
+        for (size_t i = 0; i < size(); i++) {
+            (*this)[i]->prefetchShaders(visited);
+        }
+        getInputFilter()->prefetchShaders(visited);
+    }
+
+    ProcInterface::prefetchShaders(visited);
+}
+
+void MultiProcInterface::addMemoryUsage(MemoryUsage& usage, std::set<ProcInterface*>& visited) {
+    // all passes, and the internal filter chain (if any)
+    MemoryReport passes;
+    for (size_t i = 0; i < size(); i++) {
+        (*this)[i]->getMemoryReport(passes, visited);
+    }
+    getInputFilter()->getMemoryReport(passes, visited);
+
+    usage += getTotal(passes);
+}
+
+int MultiProcInterface::addToGraph(PipelineGraph& graph, std::map<ProcInterface*, int>& nodes, int parent) {
+    auto found = nodes.find(this);
+    if (found != nodes.end()) {
+        return found->second;
+    }
+
+    const int index = ProcInterface::addToGraph(graph, nodes, parent);
+    graph.getNodes()[index].passes = 0; // the sum of the passes
+
+    // the internal filter chain (if any), and all passes
+    graph.addEdge(index, getInputFilter()->addToGraph(graph, nodes, index), PipelineGraph::kPass);
+
+    int previous = -1;
+    for (size_t i = 0; i < size(); i++) {
+        const int pass = (*this)[i]->addToGraph(graph, nodes, index);
+
+        // passes without subscribers feed the next pass (see MultiPassProc::render())
+        const auto& edges = graph.getEdges();
+        auto output = std::find_if(edges.begin(), edges.end(), [&](const PipelineGraph::Edge& e) { return e.from == previous; });
+        if (previous >= 0 && output == edges.end()) {
+            graph.addEdge(previous, pass, PipelineGraph::kPass);
+        }
+        previous = pass;
+    }
+
+    graph.addChildCosts(index);
+    return index;
+}
+
 void MultiProcInterface::setOutputRenderOrientation(RenderOrientation o) {
     getOutputFilter()->setOutputRenderOrientation(o);
 }
@@ -42,10 +96,14 @@ bool MultiProcInterface::getWillDownscale() const {
     return getInputFilter()->getWillDownscale();
 }
 void MultiProcInterface::getResultData(unsigned char* data, int index) const {
+    const bool reading = getMemTransferObj()->isReadingAsynchronously(index);
     getOutputFilter()->getResultData(data, index);
+    trackResultFrame(index, reading, getMemTransferObj()->isReadingAsynchronously(index));
 }
 void MultiProcInterface::getResultData(const FrameDelegate& delegate, int index) const {
+    const bool reading = getMemTransferObj()->isReadingAsynchronously(index);
     getOutputFilter()->getResultData(delegate, index);
+    trackResultFrame(index, reading, getMemTransferObj()->isReadingAsynchronously(index));
 }
 MemTransfer* MultiProcInterface::getMemTransferObj() const {
     return getOutputFilter()->getMemTransferObj();
@@ -59,6 +117,9 @@ GLuint MultiProcInterface::getInputTexId() const {
 GLuint MultiProcInterface::getOutputTexId() const {
     return getOutputFilter()->getOutputTexId();
 }
+bool MultiProcInterface::setRenderTarget(GLuint texId) {
+    return getOutputFilter()->setRenderTarget(texId);
+}
 void MultiProcInterface::printInfo() {
     OG_LOGINF(getProcName(), "begin info for %u passes", (unsigned int)size());
     for (int i = 0; i < size(); i++) {
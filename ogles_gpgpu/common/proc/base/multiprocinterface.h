@@ -43,6 +43,20 @@ public:
     virtual MemTransfer* getInputMemTransferObj() const;
     virtual GLuint getInputTexId() const;
     virtual GLuint getOutputTexId() const;
+    virtual bool setRenderTarget(GLuint texId);
+
+    using ProcInterface::prefetchShaders;
+    virtual void prefetchShaders(std::set<ProcInterface*>& visited);
+
+    /**
+     * Add the memory of all passes and of the internal filter chain to <usage>.
+     */
+    virtual void addMemoryUsage(MemoryUsage& usage, std::set<ProcInterface*>& visited);
+
+    /**
+     * Add this processor and its passes and internal filter chain as its children.
+     */
+    virtual int addToGraph(PipelineGraph& graph, std::map<ProcInterface*, int>& nodes, int parent);
 };
 
 END_OGLES_GPGPU
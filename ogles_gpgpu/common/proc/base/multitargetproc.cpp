@@ -0,0 +1,202 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+#include "multitargetproc.h"
+#include "../../gl/caps.h"
+
+#include <sstream>
+
+using namespace ogles_gpgpu;
+using namespace std;
+
+MultiTargetProc::MultiTargetProc(int outputCount)
+    : outputCount(outputCount) {
+    assert(outputCount >= 1);
+    outputSubscribers.resize(outputCount - 1);
+}
+
+MultiTargetProc::~MultiTargetProc() {
+    releaseOutputTextures();
+}
+
+void MultiTargetProc::cleanup() {
+    releaseOutputTextures();
+    FilterProcBase::cleanup();
+}
+
+void MultiTargetProc::releaseOutputTextures() {
+    if (!outputTexIds.empty()) {
+        glDeleteTextures(static_cast<GLsizei>(outputTexIds.size()), outputTexIds.data());
+        outputTexIds.clear();
+
+        GPUMemory::release(outputTexBytes);
+        outputTexBytes = 0;
+    }
+}
+
+void MultiTargetProc::createFBOTex(bool genMipmap) {
+    // output 0 is the regular FBO texture:
+    FilterProcBase::createFBOTex(genMipmap);
+
+    releaseOutputTextures();
+
+    if (outputCount == 1) {
+        return;
+    }
+
+#if defined(OGLES_GPGPU_OPENGL_ES2)
+    OG_LOGERR(getProcName(), "multiple render targets require OpenGL ES 3.0 (%d outputs requested)", outputCount);
+#else
+    if (outputCount > GLCaps::get().maxDrawBuffers) {
+        OG_LOGERR(getProcName(), "%d render targets requested, but only %d are supported", outputCount, GLCaps::get().maxDrawBuffers);
+        return;
+    }
+
+    outputTexIds.resize(outputCount - 1);
+    glGenTextures(static_cast<GLsizei>(outputTexIds.size()), outputTexIds.data());
+
+    fbo->bind();
+    glActiveTexture(GL_TEXTURE0 + fbo->getGLTexUnit());
+
+    std::vector<GLenum> drawBuffers(1, GL_COLOR_ATTACHMENT0);
+    for (int i = 1; i < outputCount; i++) {
+        GLuint outputTexId = outputTexIds[i - 1];
+        glBindTexture(GL_TEXTURE_2D, outputTexId);
+        OG_GL_COUNT(textureBinds);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, outFrameW, outFrameH, 0, OGLES_GPGPU_TEXTURE_FORMAT, GL_UNSIGNED_BYTE, NULL);
+        Tools::checkGLErr(getProcName(), "output texture creation");
+
+        fbo->attach(outputTexId, GL_COLOR_ATTACHMENT0 + i);
+        drawBuffers.push_back(GL_COLOR_ATTACHMENT0 + i);
+    }
+
+    glDrawBuffers(static_cast<GLsizei>(drawBuffers.size()), drawBuffers.data());
+    Tools::checkGLErr(getProcName(), "glDrawBuffers");
+
+    outputTexBytes = outputTexIds.size() * outFrameW * outFrameH * MemoryUsage::getBytesPerPixel(GL_RGBA);
+    GPUMemory::allocate(outputTexBytes);
+
+    fbo->unbind();
+
+    OG_LOGINF(getProcName(), "created %d render targets of size %dx%d", outputCount, outFrameW, outFrameH);
+#endif
+}
+
+GLuint MultiTargetProc::getOutputTexId(int output) const {
+    assert(output >= 0 && output < outputCount);
+
+    if (output == 0) {
+        return getOutputTexId();
+    }
+
+    return (output > 0 && output <= static_cast<int>(outputTexIds.size())) ? outputTexIds[output - 1] : 0;
+}
+
+void MultiTargetProc::addToOutput(ProcInterface* filter, int output, int position) {
+    assert(output >= 0 && output < outputCount);
+
+    if (output == 0) {
+        add(filter, position);
+    } else {
+        outputSubscribers[output - 1].emplace_back(filter, position);
+    }
+}
+
+void MultiTargetProc::getOutputData(int output, unsigned char* data) const {
+    assert(fbo && data && output >= 0 && output < outputCount);
+
+#if defined(OGLES_GPGPU_OPENGL_ES2)
+    assert(output == 0);
+    getResultData(data);
+#else
+    fbo->bind();
+    glReadBuffer(GL_COLOR_ATTACHMENT0 + output);
+    glReadPixels(0, 0, outFrameW, outFrameH, getMemTransferObj()->getOutputPixelFormat(), GL_UNSIGNED_BYTE, data);
+    Tools::checkGLErr("MultiTargetProc", "glReadPixels");
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    fbo->unbind();
+#endif
+}
+
+void MultiTargetProc::adaptShaderSources(std::string& vShSrc, std::string& fShSrc, GLenum target) {
+#if defined(OGLES_GPGPU_OPENGL_ES3)
+    // GLSL ES 1.00 only supports gl_FragData[0], so lift both stages to GLSL ES 3.00
+    // and declare one fragment output per color attachment:
+    vShSrc.insert(0, "#version 300 es\n#define attribute in\n#define varying out\n");
+
+    string fBody(fShSrc);
+    Tools::strReplaceAll(fBody, "gl_FragData", "og_FragData");
+
+    std::stringstream fSrc;
+    fSrc << "#version 300 es\n#define varying in\n#define texture2D texture\n";
+    fSrc << "layout(location = 0) out highp vec4 og_FragData[" << outputCount << "];\n";
+    fSrc << fBody;
+    fShSrc = fSrc.str();
+#endif
+
+    FilterProcBase::adaptShaderSources(vShSrc, fShSrc, target);
+}
+
+void MultiTargetProc::addMemoryUsage(MemoryUsage& usage, std::set<ProcInterface*>& visited) {
+    FilterProcBase::addMemoryUsage(usage, visited);
+
+    if (outputTexBytes) {
+        usage.textures[GL_RGBA] += outputTexBytes;
+    }
+}
+
+void MultiTargetProc::getMemoryReport(MemoryReport& report, std::set<ProcInterface*>& visited) {
+    FilterProcBase::getMemoryReport(report, visited);
+
+    for (auto& subscribers : outputSubscribers) {
+        for (auto& subscriber : subscribers) {
+            subscriber.first->getMemoryReport(report, visited);
+        }
+    }
+}
+
+int MultiTargetProc::addToGraph(PipelineGraph& graph, std::map<ProcInterface*, int>& nodes, int parent) {
+    auto found = nodes.find(this);
+    if (found != nodes.end()) {
+        return found->second;
+    }
+
+    const int index = FilterProcBase::addToGraph(graph, nodes, parent);
+
+    for (int i = 1; i < outputCount; i++) {
+        for (auto& subscriber : outputSubscribers[i - 1]) {
+            graph.addEdge(index, subscriber.first->addToGraph(graph, nodes, parent), PipelineGraph::kSubscriber, subscriber.second, 0, i);
+        }
+    }
+
+    return index;
+}
+
+void MultiTargetProc::prepareSubscribers(int index) {
+    FilterProcBase::prepareSubscribers(index);
+
+    for (int i = 1; i < outputCount; i++) {
+        for (auto& subscriber : outputSubscribers[i - 1]) {
+            subscriber.first->prepare(getOutFrameW(), getOutFrameH(), index + 1, subscriber.second);
+            subscriber.first->useTexture(getOutputTexId(i), getTextureUnit(), GL_TEXTURE_2D, subscriber.second);
+        }
+    }
+}
+
+void MultiTargetProc::processSubscribers(Logger logger) {
+    FilterProcBase::processSubscribers(logger);
+
+    for (int i = 1; i < outputCount; i++) {
+        for (auto& subscriber : outputSubscribers[i - 1]) {
+            subscriber.first->useTexture(getOutputTexId(i), getTextureUnit(), GL_TEXTURE_2D, subscriber.second);
+            subscriber.first->process(subscriber.second, logger);
+        }
+    }
+}
@@ -0,0 +1,115 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+/**
+ * Base class for filter processors with multiple render targets (MRT).
+ */
+#ifndef OGLES_GPGPU_COMMON_PROC_MULTITARGETPROC
+#define OGLES_GPGPU_COMMON_PROC_MULTITARGETPROC
+
+#include "../../common_includes.h"
+
+#include "filterprocbase.h"
+
+#include <vector>
+
+namespace ogles_gpgpu {
+
+/**
+ * Filter processor that renders to <outputCount> color attachments of its FBO in a single
+ * pass. The fragment shader writes gl_FragData[i] for each output i. Output 0 is the regular
+ * FBO texture (MemTransfer output), outputs 1..N-1 are additional textures of the same size.
+ *
+ * Subscribers added with add() receive output 0, subscribers added with addToOutput() receive
+ * the specified output.
+ *
+ * Requires OpenGL ES 3.0 or desktop OpenGL. On OpenGL ES 3.0 the shaders are compiled as
+ * GLSL ES 3.00 (see createShader()), since GLSL ES 1.00 has only a single color output.
+ */
+class MultiTargetProc : public FilterProcBase {
+public:
+    /**
+     * Constructor with number of color outputs <outputCount>.
+     */
+    MultiTargetProc(int outputCount = 2);
+
+    /**
+     * Deconstructor.
+     */
+    virtual ~MultiTargetProc();
+
+    /**
+     * Cleanup processor's resources.
+     */
+    virtual void cleanup();
+
+    /**
+     * Create the FBO output textures for all color attachments.
+     */
+    virtual void createFBOTex(bool genMipmap);
+
+    /**
+     * Return the number of color outputs.
+     */
+    int getOutputCount() const {
+        return outputCount;
+    }
+
+    using FilterProcBase::getOutputTexId;
+
+    /**
+     * Return the texture id of color output <output>.
+     */
+    GLuint getOutputTexId(int output) const;
+
+    /**
+     * Add a subscriber for color output <output>.
+     */
+    virtual void addToOutput(ProcInterface* filter, int output, int position = 0);
+
+    /**
+     * Read back the contents of color output <output> to <data> (synchronously).
+     */
+    virtual void getOutputData(int output, unsigned char* data) const;
+
+    /**
+     * Add the memory of the textures for all color outputs to <usage>.
+     */
+    virtual void addMemoryUsage(MemoryUsage& usage, std::set<ProcInterface*>& visited);
+
+    using FilterProcBase::getMemoryReport;
+    virtual void getMemoryReport(MemoryReport& report, std::set<ProcInterface*>& visited);
+
+    /**
+     * Add this processor and the subscribers of all outputs.
+     */
+    virtual int addToGraph(PipelineGraph& graph, std::map<ProcInterface*, int>& nodes, int parent);
+
+protected:
+    /**
+     * On OpenGL ES 3.0 the GLSL ES 1.00 style sources are translated to GLSL ES 3.00
+     * with one fragment output per color attachment.
+     */
+    virtual void adaptShaderSources(std::string& vShSrc, std::string& fShSrc, GLenum target);
+
+    virtual void prepareSubscribers(int index);
+    virtual void processSubscribers(Logger logger);
+
+    /**
+     * Release the textures for outputs 1..N-1.
+     */
+    void releaseOutputTextures();
+
+    int outputCount = 2;
+
+    std::vector<GLuint> outputTexIds; // texture ids for outputs 1..N-1
+    std::size_t outputTexBytes = 0; // memory of the textures for outputs 1..N-1
+
+    std::vector<std::vector<std::pair<ProcInterface*, int>>> outputSubscribers; // subscribers for outputs 1..N-1
+};
+}
+
+#endif
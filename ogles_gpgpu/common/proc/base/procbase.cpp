@@ -8,6 +8,7 @@
 //
 
 #include "procbase.h"
+#include "../../gl/shader_cache.h"
 
 #include <string>
 
@@ -73,6 +74,7 @@ const GLfloat ProcBase::quadVertices[] = {
 ProcBase::ProcBase() {
     texId = 0;
     texUnit = 1;
+    texTarget = GL_TEXTURE_2D;
     willDownscale = false;
 
     procParamOutW = procParamOutH = 0;
@@ -108,12 +110,16 @@ void ProcBase::printInfo() {
 
 void ProcBase::getResultData(unsigned char* data, int index) const {
     assert(fbo != NULL);
+    const bool reading = fbo->getMemTransfer()->isReadingAsynchronously(index);
     fbo->readBuffer(data, index);
+    trackResultFrame(index, reading, fbo->getMemTransfer()->isReadingAsynchronously(index));
 }
 
 void ProcBase::getResultData(const FrameDelegate& delegate, int index) const {
     assert(fbo != NULL);
+    const bool reading = fbo->getMemTransfer()->isReadingAsynchronously(index);
     fbo->readBuffer(delegate, index);
+    trackResultFrame(index, reading, fbo->getMemTransfer()->isReadingAsynchronously(index));
 }
 
 MemTransfer* ProcBase::getMemTransferObj() const {
@@ -125,12 +131,28 @@ void ProcBase::resizePBO(int count) const {
     fbo->getMemTransfer()->resizePBO(count);
 }
 
+void ProcBase::addMemoryUsage(MemoryUsage& usage, std::set<ProcInterface*>& visited) {
+    if (fbo && fbo->getMemTransfer()) {
+        fbo->getMemTransfer()->addMemoryUsage(usage);
+    }
+}
+
 GLuint ProcBase::getOutputTexId() const {
     assert(fbo != NULL);
 
     return fbo->getAttachedTexId();
 }
 
+bool ProcBase::setRenderTarget(GLuint texId) {
+    // platform specific zero copy readback is tied to the FBO texture
+    if (!fbo || fbo->getMemTransfer()->hasDirectTextureAccess()) {
+        return false;
+    }
+
+    fbo->setRenderTarget(texId);
+    return true;
+}
+
 void ProcBase::createFBOTex(bool genMipmap) {
     assert(fbo != NULL);
 
@@ -233,8 +255,19 @@ void ProcBase::createShader(const char* vShSrc, const char* fShSrc, GLenum targe
             return; // no change -> do nothing
     }
 
-    string fSrcStr(fShSrc);
+    string vSrcStr(vShSrc), fSrcStr(fShSrc);
+    adaptShaderSources(vSrcStr, fSrcStr, target);
+    shaderCost = ShaderCost::analyze(vSrcStr, fSrcStr);
+
+    // equal programs are linked once and shared
+    shader = ShaderCache::acquire(vSrcStr.c_str(), fSrcStr.c_str(), attributes);
 
+    assert(shader->getProgramId() > 0);
+
+    OG_LOGINF(getProcName(), "shader program %d ready", shader->getProgramId());
+}
+
+void ProcBase::adaptShaderSources(std::string& vShSrc, std::string& fShSrc, GLenum target) {
 #ifdef GL_TEXTURE_EXTERNAL_OES
     if (target == GL_TEXTURE_EXTERNAL_OES) { // other texture target than default "GL_TEXTURE_2D"
         // we need to modify the fragment shader source for correct texture access
@@ -243,19 +276,14 @@ void ProcBase::createShader(const char* vShSrc, const char* fShSrc, GLenum targe
         string newSrcReplacementNew = "uniform samplerExternalOES ";
 
         // replace
-        string oldSrc(fShSrc);
-        Tools::strReplaceAll(oldSrc, newSrcReplacementOld, newSrcReplacementNew);
+        Tools::strReplaceAll(fShSrc, newSrcReplacementOld, newSrcReplacementNew);
 
-        // prepend header
-        fSrcStr = string(newSrcHeader);
-        fSrcStr.append(oldSrc);
+        // prepend header (a #version directive must remain the first line)
+        if (fShSrc.compare(0, 8, "#version") == 0) {
+            fShSrc.insert(fShSrc.find('\n') + 1, newSrcHeader);
+        } else {
+            fShSrc.insert(0, newSrcHeader);
+        }
     }
 #endif
-
-    shader = std::unique_ptr<Shader>(new Shader);
-    bool compiled = shader->buildFromSrc(vShSrc, fSrcStr.c_str(), attributes);
-
-    assert(compiled);
-
-    OG_LOGINF(getProcName(), "shader compiled successfully");
 }
@@ -19,6 +19,7 @@
 #include "../../gl/fbo.h"
 #include "../../gl/memtransfer.h"
 #include "../../gl/shader.h"
+#include "../../gl/uniform.h"
 
 #include <memory>
 
@@ -174,6 +175,18 @@ public:
      */
     virtual void resizePBO(int count) const;
 
+    /**
+     * Add the memory of the FBO's MemTransfer object to <usage>.
+     */
+    virtual void addMemoryUsage(MemoryUsage& usage, std::set<ProcInterface*>& visited);
+
+    /**
+     * Return the static cost per output pixel of the shader program.
+     */
+    virtual ShaderCost getShaderCost() {
+        return shaderCost;
+    }
+
     /**
      * Return input texture id.
      */
@@ -186,6 +199,11 @@ public:
      */
     virtual GLuint getOutputTexId() const;
 
+    /**
+     * Render into texture <texId> instead of the FBO texture (0 : restore).
+     */
+    virtual bool setRenderTarget(GLuint texId);
+
     /**
      * Return the texture target (i.e., GL_TEXTURE_2D, ...)
      */
@@ -219,6 +237,12 @@ protected:
      */
     virtual void createShader(const char* vShSrc, const char* fShSrc, GLenum target, const Shader::Attributes& attributes = {});
 
+    /**
+     * Modify the shader sources <vShSrc> and <fShSrc> for texture target <target> before
+     * they are compiled (see createShader()).
+     */
+    virtual void adaptShaderSources(std::string& vShSrc, std::string& fShSrc, GLenum target);
+
     static const GLfloat quadTexCoordsStd[]; // default quad texture coordinates
     static const GLfloat quadTexCoordsStdMirrored[]; // default quad texture coordinates (mirrored)
     static const GLfloat quadTexCoordsFlipped[]; // flipped quad texture coordinates
@@ -229,7 +253,7 @@ protected:
     static const GLfloat quadVertices[]; // default quad vertices
 
     std::unique_ptr<FBO> fbo; // strong ref.!
-    std::unique_ptr<Shader> shader; // strong ref.!
+    std::shared_ptr<Shader> shader; // strong ref., shared with processors using the same program (see ShaderCache)
 
     unsigned int orderNum; // position of this processor in the pipeline
 
@@ -238,7 +262,7 @@ protected:
     GLuint texUnit; // input texture unit (glActiveTexture())
     GLenum texTarget; // input texture target
 
-    GLint shParamUInputTex; // shader uniform input texture sampler
+    Uniform<GLint> shParamUInputTex; // shader uniform input texture sampler
 
     int procParamOutW; // output frame width parameter
     int procParamOutH; // output frame height parameter
@@ -255,6 +279,8 @@ protected:
 
     int outFrameW = 0; // output frame width
     int outFrameH = 0; // output frame height
+
+    ShaderCost shaderCost; // static cost of the shader program (see ShaderCost::analyze())
 };
 }
 
@@ -1,4 +1,8 @@
 #include "procinterface.h"
+#include "../../gl/shader_cache.h"
+#include "../../latency.h"
+
+#include <chrono>
 
 using namespace ogles_gpgpu;
 
@@ -42,6 +46,14 @@ void ProcInterface::setActive(bool state) {
     active = state;
 }
 
+void ProcInterface::setGPUTiming(bool flag) {
+    if (!flag) {
+        gpuTimer.reset();
+    } else if (!gpuTimer) {
+        gpuTimer.reset(new GPUTimer);
+    }
+}
+
 void ProcInterface::add(ProcInterface* filter, int position) {
     subscribers.emplace_back(filter, position);
 }
@@ -70,7 +82,7 @@ void ProcInterface::process(GLuint id, GLuint useTexUnit, GLenum target, int ind
         Tools::checkGLErr(getProcName(), "useTexture");
     }
 
-    int result = render(position);
+    int result = renderTimed(position);
 
     if (m_postRenderCallback) {
         m_postRenderCallback(this);
@@ -80,10 +92,7 @@ void ProcInterface::process(GLuint id, GLuint useTexUnit, GLenum target, int ind
         logger(getFilterTag() + " end");
 
     if (result == 0) {
-        for (auto& subscriber : subscribers) {
-            subscriber.first->useTexture(getOutputTexId(), getTextureUnit(), GL_TEXTURE_2D, subscriber.second);
-            subscriber.first->process(subscriber.second, logger);
-        }
+        processSubscribers(logger);
     }
 
     if (m_postProcessCallback) {
@@ -105,7 +114,7 @@ void ProcInterface::process(int position, Logger logger) {
         m_preRenderCallback(this);
     }
 
-    int result = render(position);
+    int result = renderTimed(position);
 
     if (m_postRenderCallback) {
         m_postRenderCallback(this);
@@ -116,11 +125,7 @@ void ProcInterface::process(int position, Logger logger) {
 
     if (result == 0) {
         // Only trigger subscribers 1x (non active render() should return non-zero error code)
-        for (auto& subscriber : subscribers) {
-            // Update: FIFO and other filters may change the output texture id on each step:
-            subscriber.first->useTexture(getOutputTexId(), getTextureUnit(), GL_TEXTURE_2D, subscriber.second);
-            subscriber.first->process(subscriber.second, logger);
-        }
+        processSubscribers(logger);
     }
 
     if (m_postProcessCallback) {
@@ -128,12 +133,183 @@ void ProcInterface::process(int position, Logger logger) {
     }
 }
 
+int ProcInterface::renderTimed(int position) {
+    StageTimings::Scope scope(getStageName());
+
+    glCallCounts = {};
+    GLCounters::Scope calls(glCallCounts);
+
+    frameId = LatencyTracker::getCurrentFrameId();
+
+    const auto start = std::chrono::steady_clock::now();
+
+    int result;
+    if (!gpuTimer) {
+        result = render(position);
+    } else {
+        gpuTimer->collect(gpuTimingStats);
+
+        const bool timed = gpuTimer->begin();
+        result = render(position);
+        if (timed) {
+            gpuTimer->end();
+        }
+    }
+
+    renderTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    return result;
+}
+
+void ProcInterface::trackResultFrame(int index, bool wasReading, bool isReading) const {
+    if (isReading) {
+        readFrameIds[index] = frameId; // started an asynchronous read
+    } else if (wasReading) {
+        resultFrameId = readFrameIds[index]; // finished an asynchronous read
+        readFrameIds.erase(index);
+    } else {
+        resultFrameId = frameId;
+    }
+}
+
+void ProcInterface::updateRenderTarget() {
+    if (subscribers.empty()) {
+        return; // keep the render target of an enclosing multipass proc
+    }
+
+    GLuint target = 0;
+    for (auto& subscriber : subscribers) {
+        if ((target = subscriber.first->getInputRenderTarget(subscriber.second)) != 0) {
+            break;
+        }
+    }
+
+    setRenderTarget(target);
+}
+
+void ProcInterface::resetChain() {
+    std::set<ProcInterface*> visited;
+    resetChain(visited);
+}
+
+void ProcInterface::resetChain(std::set<ProcInterface*>& visited) {
+    if (!visited.insert(this).second) {
+        return;
+    }
+
+    reset();
+
+    for (auto& subscriber : subscribers) {
+        subscriber.first->resetChain(visited);
+    }
+}
+
+void ProcInterface::prefetchShaders() {
+    std::set<ProcInterface*> visited;
+    prefetchShaders(visited);
+}
+
+void ProcInterface::prefetchShaders(std::set<ProcInterface*>& visited) {
+    if (!visited.insert(this).second) {
+        return;
+    }
+
+    for (auto& subscriber : subscribers) {
+        subscriber.first->prefetchShaders(visited);
+    }
+}
+
+MemoryUsage ProcInterface::getMemoryUsage() {
+    MemoryUsage usage;
+    std::set<ProcInterface*> visited = { this };
+    addMemoryUsage(usage, visited);
+    return usage;
+}
+
+MemoryReport ProcInterface::getMemoryReport() {
+    MemoryReport report;
+    std::set<ProcInterface*> visited;
+    getMemoryReport(report, visited);
+    return report;
+}
+
+void ProcInterface::getMemoryReport(MemoryReport& report, std::set<ProcInterface*>& visited) {
+    if (!visited.insert(this).second) {
+        return;
+    }
+
+    MemoryUsage usage;
+    addMemoryUsage(usage, visited);
+    report.emplace_back(getStageName(), usage);
+
+    for (auto& subscriber : subscribers) {
+        subscriber.first->getMemoryReport(report, visited);
+    }
+}
+
+PipelineGraph ProcInterface::getGraph() {
+    PipelineGraph graph;
+    std::map<ProcInterface*, int> nodes;
+    addToGraph(graph, nodes, -1);
+    return graph;
+}
+
+int ProcInterface::addToGraph(PipelineGraph& graph, std::map<ProcInterface*, int>& nodes, int parent) {
+    auto found = nodes.find(this);
+    if (found != nodes.end()) {
+        return found->second;
+    }
+
+    PipelineGraph::Node node;
+    node.name = getStageName();
+    node.type = getProcName();
+    node.parent = parent;
+    node.width = getOutFrameW();
+    node.height = getOutFrameH();
+    node.format = MemoryUsage::getFormatName(getMemTransferObj()->getOutputInternalFormat());
+    node.bytes = getMemoryUsage().getTotal();
+    node.passes = 1;
+    const ShaderCost cost = getShaderCost();
+    const double pixels = double(node.width) * node.height;
+    node.fetches = cost.textureFetches;
+    node.dependentReads = cost.dependentReads;
+    node.aluOps = cost.aluOps;
+    node.varyings = cost.varyings;
+    node.precision = cost.precision;
+    node.fetchesPerFrame = node.fetches * pixels;
+    node.cost = cost.getCostPerPixel() * pixels;
+    node.cpuMs = renderTime;
+    node.gpuMs = gpuTimingStats.getCount() ? gpuTimingStats.getLast() : -1.0;
+    node.active = active;
+
+    const int index = graph.addNode(node);
+    nodes[this] = index;
+
+    // the subscribers of a pass are passes of the same processor
+    for (auto& subscriber : subscribers) {
+        graph.addEdge(index, subscriber.first->addToGraph(graph, nodes, parent), PipelineGraph::kSubscriber, subscriber.second);
+    }
+
+    return index;
+}
+
+void ProcInterface::processSubscribers(Logger logger) {
+    for (auto& subscriber : subscribers) {
+        // Update: FIFO and other filters may change the output texture id on each step:
+        subscriber.first->useTexture(getOutputTexId(), getTextureUnit(), GL_TEXTURE_2D, subscriber.second);
+        subscriber.first->process(subscriber.second, logger);
+    }
+}
+
 #define DO_MIPMAP_TEST 0
 
 // Top level filter chain preparation, set input format for first filter
 void ProcInterface::prepare(int inW, int inH, GLenum inFmt, int index, int position) {
     if (index == 0) {
         setExternalInputDataFormat(inFmt);
+
+        // submit all programs before the first status query (in init())
+        prefetchShaders();
     }
 
     // In case of multi-input textures, only (re)init for the first one
@@ -166,10 +342,11 @@ void ProcInterface::prepare(int inW, int inH, GLenum inFmt, int index, int posit
         // Create FBO for out single output texture
         createFBOTex(useMipmaps && willDownScale); // last one is false
 
-        for (auto& subscriber : subscribers) {
-            subscriber.first->prepare(getOutFrameW(), getOutFrameH(), index + 1, subscriber.second);
-            subscriber.first->useTexture(getOutputTexId(), getTextureUnit(), GL_TEXTURE_2D, subscriber.second);
-        }
+        prepareSubscribers(index);
+    }
+
+    if (index == 0) {
+        ShaderCache::releasePrefetched(); // programs that were not used by the graph
     }
 }
 
@@ -205,9 +382,13 @@ void ProcInterface::prepare(int inW, int inH, int index, int position) {
         // Create FBO for out single output texture
         createFBOTex(useMipmaps && willDownScale); // last one is false
 
-        for (auto& subscriber : subscribers) {
-            subscriber.first->prepare(getOutFrameW(), getOutFrameH(), index + 1, subscriber.second);
-            subscriber.first->useTexture(getOutputTexId(), getTextureUnit(), GL_TEXTURE_2D, subscriber.second);
-        }
+        prepareSubscribers(index);
+    }
+}
+
+void ProcInterface::prepareSubscribers(int index) {
+    for (auto& subscriber : subscribers) {
+        subscriber.first->prepare(getOutFrameW(), getOutFrameH(), index + 1, subscriber.second);
+        subscriber.first->useTexture(getOutputTexId(), getTextureUnit(), GL_TEXTURE_2D, subscriber.second);
     }
 }
@@ -14,10 +14,18 @@
 #define OGLES_GPGPU_COMMON_PROC_PROCINTERFACE
 
 #include "../../common_includes.h"
+#include "../../graph.h"
 
+#include "../../gl/call_counters.h"
 #include "../../gl/memtransfer.h"
+#include "../../gl/shader_cost.h"
+#include "../../gl/timer_query.h"
 
+#include <cstdint>
 #include <functional>
+#include <map>
+#include <memory>
+#include <set>
 
 BEGIN_OGLES_GPGPU
 
@@ -222,6 +230,22 @@ public:
      */
     virtual GLuint getOutputTexId() const = 0;
 
+    /**
+     * Render into texture <texId> (same size as the output) instead of the output texture.
+     * Pass 0 to restore the output texture. Returns false if this is not supported.
+     */
+    virtual bool setRenderTarget(GLuint texId) {
+        return false;
+    }
+
+    /**
+     * Return a texture that the producer for input <position> may render into directly
+     * instead of its output texture (i.e., the next FifoProc slot), or 0 if not applicable.
+     */
+    virtual GLuint getInputRenderTarget(int position) {
+        return 0;
+    }
+
     // ############ Begin filter chain methods ####################
 
     /**
@@ -249,6 +273,80 @@ public:
      */
     virtual void process(int position, Logger logger = {});
 
+    /**
+     * Discard the temporal state (i.e., frame history) of this processor, so that the
+     * next frame is processed like the first frame after prepare(). See resetChain().
+     */
+    virtual void reset() {}
+
+    /**
+     * Call reset() on this processor and on all processors connected to its output.
+     */
+    void resetChain();
+
+    /**
+     * Recursive helper for resetChain(), <visited> guards against feedback loops.
+     */
+    virtual void resetChain(std::set<ProcInterface*>& visited);
+
+    /**
+     * Submit the shader programs of this processor and of all processors connected to its
+     * output without waiting for the driver (see ShaderCache::prefetch()). prepare() calls
+     * this, so that the programs of a graph are compiled in parallel.
+     */
+    void prefetchShaders();
+
+    /**
+     * Recursive helper for prefetchShaders(), <visited> guards against feedback loops.
+     */
+    virtual void prefetchShaders(std::set<ProcInterface*>& visited);
+
+    /**
+     * Add the GPU memory held by this processor to <usage>: its output texture, the input
+     * texture and pixel buffer objects (if any) and, for multi-pass processors, the memory
+     * of all passes. <visited> guards against counting a pass twice.
+     */
+    virtual void addMemoryUsage(MemoryUsage& usage, std::set<ProcInterface*>& visited) {}
+
+    /**
+     * Get the GPU memory held by this processor (see addMemoryUsage()).
+     */
+    MemoryUsage getMemoryUsage();
+
+    /**
+     * Get the GPU memory held by this processor and by all processors connected to its
+     * output, with one entry per processor (see getStageName()).
+     */
+    MemoryReport getMemoryReport();
+
+    /**
+     * Recursive helper for getMemoryReport(), <visited> guards against feedback loops.
+     */
+    virtual void getMemoryReport(MemoryReport& report, std::set<ProcInterface*>& visited);
+
+    /**
+     * Get the graph of this processor and of all processors connected to its output,
+     * including the passes of multi-pass processors and the delayed outputs of FifoProc,
+     * with the size, memory, passes, texture fetches and last times of each processor
+     * (see PipelineGraph). Call it after prepare().
+     */
+    PipelineGraph getGraph();
+
+    /**
+     * Recursive helper for getGraph(): add this processor with parent <parent> (-1: none)
+     * and all processors connected to its output to <graph>, unless it is in <nodes>
+     * already. Returns the node index of this processor.
+     */
+    virtual int addToGraph(PipelineGraph& graph, std::map<ProcInterface*, int>& nodes, int parent);
+
+    /**
+     * Get the static cost per output pixel of the shader of this processor (see
+     * ShaderCost::analyze()), zero for processors without an own shader.
+     */
+    virtual ShaderCost getShaderCost() {
+        return ShaderCost();
+    }
+
     /**
      * Allow this proc to use mipmaps
      */
@@ -291,12 +389,95 @@ public:
      */
     virtual void setPostInitCallback(const ProcDelegate& cb);
 
+    /**
+     * Measure the GPU time of render() in process() with timer queries (see GPUTimer).
+     * The results are read back a few frames late and are ignored where timer queries
+     * are not supported. Passes of a multipass processor are covered by its own time.
+     */
+    virtual void setGPUTiming(bool flag);
+
+    /**
+     * Get the GPU time statistics of render() in ms (see setGPUTiming()).
+     */
+    const TimingStats& getGPUTimingStats() const {
+        return gpuTimingStats;
+    }
+
+    /**
+     * Get the CPU time of the last render() in process() in ms, -1 if it was not rendered.
+     */
+    double getRenderTime() const {
+        return renderTime;
+    }
+
+    /**
+     * Get the name of this processor in StageTimings (the title if set, otherwise the name).
+     */
+    virtual const char* getStageName() {
+        return title.empty() ? getProcName() : title.c_str();
+    }
+
+    /**
+     * Get the OpenGL calls of the last render() in process(), if counting is enabled
+     * (see GLCounters). Passes of a multipass processor are covered by its own counts.
+     */
+    const GLCallCounts& getGLCallCounts() const {
+        return glCallCounts;
+    }
+
+    /**
+     * Get the id of the frame in the output of this processor (see FrameInput::frameId),
+     * 0 if it was not rendered for a frame of a VideoSource.
+     */
+    std::uint64_t getFrameId() const {
+        return frameId;
+    }
+
+    /**
+     * Get the id of the frame whose data the last getResultData() call delivered. This is
+     * the frame of the call that started an asynchronous read (see MemTransfer::fromGPU()),
+     * i.e. for LatencyTracker::complete().
+     */
+    std::uint64_t getResultFrameId() const {
+        return resultFrameId;
+    }
+
+    /**
+     * Call render(), measuring its GPU time if enabled (see setGPUTiming()), its wall
+     * clock time as stage getStageName() (see StageTimings and getRenderTime()) and its
+     * OpenGL calls (see getGLCallCounts()), and take the frame id of the current frame.
+     */
+    int renderTimed(int position = 0);
+
 protected:
+    /**
+     * Update getResultFrameId() after a getResultData() call with PBO <index>, where
+     * <wasReading> and <isReading> tell if an asynchronous read was running before and
+     * after the call (see MemTransfer::isReadingAsynchronously()).
+     */
+    void trackResultFrame(int index, bool wasReading, bool isReading) const;
+
     /**
      * Get a formatted/unique filter tag
      */
     virtual std::string getFilterTag();
 
+    /**
+     * Prepare all subscribers for the output of this processor at pipeline position <index>.
+     */
+    virtual void prepareSubscribers(int index);
+
+    /**
+     * Pass the output of this processor on to all subscribers and process them.
+     */
+    virtual void processSubscribers(Logger logger);
+
+    /**
+     * Render into a texture provided by a subscriber, if any (see getInputRenderTarget()).
+     * Must be called right before drawing, since it changes the output texture id.
+     */
+    void updateRenderTarget();
+
     bool useMipmaps = false; // TODO:
 
     std::string title;
@@ -315,6 +496,16 @@ protected:
 
     ProcDelegate m_preInitCallback;
     ProcDelegate m_postInitCallback;
+
+    std::unique_ptr<GPUTimer> gpuTimer; // set if GPU timing is enabled
+    TimingStats gpuTimingStats;
+    double renderTime = -1.0; // CPU time of the last render() in ms
+
+    GLCallCounts glCallCounts; // calls of the last render()
+
+    std::uint64_t frameId = 0; // frame of the last render()
+    mutable std::uint64_t resultFrameId = 0; // frame of the last getResultData()
+    mutable std::map<int, std::uint64_t> readFrameIds; // frames of the pending asynchronous reads by PBO index
 };
 
 END_OGLES_GPGPU
@@ -17,6 +17,8 @@ sugar_files(
     filterprocbase.h
     multipassproc.cpp
     multipassproc.h
+    multitargetproc.cpp
+    multitargetproc.h
     procbase.cpp
     procbase.h
     procinterface.cpp
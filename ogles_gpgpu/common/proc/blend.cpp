@@ -38,12 +38,12 @@ BlendProc::BlendProc(float alpha)
 
 void BlendProc::getUniforms() {
     TwoInputProc::getUniforms();
-    shParamUAlpha = shader->getParam(UNIF, "alpha");
+    shParamUAlpha.init(shader.get(), "alpha");
 }
 
 void BlendProc::setUniforms() {
     TwoInputProc::setUniforms();
-    glUniform1f(shParamUAlpha, alpha);
+    shParamUAlpha.set(alpha);
 }
 
 int BlendProc::render(int position) {
@@ -28,7 +28,7 @@ public:
     virtual int render(int position = 0);
 
 private:
-    GLint shParamUAlpha;
+    Uniform<GLfloat> shParamUAlpha;
     GLfloat alpha = 0.5f;
 
     virtual const char* getFragmentShaderSource() {
@@ -38,14 +38,14 @@ DiffProc::DiffProc(float strength, float offset)
 
 void DiffProc::getUniforms() {
     TwoInputProc::getUniforms();
-    shParamUStrength = shader->getParam(UNIF, "strength");
-    shParamUOffset = shader->getParam(UNIF, "offset");
+    shParamUStrength.init(shader.get(), "strength");
+    shParamUOffset.init(shader.get(), "offset");
 }
 
 void DiffProc::setUniforms() {
     TwoInputProc::setUniforms();
-    glUniform1f(shParamUStrength, strength);
-    glUniform1f(shParamUOffset, offset);
+    shParamUStrength.set(strength);
+    shParamUOffset.set(offset);
 }
 
 int DiffProc::render(int position) {
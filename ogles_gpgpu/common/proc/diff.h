@@ -34,8 +34,8 @@ public:
     virtual int render(int position = 0);
 
 private:
-    GLuint shParamUStrength;
-    GLuint shParamUOffset;
+    Uniform<GLfloat> shParamUStrength;
+    Uniform<GLfloat> shParamUOffset;
     float strength;
     float offset;
     virtual const char* getVertexShaderSource() {
@@ -41,6 +41,7 @@ Disp::~Disp()
     if (renderbufferStorage)
     {
         glDeleteRenderbuffers(1, &renderbuffer);
+        GPUMemory::release(renderbufferBytes);
     }
 }
 
@@ -104,6 +105,15 @@ void Disp::createFBO()
     
         renderbufferStorage();
         Tools::checkGLErr(getProcName(), "renderbufferStorage");
+
+        GLint width = 0, height = 0, internalFormat = 0;
+        glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_WIDTH, &width);
+        glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_HEIGHT, &height);
+        glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_INTERNAL_FORMAT, &internalFormat);
+
+        GPUMemory::release(renderbufferBytes);
+        renderbufferBytes = static_cast<std::size_t>(width) * height * MemoryUsage::getBytesPerPixel(internalFormat);
+        GPUMemory::allocate(renderbufferBytes);
         
         glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffer);
         Tools::checkGLErr(getProcName(), "glFramebufferRenderbuffer");
@@ -116,3 +126,8 @@ void Disp::createFBO()
         }
     }
 }
+
+void Disp::addMemoryUsage(MemoryUsage& usage, std::set<ProcInterface*>& visited) {
+    FilterProcBase::addMemoryUsage(usage, visited);
+    usage.renderbuffers += renderbufferBytes;
+}
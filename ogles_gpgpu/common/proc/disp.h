@@ -74,6 +74,13 @@ public:
         return "Disp";
     }
 
+    /**
+     * Display stage in StageTimings.
+     */
+    virtual const char* getStageName() {
+        return "display";
+    }
+
     /**
      * Init the processor for input frames of size <inW>x<inH> which is at
      * position <order> in the processing pipeline.
@@ -113,6 +120,11 @@ public:
      * (optional) create renderbuffer if renderbufferStorage callback was specified in constructor.
      */
     virtual void createFBO();
+
+    /**
+     * Add the memory of the renderbuffer (if any) to <usage>.
+     */
+    virtual void addMemoryUsage(MemoryUsage& usage, std::set<ProcInterface*>& visited);
     
 private:
     float tx = 0.f;
@@ -123,6 +135,7 @@ private:
     static const char* fshaderDispSrc; // fragment shader source
     
     GLuint renderbuffer; // (optional) renderbuffer based display
+    std::size_t renderbufferBytes = 0; // memory of the renderbuffer
     Callback renderbufferStorage;
 };
 }
@@ -27,14 +27,14 @@ private:
         return fshaderNoopSrc;
     }
     virtual void getUniforms() {
-        shParamUGain = shader->getParam(UNIF, "gain");
+        shParamUGain.init(shader.get(), "gain");
     }
     virtual void setUniforms() {
-        glUniform1f(shParamUGain, gain);
+        shParamUGain.set(gain);
     }
     static const char* fshaderNoopSrc; // fragment shader source
     float gain = 1.f;
-    GLint shParamUGain;
+    Uniform<GLfloat> shParamUGain;
 };
 
 // clang-format off
@@ -62,7 +62,7 @@ static int modulo(int a, int b) {
 
 FifoProc::FifoProc(int size) {
     m_inputIndex = m_outputIndex = 0;
-    for (int i = 0; i < size; i++) {
+    for (int i = 0; i < (size + 1); i++) {
         procPasses.push_back(new NoopProc);
     }
 
@@ -82,6 +82,14 @@ void FifoProc::addWithDelay(ProcInterface* filter, int position, int time) {
     delayedSubscribers[time].emplace_back(filter, position);
 }
 
+GLuint FifoProc::getInputRenderTarget(int position) {
+    auto slot = getInputFilter();
+    if (!active || (slot->getInFrameSize() != slot->getOutFrameSize())) {
+        return 0; // the copy pass also rescales
+    }
+    return slot->getOutputTexId();
+}
+
 void FifoProc::prepare(int inW, int inH, int index, int position) {
     assert(position == 0);
     ProcInterface::prepare(inW, inH, index, position);
@@ -95,6 +103,70 @@ void FifoProc::prepare(int inW, int inH, int index, int position) {
     }
 }
 
+void FifoProc::resetChain(std::set<ProcInterface*>& visited) {
+    ProcInterface::resetChain(visited);
+
+    for (auto& subscribers : delayedSubscribers) {
+        for (auto& subscriber : subscribers) {
+            subscriber.first->resetChain(visited);
+        }
+    }
+}
+
+void FifoProc::prefetchShaders(std::set<ProcInterface*>& visited) {
+    MultiProcInterface::prefetchShaders(visited);
+
+    for (auto& subscribers : delayedSubscribers) {
+        for (auto& subscriber : subscribers) {
+            subscriber.first->prefetchShaders(visited);
+        }
+    }
+}
+
+void FifoProc::addMemoryUsage(MemoryUsage& usage, std::set<ProcInterface*>& visited) {
+    MemoryReport slots;
+    for (auto& slot : procPasses) {
+        slot->getMemoryReport(slots, visited);
+    }
+
+    usage += getTotal(slots);
+}
+
+void FifoProc::getMemoryReport(MemoryReport& report, std::set<ProcInterface*>& visited) {
+    MultiProcInterface::getMemoryReport(report, visited);
+
+    for (auto& subscribers : delayedSubscribers) {
+        for (auto& subscriber : subscribers) {
+            subscriber.first->getMemoryReport(report, visited);
+        }
+    }
+}
+
+int FifoProc::addToGraph(PipelineGraph& graph, std::map<ProcInterface*, int>& nodes, int parent) {
+    auto found = nodes.find(this);
+    if (found != nodes.end()) {
+        return found->second;
+    }
+
+    const int index = ProcInterface::addToGraph(graph, nodes, parent);
+
+    // the newest slot has the output of the producer as input, unless it was copied (see render())
+    auto newest = m_count ? (*this)[m_count - 1] : nullptr;
+    if (newest && newest->getInputTexId() == newest->getOutputTexId()) {
+        graph.getNodes()[index].passes = 0;
+        graph.getNodes()[index].fetchesPerFrame = 0.0;
+        graph.getNodes()[index].cost = 0.0;
+    }
+
+    for (std::size_t i = 0; i < delayedSubscribers.size(); i++) {
+        for (auto& subscriber : delayedSubscribers[i]) {
+            graph.addEdge(index, subscriber.first->addToGraph(graph, nodes, parent), PipelineGraph::kDelayed, subscriber.second, i);
+        }
+    }
+
+    return index;
+}
+
 void FifoProc::process(int position, Logger logger) {
     assert(position == 0);
     ProcInterface::process(position, logger);
@@ -165,40 +237,35 @@ void FifoProc::createFBOTex(bool genMipmap) {
     }
 }
 
+// Example for size 2 (3 slots), the producer renders into slot I:
+//
 // 0 : [0][ ][ ]
-//     [I][ ][ ]
-//     [O][ ][ ]
+//     [O][I][ ]
 //
 // 1 : [0][1][ ]
-//     [ ][I][ ]
-//     [O][ ][ ]
+//     [O][ ][I]
 //
 // 2 : [0][1][2]
-//     [ ][ ][I]
-//     [O][ ][ ]
+//     [I][O][ ]
 //
 // 3 : [3][1][2]
-//     [I][ ][ ]
-//     [ ][O][ ]
+//     [ ][I][O]
 //
 // 4 : [3][4][2]
-//     [ ][I][ ]
-//     [ ][ ][O]
-//
-// 5 : [3][4][5]
-//     [O][ ][ ]
-//     [ ][ ][I]
+//     [O][ ][I]
 
 int FifoProc::render(int position) {
-    // Render into input FBO
-    if (m_count == int(size())) {
-        m_outputIndex = modulo(static_cast<int>(m_inputIndex) + 1, static_cast<int>(size()));
-    }
+    auto slot = getInputFilter();
 
-    getInputFilter()->render();
+    // Copy only if the producer didn't render into the input slot already:
+    if (slot->getInputTexId() != slot->getOutputTexId()) {
+        slot->render();
+    }
 
+    const int slots = static_cast<int>(procPasses.size());
     m_count = std::min(m_count + 1, int(size()));
-    m_inputIndex = modulo(static_cast<int>(m_inputIndex) + 1, static_cast<int>(size()));
+    m_inputIndex = modulo(m_inputIndex + 1, slots);
+    m_outputIndex = modulo(m_inputIndex - m_count, slots);
 
     return 0;
 }
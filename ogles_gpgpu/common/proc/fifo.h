@@ -15,6 +15,13 @@
 
 BEGIN_OGLES_GPGPU
 
+// Ring buffer of the last <size> input frames.
+//
+// The ring holds one more slot than the visible history: the producer renders its
+// next frame directly into that spare slot (see getInputRenderTarget()), so render()
+// only has to advance the ring. A copy pass is used when the input cannot be
+// redirected (i.e., external input or platform optimized output textures).
+
 class FifoProc : public MultiProcInterface {
 public:
     FifoProc(int size = 2);
@@ -42,7 +49,7 @@ public:
     virtual ProcInterface* getOutputFilter() const;
     virtual ProcInterface* operator[](int i) const;
     virtual size_t size() const {
-        return procPasses.size();
+        return procPasses.size() - 1; // minus the spare input slot
     }
 
     virtual int getIn() const;
@@ -50,8 +57,14 @@ public:
 
     virtual void addWithDelay(ProcInterface* filter, int position = 0, int time = 0);
 
+    virtual bool setRenderTarget(GLuint texId) {
+        return false;
+    }
+    virtual GLuint getInputRenderTarget(int position);
+
     /**
-     * Return te list of processor instances of each pass of this multipass processor.
+     * Return te list of processor instances of each pass of this multipass processor
+     * (including the spare input slot).
      */
     std::vector<ProcInterface*>& getProcPasses() {
         return procPasses;
@@ -70,6 +83,31 @@ public:
         m_inputIndex = m_outputIndex = m_count = 0;
     }
 
+    using ProcInterface::resetChain;
+    virtual void resetChain(std::set<ProcInterface*>& visited);
+
+    using ProcInterface::prefetchShaders;
+    virtual void prefetchShaders(std::set<ProcInterface*>& visited);
+
+    /**
+     * Add the memory of all slots (including the spare input slot) to <usage>.
+     */
+    virtual void addMemoryUsage(MemoryUsage& usage, std::set<ProcInterface*>& visited);
+
+    using ProcInterface::getMemoryReport;
+    virtual void getMemoryReport(MemoryReport& report, std::set<ProcInterface*>& visited);
+
+    /**
+     * Add this processor (without its slots) and its subscribers, including the delayed
+     * ones. It renders one copy pass per frame, unless the producer renders into the
+     * input slot directly.
+     */
+    virtual int addToGraph(PipelineGraph& graph, std::map<ProcInterface*, int>& nodes, int parent);
+
+    virtual ShaderCost getShaderCost() {
+        return getInputFilter()->getShaderCost();
+    }
+
 protected:
     virtual void prepare(int inW, int inH, int index = 0, int position = 0);
     virtual void process(int position, Logger logger = {});
@@ -8,22 +8,73 @@
 
 #include "filter3x3.h"
 #include "../common_includes.h"
+#include "../gl/caps.h"
 
 using namespace std;
 using namespace ogles_gpgpu;
 
+// clang-format off
+const char *Filter3x3Proc::vshaderFilter3x3TexelFetchSrc =
+OG_GLSL3_VERSION
+OG_TO_STR(
+in vec4 position;
+in vec4 inputTextureCoordinate;
+out vec2 textureCoordinate;
+void main() {
+    gl_Position = position;
+    textureCoordinate = inputTextureCoordinate.xy;
+});
+// clang-format on
+
 Filter3x3Proc::Filter3x3Proc() {
 }
 
+bool Filter3x3Proc::useTexelFetch() const {
+    // the output size is known before init(), as the shaders are prefetched before
+    const bool unscaled = (procParamOutW == 0 && procParamOutH == 0 && procParamOutScale == 1.0f);
+    return texelFetch && hasTexelFetchShader() && unscaled && texTarget == GL_TEXTURE_2D && GLCaps::get().glsl3Shaders;
+}
+
+int Filter3x3Proc::reinit(int inW, int inH, bool prepareForExternalInput) {
+    int result = FilterProcBase::reinit(inW, inH, prepareForExternalInput);
+
+    if (shader && useTexelFetch() != texelFetchActive) {
+        shader.reset();
+        filterShaderSetup(getVertexShaderSource(), getFragmentShaderSource(), texTarget);
+        getUniforms();
+    }
+
+    return result;
+}
+
+void Filter3x3Proc::useTexture(GLuint id, GLuint useTexUnit, GLenum target, int position) {
+    if (shader && target != texTarget) {
+        // the cached sources may be the GLSL 3 texelFetch() variant for GL_TEXTURE_2D
+        texTarget = target;
+        shader.reset();
+        filterShaderSetup(getVertexShaderSource(), getFragmentShaderSource(), texTarget);
+        getUniforms();
+    }
+
+    FilterProcBase::useTexture(id, useTexUnit, target, position);
+}
+
 void Filter3x3Proc::filterShaderSetup(const char* vShaderSrc, const char* fShaderSrc, GLenum target) {
     // create shader object
     ProcBase::createShader(vShaderSrc, fShaderSrc, target);
 
+    texelFetchActive = (vShaderSrc == vshaderFilter3x3TexelFetchSrc);
+
     // get shader params
     shParamAPos = shader->getParam(ATTR, "position");
     shParamATexCoord = shader->getParam(ATTR, "inputTextureCoordinate");
-    texelWidthUniform = shader->getParam(UNIF, "texelWidth");
-    texelHeightUniform = shader->getParam(UNIF, "texelHeight");
+    if (texelFetchActive) { // no texel steps
+        texelWidthUniform = Uniform<GLfloat>();
+        texelHeightUniform = Uniform<GLfloat>();
+    } else {
+        texelWidthUniform.init(shader.get(), "texelWidth");
+        texelHeightUniform.init(shader.get(), "texelHeight");
+    }
 
     Tools::checkGLErr(getProcName(), "filterShaderSetup");
 }
@@ -33,6 +84,6 @@ void Filter3x3Proc::getUniforms() {
 
 void Filter3x3Proc::setUniforms() {
     // Set texel width/height uniforms:
-    glUniform1f(texelWidthUniform, (1.0f / float(outFrameW)));
-    glUniform1f(texelHeightUniform, (1.0f / float(outFrameH)));
+    texelWidthUniform.set((1.0f / float(outFrameW)));
+    texelHeightUniform.set((1.0f / float(outFrameH)));
 }
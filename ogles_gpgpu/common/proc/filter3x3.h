@@ -12,6 +12,39 @@
 #include "../common_includes.h"
 
 #include "base/filterprocbase.h"
+#include "../gl/shader_variant.h"
+
+// Fragment shader declarations for the 3x3 neighborhood of textureCoordinate, followed by
+// the shader body: OG_TEXEL(coord, dx, dy) reads the neighbour at pixel offset (dx, dy),
+// which is the varying <coord> of vshaderFilter3x3Src, and OG_FRAG_COLOR is the output.
+
+// GLSL ES 1.00: interpolated texture coordinates
+#define OGLES_GPGPU_FILTER3X3_FSH_HEADER                                                 \
+    OG_GLSL_PRECISION(highp)                                                             \
+    "uniform sampler2D inputImageTexture;\n"                                             \
+    "varying vec2 textureCoordinate;\n"                                                  \
+    "varying vec2 leftTextureCoordinate;\n"                                              \
+    "varying vec2 rightTextureCoordinate;\n"                                             \
+    "varying vec2 topTextureCoordinate;\n"                                               \
+    "varying vec2 topLeftTextureCoordinate;\n"                                           \
+    "varying vec2 topRightTextureCoordinate;\n"                                          \
+    "varying vec2 bottomTextureCoordinate;\n"                                            \
+    "varying vec2 bottomLeftTextureCoordinate;\n"                                        \
+    "varying vec2 bottomRightTextureCoordinate;\n"                                       \
+    "#define OG_TEXEL(coord, dx, dy) texture2D(inputImageTexture, coord)\n"              \
+    "#define OG_FRAG_COLOR gl_FragColor\n"
+
+// GLSL ES 3.00 / GLSL 3.30 (after OG_GLSL3_VERSION): exact texel reads, clamped to the
+// edge like the texture wrap mode
+#define OGLES_GPGPU_FILTER3X3_FSH_HEADER_TEXEL_FETCH                                     \
+    OG_GLSL_PRECISION(highp)                                                             \
+    "uniform sampler2D inputImageTexture;\n"                                             \
+    "in vec2 textureCoordinate;\n"                                                       \
+    "out vec4 og_FragColor;\n"                                                           \
+    "#define OG_SIZE textureSize(inputImageTexture, 0)\n"                                \
+    "#define OG_TEXEL(coord, dx, dy) texelFetch(inputImageTexture, "                     \
+    "clamp(ivec2(textureCoordinate * vec2(OG_SIZE)) + ivec2(dx, dy), ivec2(0), OG_SIZE - 1), 0)\n" \
+    "#define OG_FRAG_COLOR og_FragColor\n"
 
 namespace ogles_gpgpu {
 
@@ -33,12 +66,41 @@ public:
     }
 
     /**
-     * Get the fragment shader source.
+     * Get the vertex shader source.
      */
     virtual const char* getVertexShaderSource() {
-        return vshaderFilter3x3Src;
+        return useTexelFetch() ? vshaderFilter3x3TexelFetchSrc : vshaderFilter3x3Src;
     }
 
+    /**
+     * Reinitialize, i.e. switch between texelFetch() and interpolated reads if the
+     * output size changed.
+     */
+    virtual int reinit(int inW, int inH, bool prepareForExternalInput = false);
+
+    /**
+     * Use texture id <id> as input texture at texture <useTexUnit> with texture target
+     * <target>. A change of the target selects the shaders again, as texelFetch() reads
+     * only apply to GL_TEXTURE_2D.
+     */
+    virtual void useTexture(GLuint id, GLuint useTexUnit = 1, GLenum target = GL_TEXTURE_2D, int position = 0);
+
+    /**
+     * Read the 3x3 neighborhood with texelFetch() where the processor and the OpenGL
+     * context support it (default: true). The reads are exact and no varyings are needed
+     * for the neighbour coordinates. Only applies to GL_TEXTURE_2D input with an output
+     * of input size, as the interpolated reads use output pixel steps.
+     * Must be called before init().
+     */
+    void setTexelFetch(bool flag) {
+        texelFetch = flag;
+    }
+
+    /**
+     * Check if the 3x3 neighborhood is read with texelFetch() (see setTexelFetch()).
+     */
+    bool useTexelFetch() const;
+
     /**
      * Set additional uniforms.
      */
@@ -55,25 +117,30 @@ public:
     virtual void filterShaderSetup(const char* vShaderSrc, const char* fShaderSrc, GLenum target);
 
     void setTexelWidth(float width) {
-        hasOverriddenImageSizeFactor = true;
         texelWidth = width;
     }
 
     void setTexelHeight(float height) {
-        hasOverriddenImageSizeFactor = true;
         texelHeight = height;
     }
 
-    void reset() {
-        hasOverriddenImageSizeFactor = false;
+protected:
+    /**
+     * Return true if the processor has a GLSL 3 fragment shader with
+     * OGLES_GPGPU_FILTER3X3_FSH_HEADER_TEXEL_FETCH (see setTexelFetch()).
+     */
+    virtual bool hasTexelFetchShader() const {
+        return false;
     }
 
-protected:
-    bool hasOverriddenImageSizeFactor = false;
-    GLint texelWidthUniform, texelHeightUniform;
+    bool texelFetch = true;
+    bool texelFetchActive = false; // shader of the last filterShaderSetup() uses texelFetch()
+
+    Uniform<GLfloat> texelWidthUniform, texelHeightUniform;
     float texelWidth, texelHeight;
 
     static const char* fshaderFilter3x3Src; // fragment shader source
+    static const char* vshaderFilter3x3TexelFetchSrc; // vertex shader source for texelFetch() reads
 };
 }
 
@@ -78,27 +78,27 @@ void Fir3Proc::getUniforms() {
     ThreeInputProc::getUniforms();
 
     if (doRgb) {
-        shParamUWeights1 = shader->getParam(UNIF, "weights1");
-        shParamUWeights2 = shader->getParam(UNIF, "weights2");
-        shParamUWeights3 = shader->getParam(UNIF, "weights3");
+        shParamUWeights1.init(shader.get(), "weights1");
+        shParamUWeights2.init(shader.get(), "weights2");
+        shParamUWeights3.init(shader.get(), "weights3");
     } else {
-        shParamUWeights = shader->getParam(UNIF, "weights");
+        shParamUWeights.init(shader.get(), "weights");
     }
 
-    shParamUAlpha = shader->getParam(UNIF, "alpha");
-    shParamUBeta = shader->getParam(UNIF, "beta");
+    shParamUAlpha.init(shader.get(), "alpha");
+    shParamUBeta.init(shader.get(), "beta");
 }
 
 void Fir3Proc::setUniforms() {
     ThreeInputProc::setUniforms();
     if (doRgb) {
-        glUniform3fv(shParamUWeights1, 1, &weightsRGB[0].data[0]);
-        glUniform3fv(shParamUWeights2, 1, &weightsRGB[1].data[0]);
-        glUniform3fv(shParamUWeights3, 1, &weightsRGB[2].data[0]);
+        shParamUWeights1.set(weightsRGB[0]);
+        shParamUWeights2.set(weightsRGB[1]);
+        shParamUWeights3.set(weightsRGB[2]);
     } else {
-        glUniform3fv(shParamUWeights, 1, &weights.data[0]);
+        shParamUWeights.set(weights);
     }
 
-    glUniform1f(shParamUAlpha, alpha);
-    glUniform1f(shParamUBeta, beta);
+    shParamUAlpha.set(alpha);
+    shParamUBeta.set(beta);
 }
@@ -56,17 +56,17 @@ public:
 private:
     bool doRgb = false;
 
-    GLint shParamUWeights;
-    GLint shParamUAlpha;
-    GLint shParamUBeta;
+    Uniform<Vec3f> shParamUWeights;
+    Uniform<GLfloat> shParamUAlpha;
+    Uniform<GLfloat> shParamUBeta;
     Vec3f weights;
 
     float alpha = 1.f;
     float beta = 0.f;
 
-    GLint shParamUWeights1;
-    GLint shParamUWeights2;
-    GLint shParamUWeights3;
+    Uniform<Vec3f> shParamUWeights1;
+    Uniform<Vec3f> shParamUWeights2;
+    Uniform<Vec3f> shParamUWeights3;
     Vec3f weightsRGB[3];
 
     virtual const char* getFragmentShaderSource() {
@@ -38,21 +38,21 @@ void FlowProc::filterShaderSetup(const char* vShaderSrc, const char* fShaderSrc,
 
 void FlowProc::getUniforms() {
     FilterProcBase::getUniforms();
-    texelWidthUniform = shader->getParam(UNIF, "texelWidth");
-    texelHeightUniform = shader->getParam(UNIF, "texelHeight");
-    shParamUInputTex = shader->getParam(UNIF, "inputImageTexture");
-    shParamUStrength = shader->getParam(UNIF, "strength");
-    shParamUTau = shader->getParam(UNIF, "tau");
+    texelWidthUniform.init(shader.get(), "texelWidth");
+    texelHeightUniform.init(shader.get(), "texelHeight");
+    shParamUInputTex.init(shader.get(), "inputImageTexture");
+    shParamUStrength.init(shader.get(), "strength");
+    shParamUTau.init(shader.get(), "tau");
 }
 
 void FlowProc::setUniforms() {
     FilterProcBase::setUniforms();
 
     const float offset = 1.0f;
-    glUniform1f(texelWidthUniform, (offset / float(outFrameW)));
-    glUniform1f(texelHeightUniform, (offset / float(outFrameH)));
-    glUniform1f(shParamUStrength, strength);
-    glUniform1f(shParamUTau, tau);
+    texelWidthUniform.set((offset / float(outFrameW)));
+    texelHeightUniform.set((offset / float(outFrameH)));
+    shParamUStrength.set(strength);
+    shParamUTau.set(tau);
 }
 
 // Solve 2x2 matrix inverse via Cramer's rule:
@@ -202,7 +202,9 @@ FlowPipeline::FlowPipeline(float tau, float strength, bool doGray) {
     procPasses.push_back(&m_pImpl->gaussProc);
     procPasses.push_back(&m_pImpl->flowProc);
 };
-FlowPipeline::~FlowPipeline() {}
+FlowPipeline::~FlowPipeline() {
+    procPasses.clear();
+}
 float FlowPipeline::getStrength() const {
     return m_pImpl->flowProc.getStrength();
 }
@@ -242,13 +244,13 @@ void FlowImplProc::filterShaderSetup(const char* vShaderSrc, const char* fShader
 
 void FlowImplProc::getUniforms() {
     FilterProcBase::getUniforms();
-    shParamUInputTex = shader->getParam(UNIF, "inputImageTexture");
-    shParamUStrength = shader->getParam(UNIF, "strength");
+    shParamUInputTex.init(shader.get(), "inputImageTexture");
+    shParamUStrength.init(shader.get(), "strength");
 }
 
 void FlowImplProc::setUniforms() {
     FilterProcBase::setUniforms();
-    glUniform1f(shParamUStrength, strength);
+    shParamUStrength.set(strength);
 }
 
 // clang-format off
@@ -291,6 +293,52 @@ OG_TO_STR(
  });
 // clang-format on
 
+// ====================================================
+// ===== Both tensor outputs in one pass (MRT) ========
+// ====================================================
+
+FlowImplXYProc::FlowImplXYProc(float strength)
+    : MultiTargetProc(2)
+    , strength(strength) {
+}
+
+void FlowImplXYProc::filterShaderSetup(const char* vShaderSrc, const char* fShaderSrc, GLenum target) {
+    createShader(vShaderSrc, fShaderSrc, target);
+    shParamAPos = shader->getParam(ATTR, "position");
+    shParamATexCoord = shader->getParam(ATTR, "inputTextureCoordinate");
+}
+
+void FlowImplXYProc::getUniforms() {
+    MultiTargetProc::getUniforms();
+    shParamUInputTex.init(shader.get(), "inputImageTexture");
+    shParamUStrength.init(shader.get(), "strength");
+}
+
+void FlowImplXYProc::setUniforms() {
+    MultiTargetProc::setUniforms();
+    shParamUStrength.set(strength);
+}
+
+// clang-format off
+const char *FlowImplXYProc::fshaderFlowXYSrc = 
+#if defined(OGLES_GPGPU_OPENGLES)
+OG_TO_STR(precision highp float;)
+#endif
+OG_TO_STR(
+ varying vec2 textureCoordinate;
+ uniform sampler2D inputImageTexture;
+ uniform float strength;
+
+ void main()
+ {
+     vec4 val = texture2D(inputImageTexture, textureCoordinate);
+     vec4 pix = (val * 2.0) - 1.0;
+     vec3 t = vec3(pix.x*pix.x, pix.y*pix.y, (pix.x*pix.y+1.0)/2.0);
+     gl_FragData[0] = vec4(t, (pix.x*pix.z+1.0)/2.0) * strength;
+     gl_FragData[1] = vec4(t, (pix.y*pix.z+1.0)/2.0) * strength;
+ });
+// clang-format on
+
 //##########################################################################
 //                   +=> [Ix^2; Ix*Iy; Iy^2; Ix*It] => SMOOTH ===+
 //  [Ix; Iy; It; .]  |                                           | => FLOW
@@ -310,14 +358,14 @@ void Flow2Proc::filterShaderSetup(const char* vShaderSrc, const char* fShaderSrc
 
 void Flow2Proc::getUniforms() {
     TwoInputProc::getUniforms();
-    shParamUStrength = shader->getParam(UNIF, "strength");
-    shParamUTau = shader->getParam(UNIF, "tau");
+    shParamUStrength.init(shader.get(), "strength");
+    shParamUTau.init(shader.get(), "tau");
 }
 
 void Flow2Proc::setUniforms() {
     TwoInputProc::setUniforms();
-    glUniform1f(shParamUStrength, strength);
-    glUniform1f(shParamUTau, tau);
+    shParamUStrength.set(strength);
+    shParamUTau.set(tau);
 }
 
 // clang-format off
@@ -379,14 +427,25 @@ OG_TO_STR(
 
 #define USE_MEDIAN 0
 
+// Compute the X and Y tensors in a single MRT pass where supported:
+#if defined(OGLES_GPGPU_OPENGL_ES2)
+#  define USE_MRT 0
+#else
+#  define USE_MRT 1
+#endif
+
 struct Flow2Pipeline::Impl {
     typedef GaussOptProc SmoothProc;
 
     Impl(float tau, float strength, bool doGray)
         : diffProc(40.0)
+#if USE_MRT
+        , flowXYProc(1.f)
+#else
         , flowXProc(true, 1.f)
-        , flowXSmoothProc(5.0)
         , flowYProc(false, 1.f)
+#endif
+        , flowXSmoothProc(5.0)
         , flowYSmoothProc(5.0)
         , flowProc(tau, strength) {
         if (!doGray) {
@@ -400,12 +459,18 @@ struct Flow2Pipeline::Impl {
 
             grayProc.add(&diffProc, 0);
 
+#if USE_MRT
+            diffProc.add(&flowXYProc);
+            flowXYProc.addToOutput(&flowXSmoothProc, 0);
+            flowXYProc.addToOutput(&flowYSmoothProc, 1);
+#else
             diffProc.add(&flowXProc);
             flowXProc.add(&flowXSmoothProc);
-            flowXSmoothProc.add(&flowProc, 0);
 
             diffProc.add(&flowYProc);
             flowYProc.add(&flowYSmoothProc);
+#endif
+            flowXSmoothProc.add(&flowProc, 0);
             flowYSmoothProc.add(&flowProc, 1);
 
             nmsProc.swizzle(2); // b channel
@@ -423,10 +488,14 @@ struct Flow2Pipeline::Impl {
     FIFOPRoc fifoProc;
     IxytProc diffProc;
 
+#if USE_MRT
+    FlowImplXYProc flowXYProc;
+#else
     FlowImplProc flowXProc;
-    SmoothProc flowXSmoothProc;
-
     FlowImplProc flowYProc;
+#endif
+
+    SmoothProc flowXSmoothProc;
     SmoothProc flowYSmoothProc;
 
     Flow2Proc flowProc;
@@ -444,10 +513,16 @@ Flow2Pipeline::Flow2Pipeline(float tau, float strength, bool doGray) {
     procPasses.push_back(&m_pImpl->grayProc);
     procPasses.push_back(&m_pImpl->fifoProc);
     procPasses.push_back(&m_pImpl->diffProc);
+#if USE_MRT
+    procPasses.push_back(&m_pImpl->flowXYProc);
+    procPasses.push_back(&m_pImpl->flowXSmoothProc);
+    procPasses.push_back(&m_pImpl->flowYSmoothProc);
+#else
     procPasses.push_back(&m_pImpl->flowXProc);
     procPasses.push_back(&m_pImpl->flowXSmoothProc);
     procPasses.push_back(&m_pImpl->flowYProc);
     procPasses.push_back(&m_pImpl->flowYSmoothProc);
+#endif
     procPasses.push_back(&m_pImpl->flowProc);
     procPasses.push_back(&m_pImpl->nmsProc);
 };
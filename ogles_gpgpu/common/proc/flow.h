@@ -12,6 +12,7 @@
 #include "../common_includes.h"
 #include "base/filterprocbase.h"
 #include "base/multipassproc.h" // for FlowPipeline
+#include "base/multitargetproc.h" // for FlowImplXYProc
 #include "two.h"
 
 #include <memory>
@@ -46,13 +47,13 @@ private:
         return vshaderGPUImage;
     }
 
-    GLint texelWidthUniform;
-    GLint texelHeightUniform;
+    Uniform<GLfloat> texelWidthUniform;
+    Uniform<GLfloat> texelHeightUniform;
 
-    GLint shParamUTau;
+    Uniform<GLfloat> shParamUTau;
     GLfloat tau = 0.004;
 
-    GLint shParamUStrength;
+    Uniform<GLfloat> shParamUStrength;
     GLfloat strength = 1.0f;
 
     std::string vshaderFlowDynamic;
@@ -114,7 +115,7 @@ private:
     void filterShaderSetup(const char* vShaderSrc, const char* fShaderSrc, GLenum target);
 
     bool isX = false;
-    GLint shParamUStrength;
+    Uniform<GLfloat> shParamUStrength;
     float strength = 1.f;
     virtual const char* getVertexShaderSource() {
         return vshaderGPUImage;
@@ -126,6 +127,35 @@ private:
     static const char* fshaderFlowYSrc;
 };
 
+// Computes both FlowImplProc outputs (isX = true : output 0, isX = false : output 1)
+// in a single pass with multiple render targets, so the input is only sampled once.
+
+class FlowImplXYProc : public MultiTargetProc {
+public:
+    FlowImplXYProc(float strength = 1.0f);
+    virtual const char* getProcName() {
+        return "FlowImplXYProc";
+    }
+    virtual void getUniforms();
+    virtual void setUniforms();
+    virtual void setStrength(float value) {
+        strength = value;
+    }
+
+private:
+    void filterShaderSetup(const char* vShaderSrc, const char* fShaderSrc, GLenum target);
+
+    Uniform<GLfloat> shParamUStrength;
+    float strength = 1.f;
+    virtual const char* getVertexShaderSource() {
+        return vshaderGPUImage;
+    }
+    virtual const char* getFragmentShaderSource() {
+        return fshaderFlowXYSrc;
+    }
+    static const char* fshaderFlowXYSrc;
+};
+
 class Flow2Proc : public TwoInputProc {
 public:
     Flow2Proc(float tau = 0.004, float strength = 1.0f);
@@ -151,10 +181,10 @@ private:
         return vshaderGPUImage;
     }
 
-    GLint shParamUTau;
+    Uniform<GLfloat> shParamUTau;
     GLfloat tau = 0.004;
 
-    GLint shParamUStrength;
+    Uniform<GLfloat> shParamUStrength;
     GLfloat strength = 1.0f;
 
     static const char* fshaderFlowSrc; // fragment shader source
@@ -24,12 +24,16 @@ OG_TO_STR(
      gl_FragColor = clamp(val * gain, 0.0, 1.0);
  });
 
+void GainProc::setGain(float value) {
+    gain = value;
+}
+
 void GainProc::getUniforms() {
-    shParamUGain = shader->getParam(UNIF, "gain");
+    shParamUGain.init(shader.get(), "gain");
 }
 
 void GainProc::setUniforms() {
-    glUniform1f(shParamUGain, gain);
+    shParamUGain.set(gain);
 }
 
 END_OGLES_GPGPU
@@ -57,7 +57,7 @@ private:
 
     static const char* fshaderGainSrc; // fragment shader source
     float gain = 1.f;
-    GLint shParamUGain;
+    Uniform<GLfloat> shParamUGain;
 };
 }
 
@@ -78,14 +78,14 @@ GradProc::GradProc(float strength)
 void GradProc::setUniforms() {
     Filter3x3Proc::setUniforms();
 
-    glUniform1f(texelWidthUniform, (1.0f / float(outFrameW)));
-    glUniform1f(texelHeightUniform, (1.0f / float(outFrameH)));
+    texelWidthUniform.set((1.0f / float(outFrameW)));
+    texelHeightUniform.set((1.0f / float(outFrameH)));
 
-    glUniform1f(shParamUStrength, strength);
+    shParamUStrength.set(strength);
 }
 
 void GradProc::getUniforms() {
     Filter3x3Proc::getUniforms();
-    shParamUInputTex = shader->getParam(UNIF, "inputImageTexture");
-    shParamUStrength = shader->getParam(UNIF, "strength");
+    shParamUInputTex.init(shader.get(), "inputImageTexture");
+    shParamUStrength.init(shader.get(), "strength");
 }
@@ -50,7 +50,7 @@ private:
 
     static const char* fshaderGradSrc; // fragment shader source
 
-    GLint shParamUStrength;
+    Uniform<GLfloat> shParamUStrength;
 
     float strength = 1.f;
 };
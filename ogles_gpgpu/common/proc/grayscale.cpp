@@ -77,13 +77,13 @@ void GrayscaleProc::setIdentity() {
 
 void GrayscaleProc::setUniforms() {
     if (inputConvType != GRAYSCALE_INPUT_CONVERSION_NONE) {
-        glUniform3fv(shParamUInputConvVec, 1, grayscaleConvVec); // set additional uniforms
+        shParamUInputConvVec.set(Vec3f(grayscaleConvVec[0], grayscaleConvVec[1], grayscaleConvVec[2])); // set additional uniforms
     }
 }
 
 void GrayscaleProc::getUniforms() {
     if (inputConvType != GRAYSCALE_INPUT_CONVERSION_NONE) {
-        shParamUInputConvVec = shader->getParam(UNIF, "uInputConvVec");
+        shParamUInputConvVec.init(shader.get(), "uInputConvVec");
     }
 }
 
@@ -102,7 +102,7 @@ private:
     static const GLfloat grayscaleConvVecBGR[3]; // weighted channel grayscale conversion for BGR input
     static const GLfloat grayscaleConvVecNone[3]; // identity transformation for pass through shader behavior
 
-    GLint shParamUInputConvVec; // shader uniform weighted channel grayscale conversion vector
+    Uniform<Vec3f> shParamUInputConvVec; // shader uniform weighted channel grayscale conversion vector
 
     GLfloat grayscaleConvVec[3]; // currently set weighted channel grayscale conversion vector
     GrayscaleInputConversionType inputConvType; // grayscale conversion type
@@ -57,11 +57,11 @@ void HarrisProc::filterShaderSetup(const char* vShaderSrc, const char* fShaderSr
 
 void HarrisProc::getUniforms() {
     FilterProcBase::getUniforms();
-    shParamUInputTex = shader->getParam(UNIF, "inputImageTexture");
-    shParamUInputSensitivity = shader->getParam(UNIF, "sensitivity");
+    shParamUInputTex.init(shader.get(), "inputImageTexture");
+    shParamUInputSensitivity.init(shader.get(), "sensitivity");
 }
 
 void HarrisProc::setUniforms() {
     FilterProcBase::setUniforms();
-    glUniform1f(shParamUInputSensitivity, sensitivity); // set additional uniforms
+    shParamUInputSensitivity.set(sensitivity); // set additional uniforms
 }
@@ -174,11 +174,11 @@ HessianProc::HessianProc(float edgeStrength, bool doHessian)
 
 void HessianProc::setUniforms() {
     Filter3x3Proc::setUniforms();
-    glUniform1f(shParamUEdgeStrength, edgeStrength);
+    shParamUEdgeStrength.set(edgeStrength);
 }
 
 void HessianProc::getUniforms() {
     Filter3x3Proc::getUniforms();
-    shParamUInputTex = shader->getParam(UNIF, "inputImageTexture");
-    shParamUEdgeStrength = shader->getParam(UNIF, "edgeStrength");
+    shParamUInputTex.init(shader.get(), "inputImageTexture");
+    shParamUEdgeStrength.init(shader.get(), "edgeStrength");
 }
@@ -63,7 +63,7 @@ private:
 
     float edgeStrength = 1.0f;
 
-    GLuint shParamUEdgeStrength = 0;
+    Uniform<GLfloat> shParamUEdgeStrength;
 
     static const char* fshaderHessianAndDeterminantSrc; // fragment shader source
 
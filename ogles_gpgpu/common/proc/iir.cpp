@@ -65,6 +65,11 @@ int IirFilterProc::reinit(int inW, int inH, bool prepareForExternalInput) {
     return MultiPassProc::reinit(inW, inH, prepareForExternalInput);
 }
 
+void IirFilterProc::reset() {
+    isFirst = true;
+    MultiPassProc::reset();
+}
+
 IirFilterProc::~IirFilterProc() {
     procPasses.clear();
 }
@@ -35,6 +35,7 @@ public:
 
     virtual int init(int inW, int inH, unsigned int order, bool prepareForExternalInput = false);
     virtual int reinit(int inW, int inH, bool prepareForExternalInput = false);
+    virtual void reset();
 
     bool isFirst = true;
     std::unique_ptr<Impl> m_impl;
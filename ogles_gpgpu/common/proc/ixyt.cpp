@@ -13,16 +13,16 @@ using namespace ogles_gpgpu;
 
 void IxytProc::getUniforms() {
     TwoInputProc::getUniforms();
-    texelWidthUniform = shader->getParam(UNIF, "texelWidth");
-    texelHeightUniform = shader->getParam(UNIF, "texelHeight");
-    shParamUStrength = shader->getParam(UNIF, "strength");
+    texelWidthUniform.init(shader.get(), "texelWidth");
+    texelHeightUniform.init(shader.get(), "texelHeight");
+    shParamUStrength.init(shader.get(), "strength");
 }
 
 void IxytProc::setUniforms() {
     TwoInputProc::setUniforms();
-    glUniform1f(texelWidthUniform, (1.0f / float(outFrameW)));
-    glUniform1f(texelHeightUniform, (1.0f / float(outFrameH)));
-    glUniform1f(shParamUStrength, strength);
+    texelWidthUniform.set((1.0f / float(outFrameW)));
+    texelHeightUniform.set((1.0f / float(outFrameH)));
+    shParamUStrength.set(strength);
 }
 
 // clang-format off
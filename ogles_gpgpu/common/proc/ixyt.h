@@ -31,10 +31,10 @@ public:
     }
 
 private:
-    GLint texelWidthUniform;
-    GLint texelHeightUniform;
+    Uniform<GLfloat> texelWidthUniform;
+    Uniform<GLfloat> texelHeightUniform;
 
-    GLint shParamUStrength;
+    Uniform<GLfloat> shParamUStrength;
     float strength = 1.f;
 
     virtual const char* getVertexShaderSource() {
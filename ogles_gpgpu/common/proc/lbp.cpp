@@ -13,53 +13,37 @@ using namespace std;
 using namespace ogles_gpgpu;
 
 // clang-format off
-const char *LbpProc::fshaderLbpSrc =
-
-#if defined(OGLES_GPGPU_OPENGLES)
-OG_TO_STR(precision highp float;)
-#endif
-OG_TO_STR(
-varying vec2 textureCoordinate;
-varying vec2 leftTextureCoordinate;
-varying vec2 rightTextureCoordinate;
-
-varying vec2 topTextureCoordinate;
-varying vec2 topLeftTextureCoordinate;
-varying vec2 topRightTextureCoordinate;
-
-varying vec2 bottomTextureCoordinate;
-varying vec2 bottomLeftTextureCoordinate;
-varying vec2 bottomRightTextureCoordinate;
-
-uniform sampler2D inputImageTexture;
-
-void main()
-{
-    float centerIntensity = texture2D(inputImageTexture, textureCoordinate).r;
-    float bottomLeftIntensity = texture2D(inputImageTexture, bottomLeftTextureCoordinate).r;
-    float topRightIntensity = texture2D(inputImageTexture, topRightTextureCoordinate).r;
-    float topLeftIntensity = texture2D(inputImageTexture, topLeftTextureCoordinate).r;
-    float bottomRightIntensity = texture2D(inputImageTexture, bottomRightTextureCoordinate).r;
-    float leftIntensity = texture2D(inputImageTexture, leftTextureCoordinate).r;
-    float rightIntensity = texture2D(inputImageTexture, rightTextureCoordinate).r;
-    float bottomIntensity = texture2D(inputImageTexture, bottomTextureCoordinate).r;
-    float topIntensity = texture2D(inputImageTexture, topTextureCoordinate).r;
-
-    float byteTally = 1.0 / 255.0 * step(centerIntensity, topRightIntensity);
-   byteTally += 2.0 / 255.0 * step(centerIntensity, topIntensity);
-   byteTally += 4.0 / 255.0 * step(centerIntensity, topLeftIntensity);
-   byteTally += 8.0 / 255.0 * step(centerIntensity, leftIntensity);
-   byteTally += 16.0 / 255.0 * step(centerIntensity, bottomLeftIntensity);
-   byteTally += 32.0 / 255.0 * step(centerIntensity, bottomIntensity);
-   byteTally += 64.0 / 255.0 * step(centerIntensity, bottomRightIntensity);
-   byteTally += 128.0 / 255.0 * step(centerIntensity, rightIntensity);
-
-   // TODO: Replace the above with a dot product and two vec4s
-   // TODO: Apply step to a matrix, rather than individually
-
-    //gl_FragColor = vec4(centerIntensity, centerIntensity, centerIntensity, 1.0);
-    gl_FragColor = vec4(byteTally, byteTally, byteTally, 1.0);
-});
+#define OGLES_GPGPU_LBP_FSH OG_TO_STR(                                                               \
+void main()                                                                                         \
+{                                                                                                   \
+    float centerIntensity = OG_TEXEL(textureCoordinate, 0, 0).r;                                    \
+    float bottomLeftIntensity = OG_TEXEL(bottomLeftTextureCoordinate, -1, 1).r;                     \
+    float topRightIntensity = OG_TEXEL(topRightTextureCoordinate, 1, -1).r;                         \
+    float topLeftIntensity = OG_TEXEL(topLeftTextureCoordinate, -1, -1).r;                          \
+    float bottomRightIntensity = OG_TEXEL(bottomRightTextureCoordinate, 1, 1).r;                    \
+    float leftIntensity = OG_TEXEL(leftTextureCoordinate, -1, 0).r;                                 \
+    float rightIntensity = OG_TEXEL(rightTextureCoordinate, 1, 0).r;                                \
+    float bottomIntensity = OG_TEXEL(bottomTextureCoordinate, 0, 1).r;                              \
+    float topIntensity = OG_TEXEL(topTextureCoordinate, 0, -1).r;                                   \
+                                                                                                    \
+    float byteTally = 1.0 / 255.0 * step(centerIntensity, topRightIntensity);                       \
+   byteTally += 2.0 / 255.0 * step(centerIntensity, topIntensity);                                  \
+   byteTally += 4.0 / 255.0 * step(centerIntensity, topLeftIntensity);                              \
+   byteTally += 8.0 / 255.0 * step(centerIntensity, leftIntensity);                                 \
+   byteTally += 16.0 / 255.0 * step(centerIntensity, bottomLeftIntensity);                          \
+   byteTally += 32.0 / 255.0 * step(centerIntensity, bottomIntensity);                              \
+   byteTally += 64.0 / 255.0 * step(centerIntensity, bottomRightIntensity);                         \
+   byteTally += 128.0 / 255.0 * step(centerIntensity, rightIntensity);                              \
+                                                                                                    \
+   /* TODO: Replace the above with a dot product and two vec4s */                                   \
+   /* TODO: Apply step to a matrix, rather than individually */                                     \
+                                                                                                    \
+    OG_FRAG_COLOR = vec4(byteTally, byteTally, byteTally, 1.0);                                     \
+})
+
+const char *LbpProc::fshaderLbpSrc = OGLES_GPGPU_FILTER3X3_FSH_HEADER OGLES_GPGPU_LBP_FSH;
+
+const char *LbpProc::fshaderLbpTexelFetchSrc = OG_GLSL3_VERSION OGLES_GPGPU_FILTER3X3_FSH_HEADER_TEXEL_FETCH OGLES_GPGPU_LBP_FSH;
 // clang-format on
 
 LbpProc::LbpProc() {
@@ -67,5 +51,5 @@ LbpProc::LbpProc() {
 
 void LbpProc::getUniforms() {
     Filter3x3Proc::getUniforms();
-    shParamUInputTex = shader->getParam(UNIF, "inputImageTexture");
+    shParamUInputTex.init(shader.get(), "inputImageTexture");
 }
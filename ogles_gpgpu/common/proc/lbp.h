@@ -38,7 +38,14 @@ private:
      * Get the fragment shader source.
      */
     virtual const char* getFragmentShaderSource() {
-        return fshaderLbpSrc;
+        return useTexelFetch() ? fshaderLbpTexelFetchSrc : fshaderLbpSrc;
+    }
+
+    /**
+     * The shader supports texelFetch() reads.
+     */
+    virtual bool hasTexelFetchShader() const {
+        return true;
     }
 
     /**
@@ -47,6 +54,7 @@ private:
     virtual void getUniforms();
 
     static const char* fshaderLbpSrc; // fragment shader source
+    static const char* fshaderLbpTexelFetchSrc; // fragment shader source with texelFetch() reads
 };
 }
 
@@ -45,13 +45,13 @@ void LetterboxProc::filterRenderDraw() {
 }
 
 void LetterboxProc::getUniforms() {
-    shParamULetterboxHeight = shader->getParam(UNIF, "height");
-    shParamULetterboxColor = shader->getParam(UNIF, "color");
+    shParamULetterboxHeight.init(shader.get(), "height");
+    shParamULetterboxColor.init(shader.get(), "color");
 }
 
 void LetterboxProc::setUniforms() {
-    glUniform1f(shParamULetterboxHeight, height);
-    glUniform3f(shParamULetterboxColor, color[0], color[1], color[2]);
+    shParamULetterboxHeight.set(height);
+    shParamULetterboxColor.set(Vec3f(color[0], color[1], color[2]));
 }
 
 END_OGLES_GPGPU
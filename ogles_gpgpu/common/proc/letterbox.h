@@ -98,8 +98,8 @@ protected:
     static const char* fshaderLetterboxSrc;
     float height = 1.f;
     std::array<float, 3> color;
-    GLint shParamULetterboxHeight;
-    GLint shParamULetterboxColor;
+    Uniform<GLfloat> shParamULetterboxHeight;
+    Uniform<Vec3f> shParamULetterboxColor;
     RenderDelegate func;
 };
 
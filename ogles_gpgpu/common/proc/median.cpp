@@ -55,26 +55,7 @@ MedianProc::MedianProc()
 }
 
 // clang-format off
-const char *MedianProc::fshaderMedianSrc = 
-#if defined(OGLES_GPGPU_OPENGLES)
-OG_TO_STR(precision highp float;)
-#endif
-OG_TO_STR(
-
- varying vec2 textureCoordinate;
- varying vec2 leftTextureCoordinate;
- varying vec2 rightTextureCoordinate;
-
- varying vec2 topTextureCoordinate;
- varying vec2 topLeftTextureCoordinate;
- varying vec2 topRightTextureCoordinate;
-
- varying vec2 bottomTextureCoordinate;
- varying vec2 bottomLeftTextureCoordinate;
- varying vec2 bottomRightTextureCoordinate;
-
- uniform sampler2D inputImageTexture;
-
+// exchange macros, expanded in the shader source
 #define s2(a, b)				temp = a; a = min(a, b); b = max(temp, b);
 #define mn3(a, b, c)			s2(a, b); s2(a, c);
 #define mx3(a, b, c)			s2(b, c); s2(a, c);
@@ -83,39 +64,44 @@ OG_TO_STR(
 #define mnmx5(a, b, c, d, e)	s2(a, b); s2(c, d); mn3(a, c, e); mx3(b, d, e);           // 6 exchanges
 #define mnmx6(a, b, c, d, e, f) s2(a, d); s2(b, e); s2(c, f); mn3(a, b, c); mx3(d, e, f); // 7 exchanges
 
- void main()
- {
-     vec3 v[6];
-     v[0] = texture2D(inputImageTexture, bottomLeftTextureCoordinate).rgb;
-     v[1] = texture2D(inputImageTexture, topRightTextureCoordinate).rgb;
-     v[2] = texture2D(inputImageTexture, topLeftTextureCoordinate).rgb;
-     v[3] = texture2D(inputImageTexture, bottomRightTextureCoordinate).rgb;
-     v[4] = texture2D(inputImageTexture, leftTextureCoordinate).rgb;
-     v[5] = texture2D(inputImageTexture, rightTextureCoordinate).rgb;
-     vec3 temp;
-
-     mnmx6(v[0], v[1], v[2], v[3], v[4], v[5]);
-
-     v[5] = texture2D(inputImageTexture, bottomTextureCoordinate).rgb;
-
-     mnmx5(v[1], v[2], v[3], v[4], v[5]);
-
-     v[5] = texture2D(inputImageTexture, topTextureCoordinate).rgb;
-
-     mnmx4(v[2], v[3], v[4], v[5]);
-
-     vec4 center = texture2D(inputImageTexture, textureCoordinate);
-     v[5] = center.rgb;
-
-     mnmx3(v[3], v[4], v[5]);
-
-     gl_FragColor = vec4(v[4], center.a);
- });
+#define OGLES_GPGPU_MEDIAN_FSH OG_TO_STR(                                     \
+ void main()                                                                \
+ {                                                                          \
+     vec3 v[6];                                                             \
+     v[0] = OG_TEXEL(bottomLeftTextureCoordinate, -1, 1).rgb;               \
+     v[1] = OG_TEXEL(topRightTextureCoordinate, 1, -1).rgb;                 \
+     v[2] = OG_TEXEL(topLeftTextureCoordinate, -1, -1).rgb;                 \
+     v[3] = OG_TEXEL(bottomRightTextureCoordinate, 1, 1).rgb;               \
+     v[4] = OG_TEXEL(leftTextureCoordinate, -1, 0).rgb;                     \
+     v[5] = OG_TEXEL(rightTextureCoordinate, 1, 0).rgb;                     \
+     vec3 temp;                                                             \
+                                                                            \
+     mnmx6(v[0], v[1], v[2], v[3], v[4], v[5]);                             \
+                                                                            \
+     v[5] = OG_TEXEL(bottomTextureCoordinate, 0, 1).rgb;                    \
+                                                                            \
+     mnmx5(v[1], v[2], v[3], v[4], v[5]);                                   \
+                                                                            \
+     v[5] = OG_TEXEL(topTextureCoordinate, 0, -1).rgb;                      \
+                                                                            \
+     mnmx4(v[2], v[3], v[4], v[5]);                                         \
+                                                                            \
+     vec4 center = OG_TEXEL(textureCoordinate, 0, 0);                       \
+     v[5] = center.rgb;                                                     \
+                                                                            \
+     mnmx3(v[3], v[4], v[5]);                                               \
+                                                                            \
+     OG_FRAG_COLOR = vec4(v[4], center.a);                                  \
+ })
+
+const char *MedianProc::fshaderMedianSrc = OGLES_GPGPU_FILTER3X3_FSH_HEADER OGLES_GPGPU_MEDIAN_FSH;
+
+const char *MedianProc::fshaderMedianTexelFetchSrc = OG_GLSL3_VERSION OGLES_GPGPU_FILTER3X3_FSH_HEADER_TEXEL_FETCH OGLES_GPGPU_MEDIAN_FSH;
 // clang-format on
 
 void MedianProc::getUniforms() {
     Filter3x3Proc::getUniforms();
-    shParamUInputTex = shader->getParam(UNIF, "inputImageTexture");
+    shParamUInputTex.init(shader.get(), "inputImageTexture");
 }
 
 END_OGLES_GPGPU
@@ -38,7 +38,14 @@ private:
      * Get the fragment shader source.
      */
     virtual const char* getFragmentShaderSource() {
-        return fshaderMedianSrc;
+        return useTexelFetch() ? fshaderMedianTexelFetchSrc : fshaderMedianSrc;
+    }
+
+    /**
+     * The shader supports texelFetch() reads.
+     */
+    virtual bool hasTexelFetchShader() const {
+        return true;
     }
 
     /**
@@ -47,6 +54,7 @@ private:
     virtual void getUniforms();
 
     static const char* fshaderMedianSrc; // fragment shader source
+    static const char* fshaderMedianTexelFetchSrc; // fragment shader source with texelFetch() reads
 };
 
 END_OGLES_GPGPU
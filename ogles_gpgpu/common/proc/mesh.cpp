@@ -59,11 +59,12 @@ MeshShaderProc::MeshShaderProc(const VertexBuffer& vertices, const CoordBuffer&
     {
         throw std::runtime_error("MeshShader: shader error");
     }
+    shaderCost = ShaderCost::analyze(vshaderMeshSrc, fshaderMeshSrc);
 
     shParamAPos = shader->getParam(ATTR, "aPos");
     shParamATexCoord = shader->getParam(ATTR, "aTexCoord");
-    shParamUInputTex = shader->getParam(UNIF, "uInputTex");
-    shParamUMVP = shader->getParam(UNIF, "transformMatrix");
+    shParamUInputTex.init(shader.get(), "uInputTex");
+    shParamUMVP.init(shader.get(), "transformMatrix");
     
     Tools::checkGLErr(getProcName(), "get uniforms and attributes");
 }
@@ -79,13 +80,13 @@ void MeshShaderProc::setModelViewProjection(const Mat44f &mvp) {
 
 void MeshShaderProc::setUniforms() {
     FilterProcBase::setUniforms();
-    glUniformMatrix4fv(shParamUMVP, 1, 0, &MVP.data[0][0]);
+    shParamUMVP.set(MVP);
     // TODO: Add bicubic
 }
 
 void MeshShaderProc::getUniforms() {
     FilterProcBase::getUniforms();
-    shParamUMVP = shader->getParam(UNIF, "transformMatrix");
+    shParamUMVP.init(shader.get(), "transformMatrix");
     // TODO: Add bicubic
 }
 
@@ -118,6 +119,7 @@ void MeshShaderProc::filterRenderSetCoords() {
 
 void MeshShaderProc::filterRenderDraw() {
     glDrawArrays(triangleKind, 0, static_cast<int>(vertices.size()));
+    OG_GL_COUNT(drawCalls);
 }
 
 void MeshShaderProc::setTriangleKind(GLenum kind) {
@@ -92,8 +92,8 @@ protected:
 
     GLint shParamAPos;
     GLint shParamATexCoord;
-    GLint shParamUInputTex;
-    GLint shParamUMVP;
+    Uniform<GLint> shParamUInputTex;
+    Uniform<Mat44f> shParamUMVP;
 
     VertexBuffer vertices;
     CoordBuffer coords;
@@ -97,7 +97,7 @@ int AdaptThreshProcPass::init(int inW, int inH, unsigned int order, bool prepare
     filterInit(vshaderDefault, shSrc, RenderOrientationDiagonal);
 
     // get additional shader params
-    shParamUPxD = shader->getParam(UNIF, "uPxD");
+    shParamUPxD.init(shader.get(), "uPxD");
 
     return 1;
 }
@@ -121,7 +121,7 @@ int AdaptThreshProcPass::render(int position) {
 
     filterRenderPrepare();
 
-    glUniform2f(shParamUPxD, pxDx, pxDy); // texture pixel delta values
+    shParamUPxD.set(Vec2f(pxDx, pxDy)); // texture pixel delta values
 
     Tools::checkGLErr(getProcName(), "render prepare");
 
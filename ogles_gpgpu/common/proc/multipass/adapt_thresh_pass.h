@@ -64,7 +64,7 @@ public:
 private:
     int renderPass; // render pass number. must be 1 or 2
 
-    GLint shParamUPxD; // pixel delta values for texture lookup in the fragment shader. only used for adapt. thresholding
+    Uniform<Vec2f> shParamUPxD; // pixel delta values for texture lookup in the fragment shader. only used for adapt. thresholding
 
     float pxDx; // pixel delta value for texture access. only used for adapt. thresholding
     float pxDy; // pixel delta value for texture access. only used for adapt. thresholding
@@ -12,7 +12,7 @@
 
 #include "../../common_includes.h"
 
-#include "../base/filterprocbase.h"
+#include "separable_pass.h"
 
 // Copyright (c) 2016-2017, David Hirvonen (this file)
 
@@ -21,18 +21,14 @@ namespace ogles_gpgpu {
 /**
  * This filter applies boxian smoothing to an input image.
  */
-class BoxOptProcPass : public FilterProcBase {
+class BoxOptProcPass : public SeparableProcPass {
 public:
     /**
      * Construct as render pass <pass> (1 or 2).
      */
     BoxOptProcPass(int pass, float radius)
-        : FilterProcBase()
-        , renderPass(pass)
-        , pxDx(0.0f)
-        , pxDy(0.0f) {
+        : SeparableProcPass(pass) {
         setRadius(radius);
-        assert(renderPass == 1 || renderPass == 2);
     }
 
     void setRadius(float newValue);
@@ -44,25 +40,8 @@ public:
         return "BoxOptProcPass";
     }
 
-    virtual void filterShaderSetup(const char* vShaderSrc, const char* fShaderSrc, GLenum target);
-    virtual void setUniforms();
-    virtual void getUniforms();
-    virtual const char* getFragmentShaderSource();
-    virtual const char* getVertexShaderSource();
-
 private:
-    int renderPass; // render pass number. must be 1 or 2
-
-    float pxDx; // pixel delta value for texture access
-    float pxDy; // pixel delta value for texture access
-
     float _blurRadiusInPixels = 0.0; // start 0 (uninitialized)
-
-    GLint shParamUTexelWidthOffset;
-    GLint shParamUTexelHeightOffset;
-
-    std::string vshaderBoxSrc;
-    std::string fshaderBoxSrc;
 };
 }
 #endif
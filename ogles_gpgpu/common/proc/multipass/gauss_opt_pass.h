@@ -14,27 +14,23 @@
 
 #include "../../common_includes.h"
 
-#include "../base/filterprocbase.h"
+#include "separable_pass.h"
 
 namespace ogles_gpgpu {
 
 /**
  * This filter applies gaussian smoothing to an input image.
  */
-class GaussOptProcPass : public FilterProcBase {
+class GaussOptProcPass : public SeparableProcPass {
 public:
     /**
      * Construct as render pass <pass> (1 or 2).
      */
     GaussOptProcPass(int pass, float radius, bool doNorm = false, float normConst = 0.005f)
-        : FilterProcBase()
+        : SeparableProcPass(pass)
         , doNorm(doNorm)
-        , renderPass(pass)
-        , pxDx(0.0f)
-        , pxDy(0.0f)
         , normConst(normConst) {
         setRadius(radius);
-        assert(renderPass == 1 || renderPass == 2);
     }
 
     void setRadius(float newValue);
@@ -46,28 +42,15 @@ public:
         return "GaussOptProcPass";
     }
 
-    virtual void filterShaderSetup(const char* vShaderSrc, const char* fShaderSrc, GLenum target);
-    virtual void setUniforms();
-    virtual void getUniforms();
-    virtual const char* getFragmentShaderSource();
-    virtual const char* getVertexShaderSource();
+protected:
+    virtual std::string getFragmentShaderOutput();
 
 private:
     bool doNorm = false;
-    int renderPass; // render pass number. must be 1 or 2
-
-    float pxDx; // pixel delta value for texture access
-    float pxDy; // pixel delta value for texture access
 
     float normConst = 0.005;
 
     float _blurRadiusInPixels = 0.0; // start 0 (uninitialized)
-
-    GLint shParamUTexelWidthOffset;
-    GLint shParamUTexelHeightOffset;
-
-    std::string vshaderGaussSrc;
-    std::string fshaderGaussSrc;
 };
 }
 #endif
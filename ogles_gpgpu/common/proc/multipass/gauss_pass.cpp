@@ -14,73 +14,79 @@
 
 using namespace ogles_gpgpu;
 
-// #### 7 tap filters ####
-
-// clang-format off
-const char *GaussProcPass::vshaderGauss7Src = OG_TO_STR(
- attribute vec4 position;
- attribute vec4 inputTextureCoordinate;
-
- uniform float texelWidth;
- uniform float texelHeight;
-
- varying vec2 textureCoordinateN3;
- varying vec2 textureCoordinateN2;
- varying vec2 textureCoordinateN1;
- varying vec2 textureCoordinate;
- varying vec2 textureCoordinateP1;
- varying vec2 textureCoordinateP2;
- varying vec2 textureCoordinateP3;
-
- void main()
- {
-     gl_Position = position;
-
-     vec2 texelStep = vec2(texelWidth, texelHeight);
-
-     textureCoordinate = inputTextureCoordinate.xy;
-
-     textureCoordinateN3 = textureCoordinate - texelStep * 3.0;
-     textureCoordinateN2 = textureCoordinate - texelStep * 2.0;
-     textureCoordinateN1 = textureCoordinate - texelStep;
-
-     textureCoordinateP1 = textureCoordinate + texelStep;
-     textureCoordinateP2 = textureCoordinate + texelStep * 2.0;
-     textureCoordinateP3 = textureCoordinate + texelStep * 3.0;
- });
-// clang-format on
-
 // clang-format off
-const char *GaussProcPass::fshaderGauss7Src = 
-#if defined(OGLES_GPGPU_OPENGLES)
-OG_TO_STR(precision mediump float;)
-#endif
-OG_TO_STR(
- uniform sampler2D inputImageTexture;
+// 5 or 7 tap kernel (OG_TAPS7(x): x for 7 taps)
+#define OGLES_GPGPU_GAUSS_VSH                                             \
+OG_TO_STR(                                                                \
+ attribute vec4 position;                                                 \
+ attribute vec4 inputTextureCoordinate;                                   \
+                                                                          \
+ uniform float texelWidth;                                                \
+ uniform float texelHeight;                                               \
+                                                                          \
+ OG_TAPS7(varying vec2 textureCoordinateN3;)                              \
+ varying vec2 textureCoordinateN2;                                        \
+ varying vec2 textureCoordinateN1;                                        \
+ varying vec2 textureCoordinate;                                          \
+ varying vec2 textureCoordinateP1;                                        \
+ varying vec2 textureCoordinateP2;                                        \
+ OG_TAPS7(varying vec2 textureCoordinateP3;)                              \
+                                                                          \
+ void main()                                                              \
+ {                                                                        \
+     gl_Position = position;                                              \
+                                                                          \
+     vec2 texelStep = vec2(texelWidth, texelHeight);                      \
+                                                                          \
+     textureCoordinate = inputTextureCoordinate.xy;                       \
+                                                                          \
+     OG_TAPS7(textureCoordinateN3 = textureCoordinate - texelStep * 3.0;) \
+     textureCoordinateN2 = textureCoordinate - texelStep * 2.0;           \
+     textureCoordinateN1 = textureCoordinate - texelStep;                 \
+                                                                          \
+     textureCoordinateP1 = textureCoordinate + texelStep;                 \
+     textureCoordinateP2 = textureCoordinate + texelStep * 2.0;           \
+     OG_TAPS7(textureCoordinateP3 = textureCoordinate + texelStep * 3.0;) \
+ })
+
+// Filter of channels OG_CHANNELS (of type OG_TYPE) with weights OG_W0 (center) to OG_W3
+#define OGLES_GPGPU_GAUSS_FSH                                                                                                     \
+OG_TO_STR(                                                                                                                        \
+ uniform sampler2D inputImageTexture;                                                                                             \
+                                                                                                                                  \
+ OG_TAPS7(varying vec2 textureCoordinateN3;)                                                                                      \
+ varying vec2 textureCoordinateN2;                                                                                                \
+ varying vec2 textureCoordinateN1;                                                                                                \
+ varying vec2 textureCoordinate;                                                                                                  \
+ varying vec2 textureCoordinateP1;                                                                                                \
+ varying vec2 textureCoordinateP2;                                                                                                \
+ OG_TAPS7(varying vec2 textureCoordinateP3;)                                                                                      \
+                                                                                                                                  \
+ void main()                                                                                                                      \
+ {                                                                                                                                \
+     OG_TAPS7(OG_TYPE pxL3 = texture2D(inputImageTexture, textureCoordinateN3).OG_CHANNELS;)                                      \
+     OG_TYPE pxL2 = texture2D(inputImageTexture, textureCoordinateN2).OG_CHANNELS;                                                \
+     OG_TYPE pxL1 = texture2D(inputImageTexture, textureCoordinateN1).OG_CHANNELS;                                                \
+     vec4 pxC = texture2D(inputImageTexture, textureCoordinate);                                                                  \
+     OG_TYPE pxR1 = texture2D(inputImageTexture, textureCoordinateP1).OG_CHANNELS;                                                \
+     OG_TYPE pxR2 = texture2D(inputImageTexture, textureCoordinateP2).OG_CHANNELS;                                                \
+     OG_TAPS7(OG_TYPE pxR3 = texture2D(inputImageTexture, textureCoordinateP3).OG_CHANNELS;)                                      \
+                                                                                                                                  \
+     pxC.OG_CHANNELS = OG_TAPS7(OG_W3 * (pxL3 + pxR3) +) OG_W2 * (pxL2 + pxR2) + OG_W1 * (pxL1 + pxR1) + OG_W0 * pxC.OG_CHANNELS; \
+     gl_FragColor = pxC;                                                                                                          \
+ })
+
+#define OGLES_GPGPU_GAUSS_TAPS5 OG_GLSL_DEFINE(OG_TAPS7(x), )
+#define OGLES_GPGPU_GAUSS_TAPS7 OG_GLSL_DEFINE(OG_TAPS7(x), x)
+#define OGLES_GPGPU_GAUSS_RGBA OG_GLSL_DEFINE(OG_CHANNELS, rgba) OG_GLSL_DEFINE(OG_TYPE, vec4)
+#define OGLES_GPGPU_GAUSS_R OG_GLSL_DEFINE(OG_CHANNELS, r) OG_GLSL_DEFINE(OG_TYPE, float)
+#define OGLES_GPGPU_GAUSS_WEIGHTS(w0, w1, w2, w3) OG_GLSL_DEFINE(OG_W0, w0) OG_GLSL_DEFINE(OG_W1, w1) OG_GLSL_DEFINE(OG_W2, w2) OG_GLSL_DEFINE(OG_W3, w3)
 
- varying vec2 textureCoordinateN3;
- varying vec2 textureCoordinateN2;
- varying vec2 textureCoordinateN1;
- varying vec2 textureCoordinate;
- varying vec2 textureCoordinateP1;
- varying vec2 textureCoordinateP3;
- varying vec2 textureCoordinateP2;
-
-// 7x1 Gauss kernel
-void main()
-{
-    vec4 pxL3 = texture2D(inputImageTexture, textureCoordinateN3);
-    vec4 pxL2 = texture2D(inputImageTexture, textureCoordinateN2);
-    vec4 pxL1 = texture2D(inputImageTexture, textureCoordinateN1);
-    vec4 pxC  = texture2D(inputImageTexture, textureCoordinate);
-    vec4 pxR1 = texture2D(inputImageTexture, textureCoordinateP1);
-    vec4 pxR2 = texture2D(inputImageTexture, textureCoordinateP2);
-    vec4 pxR3 = texture2D(inputImageTexture, textureCoordinateP3);
-
-    gl_FragColor = 0.015625 * (pxL3 + pxR3) + 0.09375 * (pxL2 + pxR2) + 0.234375 * (pxL1 + pxR1) + 0.3125 * pxC;
-}
-);
-// clang-format on
+// 1 4 6 4 1
+// 1+4+6+4+1 = 16
+// 6/16 = 0.375
+// 4/16 = 0.25
+// 1/16 = 0.0625
 
 // 1 6 15 20 15 6 1
 // 20+30+12+2 = 64
@@ -89,132 +95,24 @@ void main()
 // 6/64 = 0.09375
 // 1/64 = 0.015625
 
-// clang-format off
-const char *GaussProcPass::fshaderGauss7SrcR =
-#if defined(OGLES_GPGPU_OPENGLES)
-OG_TO_STR(precision mediump float;)
-#endif
-OG_TO_STR(
- uniform sampler2D inputImageTexture;
-
- varying vec2 textureCoordinateN3;
- varying vec2 textureCoordinateN2;
- varying vec2 textureCoordinateN1;
- varying vec2 textureCoordinate;
- varying vec2 textureCoordinateP1;
- varying vec2 textureCoordinateP2;
- varying vec2 textureCoordinateP3;
-
-// 7x1 Gauss kernel
-void main()
-{
-    float pxL3 = texture2D(inputImageTexture, textureCoordinateN3).r;
-    float pxL2 = texture2D(inputImageTexture, textureCoordinateN2).r;
-    float pxL1 = texture2D(inputImageTexture, textureCoordinateN1).r;
-    vec4 pxC  = texture2D(inputImageTexture, textureCoordinate);
-    float pxR1 = texture2D(inputImageTexture, textureCoordinateP1).r;
-    float pxR2 = texture2D(inputImageTexture, textureCoordinateP2).r;
-    float pxR3 = texture2D(inputImageTexture, textureCoordinateP3).r;
-
-    pxC.r = (0.006 * (pxL3 + pxR3) + 0.061 * (pxL2 + pxR2) + 0.242 * (pxL1 + pxR1) + 0.382 * pxC.r);
-    gl_FragColor = pxC;
-});
+// variants by kernel size and channels: [kernel * 2 + doR]
+const ShaderVariant GaussProcPass::gaussVariants[4] = {
+    { "GaussProcPass", "5",
+      OGLES_GPGPU_GAUSS_TAPS5 OGLES_GPGPU_GAUSS_VSH,
+      OGLES_GPGPU_GAUSS_TAPS5 OGLES_GPGPU_GAUSS_RGBA OGLES_GPGPU_GAUSS_WEIGHTS(0.375, 0.25, 0.0625, 0.0) OG_GLSL_PRECISION(highp) OGLES_GPGPU_GAUSS_FSH },
+    { "GaussProcPass", "5r",
+      OGLES_GPGPU_GAUSS_TAPS5 OGLES_GPGPU_GAUSS_VSH,
+      OGLES_GPGPU_GAUSS_TAPS5 OGLES_GPGPU_GAUSS_R OGLES_GPGPU_GAUSS_WEIGHTS(0.375, 0.25, 0.0625, 0.0) OG_GLSL_PRECISION(mediump) OGLES_GPGPU_GAUSS_FSH },
+    { "GaussProcPass", "7",
+      OGLES_GPGPU_GAUSS_TAPS7 OGLES_GPGPU_GAUSS_VSH,
+      OGLES_GPGPU_GAUSS_TAPS7 OGLES_GPGPU_GAUSS_RGBA OGLES_GPGPU_GAUSS_WEIGHTS(0.3125, 0.234375, 0.09375, 0.015625) OG_GLSL_PRECISION(mediump) OGLES_GPGPU_GAUSS_FSH },
+    { "GaussProcPass", "7r",
+      OGLES_GPGPU_GAUSS_TAPS7 OGLES_GPGPU_GAUSS_VSH,
+      OGLES_GPGPU_GAUSS_TAPS7 OGLES_GPGPU_GAUSS_R OGLES_GPGPU_GAUSS_WEIGHTS(0.382, 0.242, 0.061, 0.006) OG_GLSL_PRECISION(mediump) OGLES_GPGPU_GAUSS_FSH }
+};
 // clang-format on
 
-// #### 5 tap filters ####
-
-// clang-format off
-const char *GaussProcPass::vshaderGauss5Src = OG_TO_STR(
- attribute vec4 position;
- attribute vec4 inputTextureCoordinate;
-
- uniform float texelWidth;
- uniform float texelHeight;
-
- varying vec2 textureCoordinateN2;
- varying vec2 textureCoordinateN1;
- varying vec2 textureCoordinate;
- varying vec2 textureCoordinateP1;
- varying vec2 textureCoordinateP2;
-
- void main()
- {
-     gl_Position = position;
-
-     vec2 texelStep = vec2(texelWidth, texelHeight);
-
-     textureCoordinate = inputTextureCoordinate.xy;
-
-     textureCoordinateN2 = textureCoordinate - texelStep * 2.0;
-     textureCoordinateN1 = textureCoordinate - texelStep;
-
-     textureCoordinateP1 = textureCoordinate + texelStep;
-     textureCoordinateP2 = textureCoordinate + texelStep * 2.0;
- });
-// clang-format on
-
-// clang-format off
-const char *GaussProcPass::fshaderGauss5Src = 
-
-#if defined(OGLES_GPGPU_OPENGLES)
- OG_TO_STR(precision highp float;)
-#endif
- OG_TO_STR(
- uniform sampler2D inputImageTexture;
-
- varying vec2 textureCoordinateN2;
- varying vec2 textureCoordinateN1;
- varying vec2 textureCoordinate;
- varying vec2 textureCoordinateP1;
- varying vec2 textureCoordinateP2;
-
- // 5x1 Gauss kernel
- void main()
-{
-    vec4 pxL2 = texture2D(inputImageTexture, textureCoordinateN2);
-    vec4 pxL1 = texture2D(inputImageTexture, textureCoordinateN1);
-    vec4 pxC  = texture2D(inputImageTexture, textureCoordinate);
-    vec4 pxR1 = texture2D(inputImageTexture, textureCoordinateP1);
-    vec4 pxR2 = texture2D(inputImageTexture, textureCoordinateP2);
-
-    vec4 result = (0.0625 * (pxL2 + pxR2) + 0.25 * (pxL1 + pxR1) + 0.375 * pxC);
-    gl_FragColor = result;
-});
-// clang-format on
-
-// 1 4 6 4 1
-// 1+4+6+4+1 = 16
-// 6/16 = 0.375
-// 4/16 = 0.25
-// 1/16 = 0.0625
-
-// clang-format off
-const char *GaussProcPass::fshaderGauss5SrcR = 
-#if defined(OGLES_GPGPU_OPENGLES)
-OG_TO_STR(precision mediump float;)
-#endif
-OG_TO_STR(
- uniform sampler2D inputImageTexture;
-
- varying vec2 textureCoordinateN2;
- varying vec2 textureCoordinateN1;
- varying vec2 textureCoordinate;
- varying vec2 textureCoordinateP1;
- varying vec2 textureCoordinateP2;
-
- // 5x1 Gauss kernel
- void main()
-{
-    float pxL2 = texture2D(inputImageTexture, textureCoordinateN2).r;
-    float pxL1 = texture2D(inputImageTexture, textureCoordinateN1).r;
-    vec4 pxC  = texture2D(inputImageTexture, textureCoordinate);
-    float pxR1 = texture2D(inputImageTexture, textureCoordinateP1).r;
-    float pxR2 = texture2D(inputImageTexture, textureCoordinateP2).r;
-
-    pxC.r = (0.0625 * (pxL2 + pxR2) + 0.25 * (pxL1 + pxR1) + 0.375 * pxC.r);
-    gl_FragColor = pxC;
-});
-// clang-format on
+static ShaderVariants::Registrar gaussVariantsRegistrar(GaussProcPass::gaussVariants, 4);
 
 void GaussProcPass::filterShaderSetup(const char* vShaderSrc, const char* fShaderSrc, GLenum target) {
     // create shader object
@@ -224,8 +122,8 @@ void GaussProcPass::filterShaderSetup(const char* vShaderSrc, const char* fShade
     shParamAPos = shader->getParam(ATTR, "position");
     shParamATexCoord = shader->getParam(ATTR, "inputTextureCoordinate");
 
-    texelWidthUniform = shader->getParam(UNIF, "texelWidth");
-    texelHeightUniform = shader->getParam(UNIF, "texelHeight");
+    texelWidthUniform.init(shader.get(), "texelWidth");
+    texelHeightUniform.init(shader.get(), "texelHeight");
 
     Tools::checkGLErr(getProcName(), "filterShaderSetup");
 }
@@ -233,8 +131,8 @@ void GaussProcPass::filterShaderSetup(const char* vShaderSrc, const char* fShade
 void GaussProcPass::setUniforms() {
     FilterProcBase::setUniforms();
 
-    glUniform1f(texelWidthUniform, (renderPass == 1) * texelWidth);
-    glUniform1f(texelHeightUniform, (renderPass == 2) * texelHeight);
+    texelWidthUniform.set((renderPass == 1) * texelWidth);
+    texelHeightUniform.set((renderPass == 2) * texelHeight);
 }
 
 void GaussProcPass::getUniforms() {
@@ -243,27 +141,13 @@ void GaussProcPass::getUniforms() {
     // calculate pixel delta values
     texelWidth = 1.0f / (float)outFrameW; // input or output?
     texelHeight = 1.0f / (float)outFrameH;
-    shParamUInputTex = shader->getParam(UNIF, "inputImageTexture");
+    shParamUInputTex.init(shader.get(), "inputImageTexture");
 }
 
 const char* GaussProcPass::getFragmentShaderSource() {
-    switch (kernel) {
-    case k5Tap:
-        return doR ? fshaderGauss5SrcR : fshaderGauss5Src;
-    case k7Tap:
-        return doR ? fshaderGauss7SrcR : fshaderGauss7Src;
-    default:
-        assert(false);
-    }
+    return gaussVariants[kernel * 2 + doR].fshSrc;
 }
 
 const char* GaussProcPass::getVertexShaderSource() {
-    switch (kernel) {
-    case k5Tap:
-        return vshaderGauss5Src;
-    case k7Tap:
-        return vshaderGauss7Src;
-    default:
-        assert(false);
-    }
+    return gaussVariants[kernel * 2 + doR].vshSrc;
 }
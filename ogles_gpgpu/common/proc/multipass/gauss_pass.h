@@ -19,6 +19,7 @@
 #include "../../common_includes.h"
 
 #include "../base/filterprocbase.h"
+#include "../../gl/shader_variant.h"
 
 namespace ogles_gpgpu {
 
@@ -58,6 +59,8 @@ public:
     virtual const char* getFragmentShaderSource();
     virtual const char* getVertexShaderSource();
 
+    static const ShaderVariant gaussVariants[4]; // shader sources by kernel size and channels
+
 private:
     int renderPass; // render pass number. must be 1 or 2
 
@@ -65,16 +68,8 @@ private:
 
     bool doR = false; // do r channel only
 
-    GLint texelWidthUniform, texelHeightUniform;
+    Uniform<GLfloat> texelWidthUniform, texelHeightUniform;
     float texelWidth, texelHeight;
-
-    static const char* vshaderGauss7Src;
-    static const char* fshaderGauss7Src; // fragment shader source for gaussian smoothing for both passes
-    static const char* fshaderGauss7SrcR; // shader for R channel
-
-    static const char* vshaderGauss5Src;
-    static const char* fshaderGauss5Src; // fragment shader source for gaussian smoothing for both passes
-    static const char* fshaderGauss5SrcR; // shader for R channel
 };
 }
 #endif
@@ -82,11 +82,11 @@ int LocalNormPass::init(int inW, int inH, unsigned int order, bool prepareForExt
     filterInit(vshaderDefault, shSrc, RenderOrientationDiagonal);
 
     if (renderPass == 2) {
-        shParamUNormConst = shader->getParam(UNIF, "normConst");
+        shParamUNormConst.init(shader.get(), "normConst");
     }
 
     // get additional shader params
-    shParamUPxD = shader->getParam(UNIF, "uPxD");
+    shParamUPxD.init(shader.get(), "uPxD");
 
     return 1;
 }
@@ -110,9 +110,9 @@ int LocalNormPass::render(int position) {
 
     filterRenderPrepare();
 
-    glUniform1f(shParamUPxD, renderPass == 1 ? pxDy : pxDx); // texture pixel delta values
+    shParamUPxD.set(renderPass == 1 ? pxDy : pxDx); // texture pixel delta values
     if (renderPass == 2) {
-        glUniform1f(shParamUNormConst, normConst);
+        shParamUNormConst.set(normConst);
     }
 
     Tools::checkGLErr(getProcName(), "render prepare");
@@ -59,11 +59,11 @@ public:
 private:
     int renderPass; // render pass number. must be 1 or 2
 
-    GLint shParamUPxD; // pixel delta values for texture lookup in the fragment shader. only used for adapt. thresholding
+    Uniform<GLfloat> shParamUPxD; // pixel delta values for texture lookup in the fragment shader. only used for adapt. thresholding
     float pxDx; // pixel delta value for texture access
     float pxDy; // pixel delta value for texture access
 
-    GLint shParamUNormConst;
+    Uniform<GLfloat> shParamUNormConst;
     float normConst = 0.00005; // normalization constant
 
     static const char* fshaderLocalNormPass1Src; // fragment shader source for gaussian smoothing for both passes
@@ -0,0 +1,338 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+// Shader generation based on: https://github.com/BradLarson/GPUImage/blob/master/framework/Source/GPUImageGaussianBlurFilter.m
+
+#include "separable_pass.h"
+#include "../../common_includes.h"
+#include "../../gl/caps.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+using namespace ogles_gpgpu;
+
+SeparableKernel::SeparableKernel(const std::vector<GLfloat>& weights)
+    : weights(weights) {
+    assert(weights.size() % 2 == 1);
+}
+
+SeparableKernel SeparableKernel::gaussian(int radius, float sigma) {
+    std::vector<GLfloat> standardGaussianWeights(radius + 1);
+    GLfloat sumOfWeights = 0.0;
+
+    GLfloat sigma2 = sigma * sigma;
+    GLfloat norm = (1.0 / std::sqrt(2.0 * M_PI * sigma2));
+    for (int i = 0; i < (radius + 1); i++) {
+        standardGaussianWeights[i] = norm * std::exp(-std::pow(i, 2.0) / (2.0 * sigma2));
+        if (i == 0) {
+            sumOfWeights += standardGaussianWeights[i];
+        } else {
+            sumOfWeights += 2.0 * standardGaussianWeights[i];
+        }
+    }
+
+    // Normalize these weights to prevent the clipping of the Gaussian curve at the end of the discrete samples from reducing luminance
+    std::vector<GLfloat> result(2 * radius + 1);
+    for (int i = 0; i < (radius + 1); i++) {
+        result[radius + i] = result[radius - i] = standardGaussianWeights[i] / sumOfWeights;
+    }
+
+    return SeparableKernel(result);
+}
+
+SeparableKernel SeparableKernel::box(int radius) {
+    GLfloat boxWeight = 1.0 / GLfloat((radius * 2) + 1);
+    return SeparableKernel(std::vector<GLfloat>(2 * radius + 1, boxWeight));
+}
+
+SeparableKernel SeparableKernel::gaussianDerivative(int radius, float sigma) {
+    const SeparableKernel g = gaussian(radius, sigma);
+
+    // response to a unit ramp: sum(i * w(i)) == 1
+    double moment = 0.0;
+    for (int i = -radius; i <= radius; i++) {
+        moment += i * i * g.weights[radius + i];
+    }
+
+    std::vector<GLfloat> result(2 * radius + 1);
+    for (int i = -radius; i <= radius; i++) {
+        result[radius + i] = static_cast<GLfloat>(i * g.weights[radius + i] / moment);
+    }
+
+    return SeparableKernel(result);
+}
+
+GLfloat SeparableKernel::getSum() const {
+    GLfloat sum = 0.0f;
+    for (auto weight : weights) {
+        sum += weight;
+    }
+    return sum;
+}
+
+std::vector<SeparableKernel::Tap> SeparableKernel::getTaps() const {
+    const int radius = getRadius();
+
+    std::vector<Tap> taps;
+    if (weights.empty()) {
+        return taps;
+    }
+
+    if (weights[radius] != 0.0f) {
+        taps.push_back({ 0.0f, weights[radius] });
+    }
+
+    // taps of both sides, ordered by distance
+    std::vector<Tap> sides[2];
+    for (int side = 0; side < 2; side++) {
+        const int sign = side ? -1 : 1;
+        for (int i = 1; i <= radius;) {
+            const GLfloat firstWeight = weights[radius + sign * i];
+            const GLfloat secondWeight = (i < radius) ? weights[radius + sign * (i + 1)] : 0.0f;
+
+            if (firstWeight != 0.0f && secondWeight != 0.0f && ((firstWeight > 0.0f) == (secondWeight > 0.0f))) {
+                // one bilinear read at the weighted position between both pixels
+                GLfloat optimizedWeight = firstWeight + secondWeight;
+                GLfloat optimizedOffset = (firstWeight * i + secondWeight * (i + 1)) / optimizedWeight;
+                sides[side].push_back({ sign * optimizedOffset, optimizedWeight });
+                i += 2;
+            } else {
+                if (firstWeight != 0.0f) {
+                    sides[side].push_back({ static_cast<GLfloat>(sign * i), firstWeight });
+                }
+                i += 1;
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < std::max(sides[0].size(), sides[1].size()); i++) {
+        for (const auto& side : sides) {
+            if (i < side.size()) {
+                taps.push_back(side[i]);
+            }
+        }
+    }
+
+    return taps;
+}
+
+// Number of taps with a texture coordinate varying (the center coordinate uses the first varying)
+static int getNumberOfVaryingTaps(const std::vector<SeparableKernel::Tap>& taps, int maxVaryings) {
+    int count = 0;
+    for (const auto& tap : taps) {
+        count += (tap.offset != 0.0f);
+    }
+    return std::max(0, std::min(count, maxVaryings - 1));
+}
+
+// Write "<coord> + singleStepOffset * <offset>" for signed offsets
+static void writeOffsetCoordinate(std::stringstream& ss, const char* coord, GLfloat offset) {
+    ss << coord << ((offset < 0.0f) ? " - " : " + ") << "singleStepOffset * " << std::abs(offset);
+}
+
+std::string ogles_gpgpu::vertexShaderForSeparableKernel(const std::vector<SeparableKernel::Tap>& taps, int maxVaryings) {
+    const int numberOfVaryingTaps = getNumberOfVaryingTaps(taps, maxVaryings);
+
+    std::stringstream ss;
+    ss << std::showpoint; // float literals
+    ss << "attribute vec4 position;\n";
+    ss << "attribute vec4 inputTextureCoordinate;\n";
+    ss << "uniform float texelWidthOffset;\n";
+    ss << "uniform float texelHeightOffset;\n\n";
+    ss << "varying vec2 blurCoordinates[" << (1 + numberOfVaryingTaps) << "];\n\n";
+    ss << "void main()\n";
+    ss << "{\n";
+    ss << "   gl_Position = position;\n";
+    ss << "   vec2 singleStepOffset = vec2(texelWidthOffset, texelHeightOffset);\n";
+    ss << "   blurCoordinates[0] = inputTextureCoordinate.xy;\n";
+
+    int varying = 1;
+    for (const auto& tap : taps) {
+        if (tap.offset != 0.0f && varying <= numberOfVaryingTaps) {
+            ss << "   blurCoordinates[" << varying++ << "] = ";
+            writeOffsetCoordinate(ss, "inputTextureCoordinate.xy", tap.offset);
+            ss << ";\n";
+        }
+    }
+    ss << "}\n";
+
+    return ss.str();
+}
+
+std::string ogles_gpgpu::fragmentShaderForSeparableKernel(const std::vector<SeparableKernel::Tap>& taps, int maxVaryings, const std::string& output) {
+    const int numberOfVaryingTaps = getNumberOfVaryingTaps(taps, maxVaryings);
+
+    std::stringstream ss;
+    ss << std::showpoint; // float literals
+#if defined(OGLES_GPGPU_OPENGLES)
+    ss << "precision highp float;\n";
+    ss << "\n";
+#endif
+    ss << "uniform sampler2D inputImageTexture;\n";
+    ss << "uniform float texelWidthOffset;\n";
+    ss << "uniform float texelHeightOffset;\n\n";
+    ss << "varying vec2 blurCoordinates[" << (1 + numberOfVaryingTaps) << "];\n\n";
+    ss << "void main()\n";
+    ss << "{\n";
+    ss << "   vec4 sum = vec4(0.0);\n";
+    ss << "   vec4 center = texture2D(inputImageTexture, blurCoordinates[0]);\n";
+    ss << "   vec2 singleStepOffset = vec2(texelWidthOffset, texelHeightOffset);\n";
+
+    int varying = 1;
+    for (const auto& tap : taps) {
+        if (tap.offset == 0.0f) {
+            ss << "   sum += center * " << tap.weight << ";\n";
+        } else if (varying <= numberOfVaryingTaps) {
+            ss << "   sum += texture2D(inputImageTexture, blurCoordinates[" << varying++ << "]) * " << tap.weight << ";\n";
+        } else {
+            // If the number of required samples exceeds the amount we can pass in via varyings, we have to do dependent texture reads
+            ss << "   sum += texture2D(inputImageTexture, ";
+            writeOffsetCoordinate(ss, "blurCoordinates[0]", tap.offset);
+            ss << ") * " << tap.weight << ";\n";
+        }
+    }
+
+    ss << output;
+    ss << "}\n";
+
+    return ss.str();
+}
+
+std::string ogles_gpgpu::computeShaderForSeparableKernel(const SeparableKernel& kernel, int pass, const std::string& output, int tileSize) {
+    const int radius = kernel.getRadius();
+    const int tileLength = tileSize + 2 * radius;
+    const char* direction = (pass == 1) ? "x" : "y";
+
+    // the fragment shader output statements write gl_FragColor
+    std::string result(output);
+    Tools::strReplaceAll(result, "gl_FragColor", "result");
+
+    std::stringstream ss;
+    ss << std::showpoint; // float literals
+    ss << "#version 430\n";
+    ss << "layout(local_size_x = " << ((pass == 1) ? tileSize : 1) << ", local_size_y = " << ((pass == 1) ? 1 : tileSize) << ") in;\n\n";
+    ss << "uniform sampler2D inputImageTexture;\n";
+    ss << "layout(rgba8, binding = 0) writeonly uniform image2D outputImage;\n\n";
+    ss << "shared vec4 tile[" << tileLength << "];\n\n";
+    ss << "void main()\n";
+    ss << "{\n";
+    ss << "   ivec2 size = imageSize(outputImage);\n";
+    ss << "   ivec2 pos = ivec2(gl_GlobalInvocationID.xy);\n";
+    ss << "   int local = int(gl_LocalInvocationID." << direction << ");\n";
+    ss << "   vec2 singleStepOffset = vec2(" << ((pass == 1) ? "1.0, 0.0" : "0.0, 1.0") << ") / vec2(size);\n\n";
+    ss << "   // the tile holds the pixels of the work group and " << radius << " pixels on both sides\n";
+    ss << "   vec2 tileCoordinate = (vec2(pos) + 0.5) / vec2(size) - singleStepOffset * float(local + " << radius << ");\n";
+    ss << "   for (int i = local; i < " << tileLength << "; i += " << tileSize << ") {\n";
+    ss << "      tile[i] = textureLod(inputImageTexture, tileCoordinate + singleStepOffset * float(i), 0.0);\n";
+    ss << "   }\n";
+    ss << "   barrier();\n\n";
+    ss << "   if (pos.x >= size.x || pos.y >= size.y) {\n";
+    ss << "      return;\n";
+    ss << "   }\n\n";
+    ss << "   vec4 center = tile[local + " << radius << "];\n";
+    ss << "   vec4 sum = vec4(0.0);\n";
+
+    const auto& weights = kernel.getWeights();
+    for (int i = 0; i < static_cast<int>(weights.size()); i++) {
+        if (weights[i] != 0.0f) {
+            ss << "   sum += tile[local + " << i << "] * " << weights[i] << ";\n";
+        }
+    }
+
+    ss << "   vec4 result;\n";
+    ss << result;
+    ss << "   imageStore(outputImage, pos, result);\n";
+    ss << "}\n";
+
+    return ss.str();
+}
+
+SeparableProcPass::SeparableProcPass(int pass, const SeparableKernel& kernel)
+    : FilterProcBase()
+    , renderPass(pass)
+    , kernel(kernel) {
+    assert(renderPass == 1 || renderPass == 2);
+}
+
+void SeparableProcPass::setKernel(const SeparableKernel& newKernel) {
+    kernel = newKernel;
+    vshaderSrc.clear();
+    fshaderSrc.clear();
+    cshaderSrc.clear();
+}
+
+void SeparableProcPass::setOutputOffset(float value) {
+    outputOffset = value;
+    fshaderSrc.clear();
+    cshaderSrc.clear();
+}
+
+std::string SeparableProcPass::getFragmentShaderOutput() {
+    std::stringstream ss;
+    if (outputOffset != 0.0f) {
+        ss << "   gl_FragColor = sum + vec4(" << outputOffset << ");\n";
+    } else {
+        ss << "   gl_FragColor = sum;\n";
+    }
+    return ss.str();
+}
+
+void SeparableProcPass::filterShaderSetup(const char* vShaderSrc, const char* fShaderSrc, GLenum target) {
+    // create shader object
+    ProcBase::createShader(vShaderSrc, fShaderSrc, target);
+
+    // get shader params
+    shParamAPos = shader->getParam(ATTR, "position");
+    shParamATexCoord = shader->getParam(ATTR, "inputTextureCoordinate");
+    Tools::checkGLErr(getProcName(), "filterShaderSetup");
+}
+
+void SeparableProcPass::setUniforms() {
+    FilterProcBase::setUniforms();
+
+    shParamUTexelWidthOffset.set((renderPass == 1) * pxDx);
+    shParamUTexelHeightOffset.set((renderPass == 2) * pxDy);
+}
+
+void SeparableProcPass::getUniforms() {
+    FilterProcBase::getUniforms();
+
+    // calculate pixel delta values
+    pxDx = 1.0f / (float)outFrameW;
+    pxDy = 1.0f / (float)outFrameH;
+
+    shParamUInputTex.init(shader.get(), "inputImageTexture");
+    shParamUTexelWidthOffset.init(shader.get(), "texelWidthOffset");
+    shParamUTexelHeightOffset.init(shader.get(), "texelHeightOffset");
+}
+
+// Varyings for texture coordinates. One vector is reserved, as some implementations count gl_Position
+static int getMaxVaryings() {
+    return std::max(1, GLCaps::get().maxVaryingVectors - 1);
+}
+
+const char* SeparableProcPass::getFragmentShaderSource() {
+    if (fshaderSrc.empty()) {
+        fshaderSrc = fragmentShaderForSeparableKernel(kernel.getTaps(), getMaxVaryings(), getFragmentShaderOutput());
+    }
+    return fshaderSrc.c_str();
+}
+
+const char* SeparableProcPass::getVertexShaderSource() {
+    if (vshaderSrc.empty()) {
+        vshaderSrc = vertexShaderForSeparableKernel(kernel.getTaps(), getMaxVaryings());
+    }
+    return vshaderSrc.c_str();
+}
+
+const char* SeparableProcPass::getComputeShaderSource() {
+    if (cshaderSrc.empty()) {
+        cshaderSrc = computeShaderForSeparableKernel(kernel, renderPass, getFragmentShaderOutput());
+    }
+    return cshaderSrc.c_str();
+}
@@ -0,0 +1,188 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+/**
+ * GPGPU separable filter render pass.
+ */
+#ifndef OGLES_GPGPU_COMMON_PROC_SEPARABLE_PASS
+#define OGLES_GPGPU_COMMON_PROC_SEPARABLE_PASS
+
+#include "../../common_includes.h"
+
+#include "../base/filterprocbase.h"
+
+#include <string>
+#include <vector>
+
+namespace ogles_gpgpu {
+
+/**
+ * 1D filter kernel with weights at the integer offsets -radius..radius.
+ */
+class SeparableKernel {
+public:
+    /**
+     * Texture read with weight <weight> at <offset> pixels from the center.
+     */
+    struct Tap {
+        GLfloat offset;
+        GLfloat weight;
+    };
+
+    /**
+     * Construct an empty kernel.
+     */
+    SeparableKernel() {}
+
+    /**
+     * Construct a kernel from <weights> at offsets -radius..radius (2 * radius + 1 values).
+     */
+    explicit SeparableKernel(const std::vector<GLfloat>& weights);
+
+    /**
+     * Normalized gaussian kernel with standard deviation <sigma>.
+     */
+    static SeparableKernel gaussian(int radius, float sigma);
+
+    /**
+     * Normalized box kernel.
+     */
+    static SeparableKernel box(int radius);
+
+    /**
+     * First derivative of a gaussian with standard deviation <sigma>, scaled to
+     * a response of 1 for a unit ramp.
+     */
+    static SeparableKernel gaussianDerivative(int radius, float sigma);
+
+    /**
+     * Get the kernel radius.
+     */
+    int getRadius() const {
+        return static_cast<int>(weights.size() / 2);
+    }
+
+    /**
+     * Get the weights at offsets -radius..radius.
+     */
+    const std::vector<GLfloat>& getWeights() const {
+        return weights;
+    }
+
+    /**
+     * Get the sum of all weights.
+     */
+    GLfloat getSum() const;
+
+    /**
+     * Get the texture reads for this kernel. Neighbouring weights of equal sign are merged
+     * into one bilinear read between both pixels. Zero weights are skipped. The center
+     * read comes first (if any), followed by reads of increasing distance, alternating
+     * between the positive and the negative side.
+     */
+    std::vector<Tap> getTaps() const;
+
+private:
+    std::vector<GLfloat> weights;
+};
+
+/**
+ * Render pass of a separable filter, i.e. a filter with kernel <kernel> in horizontal
+ * (pass 1) or vertical (pass 2) direction.
+ *
+ * The shaders are generated for the current OpenGL context: texture coordinates are
+ * calculated in the vertex shader for as many reads as the GL_MAX_VARYING_VECTORS limit
+ * allows, all other reads calculate their coordinates in the fragment shader (dependent
+ * texture reads).
+ *
+ * On the compute backend (see setBackend()), each work group reads a tile of pixels into
+ * shared memory once, and all pixels of the group filter from the tile.
+ */
+class SeparableProcPass : public FilterProcBase {
+public:
+    /**
+     * Construct as render pass <pass> (1 or 2) with kernel <kernel>.
+     */
+    SeparableProcPass(int pass, const SeparableKernel& kernel = SeparableKernel());
+
+    /**
+     * Return the processors name.
+     */
+    virtual const char* getProcName() {
+        return "SeparableProcPass";
+    }
+
+    /**
+     * Set the filter kernel. Must be called before init().
+     */
+    void setKernel(const SeparableKernel& newKernel);
+
+    /**
+     * Get the filter kernel.
+     */
+    const SeparableKernel& getKernel() const {
+        return kernel;
+    }
+
+    /**
+     * Add <value> to the filter result, i.e. to store signed results in unsigned textures.
+     * Must be called before init().
+     */
+    void setOutputOffset(float value);
+
+    virtual void filterShaderSetup(const char* vShaderSrc, const char* fShaderSrc, GLenum target);
+    virtual void setUniforms();
+    virtual void getUniforms();
+    virtual const char* getFragmentShaderSource();
+    virtual const char* getVertexShaderSource();
+
+protected:
+    virtual const char* getComputeShaderSource();
+
+    /**
+     * Get the GLSL statements that write gl_FragColor from the filter result <sum> and
+     * the center pixel <center>.
+     */
+    virtual std::string getFragmentShaderOutput();
+
+    int renderPass; // render pass number. must be 1 or 2
+
+    float pxDx = 0.0f; // pixel delta value for texture access
+    float pxDy = 0.0f; // pixel delta value for texture access
+
+    SeparableKernel kernel;
+    float outputOffset = 0.0f;
+
+    Uniform<GLfloat> shParamUTexelWidthOffset;
+    Uniform<GLfloat> shParamUTexelHeightOffset;
+
+    std::string vshaderSrc; // generated on demand
+    std::string fshaderSrc;
+    std::string cshaderSrc;
+};
+
+/**
+ * Get the vertex shader for the texture reads <taps>, with at most <maxVaryings> texture
+ * coordinate varyings.
+ */
+std::string vertexShaderForSeparableKernel(const std::vector<SeparableKernel::Tap>& taps, int maxVaryings);
+
+/**
+ * Get the fragment shader for the texture reads <taps>, with at most <maxVaryings> texture
+ * coordinate varyings (see vertexShaderForSeparableKernel()) and result statements <output>.
+ */
+std::string fragmentShaderForSeparableKernel(const std::vector<SeparableKernel::Tap>& taps, int maxVaryings, const std::string& output);
+
+/**
+ * Get the compute shader for kernel <kernel> in horizontal (pass 1) or vertical (pass 2)
+ * direction, with result statements <output> (see fragmentShaderForSeparableKernel()).
+ * The shader reads a tile of <tileSize> + 2 * radius pixels into shared memory per work group
+ * of <tileSize> pixels.
+ */
+std::string computeShaderForSeparableKernel(const SeparableKernel& kernel, int pass, const std::string& output, int tileSize = 64);
+}
+
+#endif
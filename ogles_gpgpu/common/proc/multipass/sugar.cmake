@@ -23,4 +23,6 @@ sugar_files(
     box_opt_pass.h
     local_norm_pass.cpp
     local_norm_pass.h
+    separable_pass.cpp
+    separable_pass.h
 )
@@ -9,135 +9,87 @@
 #include "nms.h"
 #include "../common_includes.h"
 
-#include <regex>
-
 using namespace std;
 using namespace ogles_gpgpu;
 
 // clang-format off
-const char *NmsProc::fshaderNmsSrc = 
-#if defined(OGLES_GPGPU_OPENGLES)
-OG_TO_STR(precision highp float;)
-#endif
-OG_TO_STR(
- uniform sampler2D inputImageTexture;
-
- varying vec2 textureCoordinate;
- varying vec2 leftTextureCoordinate;
- varying vec2 rightTextureCoordinate;
-
- varying vec2 topTextureCoordinate;
- varying vec2 topLeftTextureCoordinate;
- varying vec2 topRightTextureCoordinate;
-
- varying vec2 bottomTextureCoordinate;
- varying vec2 bottomLeftTextureCoordinate;
- varying vec2 bottomRightTextureCoordinate;
-
- uniform float threshold;
-
- void main()
- {
-     float bottomColor = texture2D(inputImageTexture, bottomTextureCoordinate).r;
-     float bottomLeftColor = texture2D(inputImageTexture, bottomLeftTextureCoordinate).r;
-     float bottomRightColor = texture2D(inputImageTexture, bottomRightTextureCoordinate).r;
-     vec4 centerColor = texture2D(inputImageTexture, textureCoordinate);
-     float leftColor = texture2D(inputImageTexture, leftTextureCoordinate).r;
-     float rightColor = texture2D(inputImageTexture, rightTextureCoordinate).r;
-     float topColor = texture2D(inputImageTexture, topTextureCoordinate).r;
-     float topRightColor = texture2D(inputImageTexture, topRightTextureCoordinate).r;
-     float topLeftColor = texture2D(inputImageTexture, topLeftTextureCoordinate).r;
-
-     // Use a tiebreaker for pixels to the left and immediately above this one
-     float multiplier = 1.0 - step(centerColor.r, topColor);
-     multiplier = multiplier * (1.0 - step(centerColor.r, topLeftColor));
-     multiplier = multiplier * (1.0 - step(centerColor.r, leftColor));
-     multiplier = multiplier * (1.0 - step(centerColor.r, bottomLeftColor));
-
-     float maxValue = max(centerColor.r, bottomColor);
-     maxValue = max(maxValue, bottomRightColor);
-     maxValue = max(maxValue, rightColor);
-     maxValue = max(maxValue, topRightColor);
-
-     float finalValue = centerColor.r * step(maxValue, centerColor.r) * multiplier;
-     finalValue = step(threshold, finalValue) * centerColor.r; // use this to report peak scores
-
-     gl_FragColor = vec4(finalValue, centerColor.gba); // DO NOT EDIT (see swizzle)
-});
+// Non max suppression on channel OG_IN, result written to channel OG_OUT
+#define OGLES_GPGPU_NMS_FSH OG_TO_STR(                                                                  \
+ uniform float threshold;                                                                               \
+                                                                                                        \
+ void main()                                                                                            \
+ {                                                                                                      \
+     float bottomColor = OG_TEXEL(bottomTextureCoordinate, 0, 1).OG_IN;                                 \
+     float bottomLeftColor = OG_TEXEL(bottomLeftTextureCoordinate, -1, 1).OG_IN;                        \
+     float bottomRightColor = OG_TEXEL(bottomRightTextureCoordinate, 1, 1).OG_IN;                       \
+     vec4 centerColor = OG_TEXEL(textureCoordinate, 0, 0);                                              \
+     float leftColor = OG_TEXEL(leftTextureCoordinate, -1, 0).OG_IN;                                    \
+     float rightColor = OG_TEXEL(rightTextureCoordinate, 1, 0).OG_IN;                                   \
+     float topColor = OG_TEXEL(topTextureCoordinate, 0, -1).OG_IN;                                      \
+     float topRightColor = OG_TEXEL(topRightTextureCoordinate, 1, -1).OG_IN;                            \
+     float topLeftColor = OG_TEXEL(topLeftTextureCoordinate, -1, -1).OG_IN;                             \
+                                                                                                        \
+     /* Use a tiebreaker for pixels to the left and immediately above this one */                       \
+     float multiplier = 1.0 - step(centerColor.OG_IN, topColor);                                        \
+     multiplier = multiplier * (1.0 - step(centerColor.OG_IN, topLeftColor));                           \
+     multiplier = multiplier * (1.0 - step(centerColor.OG_IN, leftColor));                              \
+     multiplier = multiplier * (1.0 - step(centerColor.OG_IN, bottomLeftColor));                        \
+                                                                                                        \
+     float maxValue = max(centerColor.OG_IN, bottomColor);                                              \
+     maxValue = max(maxValue, bottomRightColor);                                                        \
+     maxValue = max(maxValue, rightColor);                                                              \
+     maxValue = max(maxValue, topRightColor);                                                           \
+                                                                                                        \
+     float finalValue = centerColor.OG_IN * step(maxValue, centerColor.OG_IN) * multiplier;             \
+     finalValue = step(threshold, finalValue) * centerColor.OG_IN; /* use this to report peak scores */ \
+                                                                                                        \
+     vec4 result = centerColor;                                                                         \
+     result.OG_OUT = finalValue;                                                                        \
+     OG_FRAG_COLOR = result;                                                                            \
+})
+
+#define OGLES_GPGPU_NMS_DEFINES(in, out) OG_GLSL_DEFINE(OG_IN, in) OG_GLSL_DEFINE(OG_OUT, out)
+#define OGLES_GPGPU_NMS_VARIANT(in, out) { "NmsProc", #in #out, nullptr, OGLES_GPGPU_NMS_DEFINES(in, out) OGLES_GPGPU_FILTER3X3_FSH_HEADER OGLES_GPGPU_NMS_FSH }
+#define OGLES_GPGPU_NMS_VARIANT_TEXEL_FETCH(in, out) { "NmsProc", #in #out "_texelFetch", Filter3x3Proc::vshaderFilter3x3TexelFetchSrc, \
+    OG_GLSL3_VERSION OGLES_GPGPU_NMS_DEFINES(in, out) OGLES_GPGPU_FILTER3X3_FSH_HEADER_TEXEL_FETCH OGLES_GPGPU_NMS_FSH }
+#define OGLES_GPGPU_NMS_VARIANTS(variant, in) variant(in, r), variant(in, g), variant(in, b), variant(in, a)
+
+// variants by read and input and output channel: [texelFetch * 16 + channelIn * 4 + channelOut]
+const ShaderVariant NmsProc::fshaderNmsVariants[32] = {
+    OGLES_GPGPU_NMS_VARIANTS(OGLES_GPGPU_NMS_VARIANT, r),
+    OGLES_GPGPU_NMS_VARIANTS(OGLES_GPGPU_NMS_VARIANT, g),
+    OGLES_GPGPU_NMS_VARIANTS(OGLES_GPGPU_NMS_VARIANT, b),
+    OGLES_GPGPU_NMS_VARIANTS(OGLES_GPGPU_NMS_VARIANT, a),
+    OGLES_GPGPU_NMS_VARIANTS(OGLES_GPGPU_NMS_VARIANT_TEXEL_FETCH, r),
+    OGLES_GPGPU_NMS_VARIANTS(OGLES_GPGPU_NMS_VARIANT_TEXEL_FETCH, g),
+    OGLES_GPGPU_NMS_VARIANTS(OGLES_GPGPU_NMS_VARIANT_TEXEL_FETCH, b),
+    OGLES_GPGPU_NMS_VARIANTS(OGLES_GPGPU_NMS_VARIANT_TEXEL_FETCH, a)
+};
 // clang-format on
 
+static ShaderVariants::Registrar nmsVariantsRegistrar(NmsProc::fshaderNmsVariants, 32);
+
 NmsProc::NmsProc() {
 }
 
 void NmsProc::setUniforms() {
     Filter3x3Proc::setUniforms();
-    glUniform1f(shParamUThreshold, threshold);
+    shParamUThreshold.set(threshold);
 }
 
 void NmsProc::getUniforms() {
     Filter3x3Proc::getUniforms();
-    shParamUInputTex = shader->getParam(UNIF, "inputImageTexture");
-    shParamUThreshold = shader->getParam(UNIF, "threshold");
+    shParamUInputTex.init(shader.get(), "inputImageTexture");
+    shParamUThreshold.init(shader.get(), "threshold");
 }
 
 void NmsProc::swizzle(int channelIn, int channelOut) {
-    std::string new1, new2;
-
     if (channelOut < 0) {
         channelOut = channelIn;
     }
 
-    fshaderNmsSwizzleSrc.clear();
-    fshaderNmsSwizzleSrc += fshaderNmsSrc; // deep copy
-
-    switch (channelIn) {
-    case 0:
-        break; // R
-    case 1: {
-        new1 = ".g"; // G
-        break;
-    }
-    case 2: {
-        new1 = ".b"; // B
-        break;
-    }
-    case 3: {
-        new1 = ".a"; // A
-        break;
-    }
-    default:
-        assert(false);
-    }
-
-    switch (channelOut) {
-    case 0:
-        break;
-    case 1: {
-        new2 = "vec4(centerColor.r, finalValue, centerColor.ba)";
-        break;
-    }
-    case 2: {
-        new2 = "vec4(centerColor.rg, finalValue, centerColor.a)";
-        break;
-    }
-    case 3: {
-        new2 = "vec4(centerColor.rgb, finalValue)";
-        break;
-    }
-    default:
-        assert(false);
-    }
-
-    const std::regex pattern1("\\.r");
-    const std::regex pattern2("vec4\\(finalValue, centerColor.gba\\)");
+    assert(channelIn >= 0 && channelIn < 4);
+    assert(channelOut >= 0 && channelOut < 4);
 
-    if (!new1.empty()) {
-        auto fshader1 = std::regex_replace(fshaderNmsSwizzleSrc, pattern1, new1);
-        std::swap(fshader1, fshaderNmsSwizzleSrc);
-    }
-
-    if (!new2.empty()) {
-        auto fshader2 = std::regex_replace(fshaderNmsSwizzleSrc, pattern2, new2);
-        std::swap(fshader2, fshaderNmsSwizzleSrc);
-    }
+    variant = channelIn * 4 + channelOut;
 }
@@ -13,6 +13,7 @@
 #define OGLES_GPGPU_COMMON_PROC_NMS
 
 #include "ogles_gpgpu/common/proc/filter3x3.h"
+#include "ogles_gpgpu/common/gl/shader_variant.h"
 
 namespace ogles_gpgpu {
 
@@ -47,14 +48,27 @@ public:
         return threshold;
     }
 
+    /**
+     * Run the non max suppression on channel <channelIn> (0: R, ..., 3: A) and write the
+     * result to channel <channelOut> (default: <channelIn>). Must be called before init().
+     */
     void swizzle(int channelIn, int channelOut = -1);
 
+    static const ShaderVariant fshaderNmsVariants[32]; // fragment shader sources by read type, input and output channel
+
 private:
     /**
      * Get the fragment shader source.
      */
     virtual const char* getFragmentShaderSource() {
-        return fshaderNmsSwizzleSrc.empty() ? fshaderNmsSrc : fshaderNmsSwizzleSrc.c_str();
+        return fshaderNmsVariants[useTexelFetch() * 16 + variant].fshSrc;
+    }
+
+    /**
+     * The shaders support texelFetch() reads.
+     */
+    virtual bool hasTexelFetchShader() const {
+        return true;
     }
 
     /**
@@ -67,11 +81,9 @@ private:
      */
     virtual void setUniforms();
 
-    static const char* fshaderNmsSrc; // fragment shader source
-
-    std::string fshaderNmsSwizzleSrc;
+    int variant = 0; // index of the fshaderNmsVariants (R -> R)
 
-    GLuint shParamUThreshold;
+    Uniform<GLfloat> shParamUThreshold;
 
     float threshold = 0.9;
 };
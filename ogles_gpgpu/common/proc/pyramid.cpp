@@ -12,6 +12,36 @@
 using namespace std;
 using namespace ogles_gpgpu;
 
+// clang-format off
+const char *PyramidProc::vshaderPyramidSrc = OG_TO_STR(
+attribute vec4 aPos;
+attribute vec2 aTexCoord;
+attribute vec4 aLevelRect;
+varying vec2 vTexCoord;
+uniform mat4 transformMatrix;
+void main()
+{
+    vec4 pos = transformMatrix * vec4(aPos.xyz, 1.0);
+    gl_Position = vec4(pos.xy * aLevelRect.zw + aLevelRect.xy * pos.w, pos.z, pos.w);
+    vTexCoord = aTexCoord;
+}
+);
+// clang-format on
+
+// triangle list indices for a quad given as triangle strip
+static const int kQuadTriangles[] = { 0, 1, 2, 2, 1, 3 };
+static const int kQuadTriangleVertices = sizeof(kQuadTriangles) / sizeof(kQuadTriangles[0]);
+
+// level rectangle for rendering a single level with its own viewport
+static const GLfloat kUnitLevelRects[kQuadTriangleVertices * 4] = {
+    0, 0, 1, 1,
+    0, 0, 1, 1,
+    0, 0, 1, 1,
+    0, 0, 1, 1,
+    0, 0, 1, 1,
+    0, 0, 1, 1
+};
+
 static std::vector<Rect2d> pack(const std::vector<Size2d>& src) {
     std::vector<Rect2d> packed;
 
@@ -86,8 +116,112 @@ const std::vector<Rect2d>& PyramidProc::getLevelCrops() const {
     return m_crops;
 }
 
+const char* PyramidProc::getVertexShaderSource() {
+    return vshaderPyramidSrc;
+}
+
+void PyramidProc::getUniforms() {
+    TransformProc::getUniforms();
+    shParamALevelRect = shader->getParam(ATTR, "aLevelRect");
+}
+
+bool PyramidProc::hasIdentityTransform() const {
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            if (transformMatrix.data[i][j] != GLfloat(i == j)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Batch one quad per level into a triangle list. Each vertex carries the level's
+// destination rectangle in normalized device coordinates (center offset, half size).
+// This is rebuilt per frame (a few floats per level) to follow changes of the crops,
+// output size or render orientation.
+void PyramidProc::updateLevelGeometry() {
+    const int count = static_cast<int>(m_crops.size()) * kQuadTriangleVertices;
+    m_levelVertices.resize(count * OGLES_GPGPU_QUAD_COORDS_PER_VERTEX);
+    m_levelTexCoords.resize(count * OGLES_GPGPU_QUAD_TEXCOORDS_PER_VERTEX);
+    m_levelRects.resize(count * 4);
+
+    GLfloat* vertices = m_levelVertices.data();
+    GLfloat* texCoords = m_levelTexCoords.data();
+    GLfloat* rects = m_levelRects.data();
+    for (const auto& c : m_crops) {
+        const GLfloat sx = GLfloat(c.width) / GLfloat(outFrameW);
+        const GLfloat sy = GLfloat(c.height) / GLfloat(outFrameH);
+        const GLfloat tx = GLfloat(2 * c.x + c.width) / GLfloat(outFrameW) - 1.f;
+        const GLfloat ty = GLfloat(2 * c.y + c.height) / GLfloat(outFrameH) - 1.f;
+
+        for (int i = 0; i < kQuadTriangleVertices; i++) {
+            const int v = kQuadTriangles[i];
+            for (int j = 0; j < OGLES_GPGPU_QUAD_COORDS_PER_VERTEX; j++) {
+                *vertices++ = vertexBuf[v * OGLES_GPGPU_QUAD_COORDS_PER_VERTEX + j];
+            }
+            for (int j = 0; j < OGLES_GPGPU_QUAD_TEXCOORDS_PER_VERTEX; j++) {
+                *texCoords++ = texCoordBuf[v * OGLES_GPGPU_QUAD_TEXCOORDS_PER_VERTEX + j];
+            }
+            *rects++ = tx;
+            *rects++ = ty;
+            *rects++ = sx;
+            *rects++ = sy;
+        }
+    }
+}
+
+void PyramidProc::filterRenderSetCoords() {
+    // render to FBO
+    if (fbo)
+        fbo->bind();
+
+    // set batched level geometry
+    glEnableVertexAttribArray(shParamAPos);
+    glVertexAttribPointer(shParamAPos,
+        OGLES_GPGPU_QUAD_COORDS_PER_VERTEX,
+        GL_FLOAT,
+        GL_FALSE,
+        0,
+        m_levelVertices.data());
+
+    glVertexAttribPointer(shParamATexCoord,
+        OGLES_GPGPU_QUAD_TEXCOORDS_PER_VERTEX,
+        GL_FLOAT,
+        GL_FALSE,
+        0,
+        m_levelTexCoords.data());
+    glEnableVertexAttribArray(shParamATexCoord);
+}
+
+void PyramidProc::renderLevels() {
+    glEnableVertexAttribArray(shParamALevelRect);
+
+    if (hasIdentityTransform()) {
+        // all levels in one draw call
+        glVertexAttribPointer(shParamALevelRect, 4, GL_FLOAT, GL_FALSE, 0, m_levelRects.data());
+        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_crops.size()) * kQuadTriangleVertices);
+        OG_GL_COUNT(drawCalls);
+    } else {
+        // clip each level to its own viewport (the first batched quad is the untransformed level quad)
+        glVertexAttribPointer(shParamALevelRect, 4, GL_FLOAT, GL_FALSE, 0, kUnitLevelRects);
+        for (auto& c : m_crops) {
+            glViewport(c.x, c.y, c.width, c.height);
+            glDrawArrays(GL_TRIANGLES, 0, kQuadTriangleVertices);
+            OG_GL_COUNT(drawCalls);
+        }
+    }
+
+    glDisableVertexAttribArray(shParamALevelRect);
+}
+
 int PyramidProc::PyramidProc::render(int position) {
     OG_LOGINF(getProcName(), "input tex %d, target %d, framebuffer of size %dx%d", texId, texTarget, outFrameW, outFrameH);
+
+    updateRenderTarget();
+
+    updateLevelGeometry();
+
     filterRenderPrepare();
 
     setUniforms();
@@ -101,10 +235,7 @@ int PyramidProc::PyramidProc::render(int position) {
     glClear(GL_COLOR_BUFFER_BIT);
     glClearColor(0, 0, 0, 1);
 
-    for (auto& c : m_crops) {
-        glViewport(c.x, c.y, c.width, c.height);
-        filterRenderDraw();
-    }
+    renderLevels();
     Tools::checkGLErr(getProcName(), "render draw");
 
     filterRenderCleanup();
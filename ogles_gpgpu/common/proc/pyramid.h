@@ -21,7 +21,12 @@
 namespace ogles_gpgpu {
 
 /**
- * GPGPU transform processor to create a flat pyramid
+ * GPGPU transform processor to create a flat pyramid.
+ *
+ * All levels are rendered with a single draw call: the level quads are batched into one
+ * triangle list carrying the destination rectangle of each level as a vertex attribute.
+ * A non-identity transformation matrix can move geometry outside of a level's rectangle,
+ * in which case the levels are rendered one by one with a viewport per level.
  */
 class PyramidProc : public TransformProc {
 public:
@@ -47,6 +52,16 @@ public:
         return "PyramidProc";
     }
 
+    /**
+     * Get the vertex shader source.
+     */
+    virtual const char* getVertexShaderSource();
+
+    /**
+     * Get uniform indices.
+     */
+    virtual void getUniforms();
+
     /**
      *
      */
@@ -67,9 +82,26 @@ public:
      */
     const std::vector<Rect2d>& getLevelCrops() const;
 
+protected:
+    virtual void filterRenderSetCoords();
+
 private:
     virtual void setOutputSize(float scaleFactor);
 
+    void updateLevelGeometry();
+
+    bool hasIdentityTransform() const;
+
+    void renderLevels();
+
+    static const char* vshaderPyramidSrc; // vertex shader source
+
+    GLint shParamALevelRect = -1; // shader attribute level rectangle (ndc offset, scale)
+
+    std::vector<GLfloat> m_levelVertices; // batched level quads (6 vertices per level)
+    std::vector<GLfloat> m_levelTexCoords;
+    std::vector<GLfloat> m_levelRects;
+
     std::vector<Size2d> m_scales;
 
     int m_levels = 4;
@@ -57,8 +57,8 @@ void RemapProc::filterShaderSetup(const char* vShaderSrc, const char* fShaderSrc
     // get shader params
     shParamAPos = shader->getParam(ATTR, "position");
     shParamATexCoord = shader->getParam(ATTR, "inputTextureCoordinate");
-    texelWidthUniform = shader->getParam(UNIF, "texelWidth");
-    texelHeightUniform = shader->getParam(UNIF, "texelHeight");
+    texelWidthUniform.init(shader.get(), "texelWidth");
+    texelHeightUniform.init(shader.get(), "texelHeight");
 
     Tools::checkGLErr(getProcName(), "filterShaderSetup");
 }
@@ -68,6 +68,6 @@ void RemapProc::getUniforms() {
 
 void RemapProc::setUniforms() {
     // Set texel width/height uniforms:
-    glUniform1f(texelWidthUniform, (1.0f / float(outFrameW)));
-    glUniform1f(texelHeightUniform, (1.0f / float(outFrameH)));
+    texelWidthUniform.set((1.0f / float(outFrameW)));
+    texelHeightUniform.set((1.0f / float(outFrameH)));
 }
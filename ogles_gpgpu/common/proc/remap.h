@@ -27,8 +27,8 @@ private:
     void getUniforms();
     void setUniforms();
 
-    GLint texelWidthUniform;
-    GLint texelHeightUniform;
+    Uniform<GLfloat> texelWidthUniform;
+    Uniform<GLfloat> texelHeightUniform;
 
     virtual const char* getVertexShaderSource() {
         return vshaderRemapSrc;
@@ -0,0 +1,49 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+/**
+ * GPGPU separable filter processor (two-pass).
+ */
+#ifndef OGLES_GPGPU_COMMON_PROC_SEPARABLE
+#define OGLES_GPGPU_COMMON_PROC_SEPARABLE
+
+#include "../common_includes.h"
+
+#include "base/multipassproc.h"
+#include "multipass/separable_pass.h"
+
+namespace ogles_gpgpu {
+
+/**
+ * This filter applies a separable filter with kernels <horizontal> and <vertical>
+ * (i.e. SeparableKernel::gaussianDerivative() and SeparableKernel::gaussian()).
+ *
+ * Both passes add <offset> to their result, so that signed results can be stored in
+ * unsigned textures (the vertical pass compensates for the offset of its input).
+ */
+class SeparableFilterProc : public MultiPassProc {
+public:
+    SeparableFilterProc(const SeparableKernel& horizontal, const SeparableKernel& vertical, float offset = 0.0f) {
+        SeparableProcPass* pass1 = new SeparableProcPass(1, horizontal);
+        SeparableProcPass* pass2 = new SeparableProcPass(2, vertical);
+
+        pass1->setOutputOffset(offset);
+        pass2->setOutputOffset(offset * (1.0f - vertical.getSum()));
+
+        procPasses.push_back(pass1);
+        procPasses.push_back(pass2);
+    }
+
+    /**
+     * Return the processors name.
+     */
+    virtual const char* getProcName() {
+        return "SeparableFilterProc";
+    }
+};
+}
+
+#endif
@@ -54,11 +54,11 @@ void ShiTomasiProc::filterShaderSetup(const char* vShaderSrc, const char* fShade
 
 void ShiTomasiProc::getUniforms() {
     FilterProcBase::getUniforms();
-    shParamUInputTex = shader->getParam(UNIF, "inputImageTexture");
-    shParamUInputSensitivity = shader->getParam(UNIF, "sensitivity");
+    shParamUInputTex.init(shader.get(), "inputImageTexture");
+    shParamUInputSensitivity.init(shader.get(), "sensitivity");
 }
 
 void ShiTomasiProc::setUniforms() {
     FilterProcBase::setUniforms();
-    glUniform1f(shParamUInputSensitivity, sensitivity); // set additional uniforms
+    shParamUInputSensitivity.set(sensitivity); // set additional uniforms
 }
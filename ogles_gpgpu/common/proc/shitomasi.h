@@ -79,7 +79,7 @@ private:
 
     static const char* fshaderShiTomasiSrc; // fragment shader source
 
-    GLuint shParamUInputSensitivity = 0;
+    Uniform<GLfloat> shParamUInputSensitivity;
 
     float sensitivity = 1.5f;
 };
@@ -72,6 +72,7 @@ sugar_files(
     rgb2hsv.h#
     rgb2luv.cpp
     rgb2luv.h
+    separable.h
     shitomasi.cpp#
     shitomasi.h#
     swizzle.cpp
@@ -71,11 +71,11 @@ TensorProc::TensorProc() {
 
 void TensorProc::setUniforms() {
     Filter3x3Proc::setUniforms();
-    glUniform1f(shParamUEdgeStrength, edgeStrength);
+    shParamUEdgeStrength.set(edgeStrength);
 }
 
 void TensorProc::getUniforms() {
     Filter3x3Proc::getUniforms();
-    shParamUInputTex = shader->getParam(UNIF, "inputImageTexture");
-    shParamUEdgeStrength = shader->getParam(UNIF, "edgeStrength");
+    shParamUInputTex.init(shader.get(), "inputImageTexture");
+    shParamUEdgeStrength.init(shader.get(), "edgeStrength");
 }
@@ -61,7 +61,7 @@ private:
 
     float edgeStrength = 1.0f;
 
-    GLuint shParamUEdgeStrength = 0;
+    Uniform<GLfloat> shParamUEdgeStrength;
 
     static const char* fshaderTensorSrc; // fragment shader source
 };
@@ -118,19 +118,22 @@ void ThreeInputProc::filterRenderPrepare() {
     // Bind input texture 1:
     glActiveTexture(GL_TEXTURE0 + texUnit);
     glBindTexture(texTarget, texId);
-    glUniform1i(shParamUInputTex, texUnit);
+    OG_GL_COUNT(textureBinds);
+    shParamUInputTex.set(texUnit);
 
     // Bind input texture 2:
     texUnit2 = texUnit + 1;
     glActiveTexture(GL_TEXTURE0 + texUnit2);
     glBindTexture(texTarget2, texId2);
-    glUniform1i(shParamUInputTex2, texUnit2);
+    OG_GL_COUNT(textureBinds);
+    shParamUInputTex2.set(texUnit2);
 
     // Bind input texture 3:
     texUnit3 = texUnit + 2;
     glActiveTexture(GL_TEXTURE0 + texUnit3);
     glBindTexture(texTarget3, texId3);
-    glUniform1i(shParamUInputTex3, texUnit3);
+    OG_GL_COUNT(textureBinds);
+    shParamUInputTex3.set(texUnit3);
 }
 
 void ThreeInputProc::filterShaderSetup(const char* vShaderSrc, const char* fShaderSrc, GLenum target) {
@@ -147,9 +150,9 @@ void ThreeInputProc::filterShaderSetup(const char* vShaderSrc, const char* fShad
 
 void ThreeInputProc::getUniforms() {
     FilterProcBase::getUniforms();
-    shParamUInputTex = shader->getParam(UNIF, "inputImageTexture");
-    shParamUInputTex2 = shader->getParam(UNIF, "inputImageTexture2");
-    shParamUInputTex3 = shader->getParam(UNIF, "inputImageTexture3");
+    shParamUInputTex.init(shader.get(), "inputImageTexture");
+    shParamUInputTex2.init(shader.get(), "inputImageTexture2");
+    shParamUInputTex3.init(shader.get(), "inputImageTexture3");
 }
 
 void ThreeInputProc::setUniforms() {
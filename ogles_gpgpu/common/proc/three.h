@@ -87,14 +87,14 @@ protected:
 
     bool hasTex2 = false;
     bool waitForSecondTexture = true;
-    GLint shParamUInputTex2;
+    Uniform<GLint> shParamUInputTex2;
     GLuint texId2; // input texture id
     GLuint texUnit2; // input texture unit (glActiveTexture())
     GLenum texTarget2; // input texture target
 
     bool hasTex3 = false;
     bool waitForThirdTexture = true;
-    GLint shParamUInputTex3;
+    Uniform<GLint> shParamUInputTex3;
     GLuint texId3; // input texture id
     GLuint texUnit3; // input texture unit (glActiveTexture())
     GLenum texTarget3; // input texture target
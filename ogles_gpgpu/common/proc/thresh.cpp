@@ -53,7 +53,7 @@ int ThreshProc::init(int inW, int inH, unsigned int order, bool prepareForExtern
     filterInit(vshaderDefault, fshaderSimpleThreshSrc);
 
     // get additional shader params
-    shParamUThresh = shader->getParam(UNIF, "uThresh");
+    shParamUThresh.init(shader.get(), "uThresh");
 
     return 1;
 }
@@ -63,7 +63,7 @@ int ThreshProc::render(int position) {
 
     filterRenderPrepare();
 
-    glUniform1f(shParamUThresh, threshVal); // thresholding value for simple thresholding
+    shParamUThresh.set(threshVal); // thresholding value for simple thresholding
 
     Tools::checkGLErr("ThreshProc", "render prepare");
 
@@ -74,7 +74,7 @@ public:
 private:
     float threshVal; // thresholding value [0.0 .. 1.0]
 
-    GLint shParamUThresh; // fixed threshold value
+    Uniform<GLfloat> shParamUThresh; // fixed threshold value
 
     static const char* fshaderSimpleThreshSrc; // fragment shader source for simple thresholding
 };
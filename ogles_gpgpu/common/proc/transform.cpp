@@ -122,17 +122,17 @@ const char* TransformProc::getVertexShaderSource() {
 
 void TransformProc::setUniforms() {
     FilterProcBase::setUniforms();
-    glUniformMatrix4fv(shParamUTransform, 1, 0, &transformMatrix.data[0][0]);
+    shParamUTransform.set(transformMatrix);
     if (interpolation == BICUBIC) {
-        glUniform2f(shParamUTransformSize, inFrameW, inFrameH);
+        shParamUTransformSize.set(Vec2f(inFrameW, inFrameH));
     }
 }
 
 void TransformProc::getUniforms() {
     FilterProcBase::getUniforms();
-    shParamUTransform = shader->getParam(UNIF, "transformMatrix");
+    shParamUTransform.init(shader.get(), "transformMatrix");
     if (interpolation == BICUBIC) {
-        shParamUTransformSize = shader->getParam(UNIF, "texSize");
+        shParamUTransformSize.init(shader.get(), "texSize");
     }
 }
 
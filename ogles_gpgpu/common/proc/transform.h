@@ -93,10 +93,10 @@ protected:
 
     Interpolation interpolation = BILINEAR;
 
-    GLint shParamUTransform; // shader uniform transformation matrix
+    Uniform<Mat44f> shParamUTransform; // shader uniform transformation matrix
     Mat44f transformMatrix; // currently set weighted channel grayscale conversion vector
 
-    GLint shParamUTransformSize = 0; // texture size (for bicubic warp)
+    Uniform<Vec2f> shParamUTransformSize; // texture size (for bicubic warp)
 };
 }
 
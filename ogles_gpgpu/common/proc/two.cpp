@@ -107,13 +107,15 @@ void TwoInputProc::filterRenderPrepare() {
     // Bind input texture 1:
     glActiveTexture(GL_TEXTURE0 + texUnit);
     glBindTexture(texTarget, texId);
-    glUniform1i(shParamUInputTex, texUnit);
+    OG_GL_COUNT(textureBinds);
+    shParamUInputTex.set(texUnit);
 
     // Bind input texture 2:
     texUnit2 = texUnit + 1;
     glActiveTexture(GL_TEXTURE0 + texUnit2);
     glBindTexture(texTarget2, texId2);
-    glUniform1i(shParamUInputTex2, texUnit2);
+    OG_GL_COUNT(textureBinds);
+    shParamUInputTex2.set(texUnit2);
 }
 
 void TwoInputProc::filterShaderSetup(const char* vShaderSrc, const char* fShaderSrc, GLenum target) {
@@ -130,8 +132,8 @@ void TwoInputProc::filterShaderSetup(const char* vShaderSrc, const char* fShader
 
 void TwoInputProc::getUniforms() {
     FilterProcBase::getUniforms();
-    shParamUInputTex = shader->getParam(UNIF, "inputImageTexture");
-    shParamUInputTex2 = shader->getParam(UNIF, "inputImageTexture2");
+    shParamUInputTex.init(shader.get(), "inputImageTexture");
+    shParamUInputTex2.init(shader.get(), "inputImageTexture2");
 }
 
 void TwoInputProc::setUniforms() {
@@ -106,7 +106,7 @@ protected:
     GLuint texUnit2; // input texture unit (glActiveTexture())
     GLenum texTarget2; // input texture target
 
-    GLint shParamUInputTex2;
+    Uniform<GLint> shParamUInputTex2;
 
     static const char* fshaderTwoInputSrc; // fragment shader source
 
@@ -48,6 +48,8 @@ GLuint VideoSource::getInputTexId() {
 }
 
 void VideoSource::configurePipeline(const Size2d& size, GLenum inputPixFormat) {
+    GPUMemory::resetPeak();
+
     if (inputPixFormat == 0) { // 0 == NV{12,21}
         if (!yuv2RgbProc) {
             yuv2RgbProc = std::make_shared<ogles_gpgpu::Yuv2RgbProc>(Yuv2RgbProc::k601VideoRange, OGLES_GPGPU_BIPLANAR_CHANNEL_KIND);
@@ -67,14 +69,41 @@ void VideoSource::configurePipeline(const Size2d& size, GLenum inputPixFormat) {
         pipeline->prepare(size.width, size.height, inputPixFormat);
     }
     frameSize = size;
+
+    prepareMemoryPeak = GPUMemory::getPeak();
+}
+
+MemoryReport VideoSource::getMemoryReport() {
+    MemoryReport report;
+    std::set<ProcInterface*> visited;
+    if (yuv2RgbProc) {
+        yuv2RgbProc->getMemoryReport(report, visited);
+    }
+    if (pipeline) {
+        pipeline->getMemoryReport(report, visited);
+    }
+    return report;
+}
+
+PipelineGraph VideoSource::getGraph() {
+    PipelineGraph graph;
+    std::map<ProcInterface*, int> nodes;
+    const int yuv = yuv2RgbProc ? yuv2RgbProc->addToGraph(graph, nodes, -1) : -1;
+    if (pipeline) {
+        const int first = pipeline->addToGraph(graph, nodes, -1);
+        if (yuv >= 0) {
+            graph.addEdge(yuv, first);
+        }
+    }
+    return graph;
 }
 
 void VideoSource::set(ProcInterface* p) {
     pipeline = p;
 }
 
-void VideoSource::operator()(const FrameInput& frame) {
-    return (*this)(frame.size, frame.pixelBuffer, frame.useRawPixels, frame.inputTexture, frame.textureFormat);
+void VideoSource::operator()(const Size2d& size, void* pixelBuffer, bool useRawPixels, GLuint inputTexture, GLenum inputPixFormat) {
+    return (*this)(FrameInput(size, pixelBuffer, useRawPixels, inputTexture, inputPixFormat));
 }
 
 void VideoSource::configure(const Size2d& size, GLenum inputPixFormat)
@@ -86,7 +115,25 @@ void VideoSource::configure(const Size2d& size, GLenum inputPixFormat)
     }
 }
 
-void VideoSource::operator()(const Size2d& size, void* pixelBuffer, bool useRawPixels, GLuint inputTexture, GLenum inputPixFormat) {
+void VideoSource::operator()(const FrameInput& frame) {
+    const Size2d& size = frame.size;
+    void* pixelBuffer = frame.pixelBuffer;
+    const bool useRawPixels = frame.useRawPixels;
+    GLuint inputTexture = frame.inputTexture;
+    const GLenum inputPixFormat = frame.textureFormat;
+
+    Tools::resetGLErrCheckCount();
+
+    StageTimings::Binding binding(stageTimings);
+    stageTimings.nextFrame();
+
+    const std::uint64_t frameId = frame.frameId ? frame.frameId : stageTimings.getFrame();
+    LatencyTracker::FrameScope frameScope(frameId);
+    latency.begin(frameId, frame.captureTime);
+
+    frameGLCalls = {};
+    GLCounters::Scope calls(frameGLCalls);
+
     preConfig();
 
     if (m_timer)
@@ -101,42 +148,51 @@ void VideoSource::operator()(const Size2d& size, void* pixelBuffer, bool useRawP
         firstFrame = false;
     }
 
-    auto gpgpuInputHandler = pipeline->getInputMemTransferObj();
-    gpgpuInputHandler->setUseRawPixels(useRawPixels);
-
-    // on each new frame, this will release the input buffers and textures, and prepare new ones
-    // texture format must be GL_BGRA because this is one of the native camera formats (see initCam)
-    if (pixelBuffer) {
-        if (inputPixFormat == 0) {
-            // YUV: Special case NV12=>BGR
-            auto manager = yuv2RgbProc->getMemTransferObj();
-            if (useRawPixels) {
-                manager->setUseRawPixels(true);
-            }
-            manager->prepareInput(frameSize.width, frameSize.height, inputPixFormat, pixelBuffer);
-
-            yuv2RgbProc->setTextures(manager->getLuminanceTexId(), manager->getChrominanceTexId());
-            yuv2RgbProc->render();
-
-            gpgpuInputHandler->prepareInput(frameSize.width, frameSize.height, GL_NONE, nullptr);
-            inputTexture = yuv2RgbProc->getOutputTexId(); // override input parameter
-        } else {
-            gpgpuInputHandler->prepareInput(frameSize.width, frameSize.height, inputPixFormat, pixelBuffer);
-
-            // For generic platforms we must also load pixel buffer to the texture:
-            if (dynamic_cast<ogles_gpgpu::MemTransferOptimized*>(gpgpuInputHandler) == nullptr) {
-                setInputData(reinterpret_cast<const unsigned char*>(pixelBuffer));
-            }
+    {
+        StageTimings::Scope scope("upload");
+
+        auto gpgpuInputHandler = pipeline->getInputMemTransferObj();
+        gpgpuInputHandler->setUseRawPixels(useRawPixels);
+
+        // on each new frame, this will release the input buffers and textures, and prepare new ones
+        // texture format must be GL_BGRA because this is one of the native camera formats (see initCam)
+        if (pixelBuffer) {
+            if (inputPixFormat == 0) {
+                // YUV: Special case NV12=>BGR
+                auto manager = yuv2RgbProc->getMemTransferObj();
+                if (useRawPixels) {
+                    manager->setUseRawPixels(true);
+                }
+                manager->prepareInput(frameSize.width, frameSize.height, inputPixFormat, pixelBuffer);
+
+                yuv2RgbProc->setTextures(manager->getLuminanceTexId(), manager->getChrominanceTexId());
+                yuv2RgbProc->render();
+
+                gpgpuInputHandler->prepareInput(frameSize.width, frameSize.height, GL_NONE, nullptr);
+                inputTexture = yuv2RgbProc->getOutputTexId(); // override input parameter
+            } else {
+                gpgpuInputHandler->prepareInput(frameSize.width, frameSize.height, inputPixFormat, pixelBuffer);
+
+                // For generic platforms we must also load pixel buffer to the texture:
+                if (dynamic_cast<ogles_gpgpu::MemTransferOptimized*>(gpgpuInputHandler) == nullptr) {
+                    setInputData(reinterpret_cast<const unsigned char*>(pixelBuffer));
+                }
             
-            inputTexture = gpgpuInputHandler->getInputTexId(); // override input parameter
+                inputTexture = gpgpuInputHandler->getInputTexId(); // override input parameter
+            }
         }
     }
+    latency.uploaded();
 
     if (m_timer)
         m_timer("process");
 
     assert(inputTexture); // inputTexture must be defined at this point
-    pipeline->process(inputTexture, 1, GL_TEXTURE_2D, 0, 0, m_timer);
+    {
+        StageTimings::Scope scope("process");
+        pipeline->process(inputTexture, 1, GL_TEXTURE_2D, 0, 0, m_timer);
+    }
+    latency.submitted();
 
     if (m_timer)
         m_timer("end");
@@ -144,6 +200,29 @@ void VideoSource::operator()(const Size2d& size, void* pixelBuffer, bool useRawP
     postConfig();
 }
 
+void VideoSource::warmup(const Size2d& size, GLenum inputPixFormat) {
+    assert(pipeline);
+
+    Timer timer; // warmup is not a frame
+    std::swap(timer, m_timer);
+    const bool timing = stageTimings.isEnabled();
+    stageTimings.setEnabled(false);
+    const bool tracking = latency.isEnabled();
+    latency.setEnabled(false);
+
+    // blank frame, large enough for all supported input pixel formats
+    std::vector<unsigned char> blank(size.width * size.height * 4, 0);
+    (*this)(size, blank.data(), true, 0, inputPixFormat);
+    glFinish();
+    OG_GL_COUNT(finishes);
+
+    std::swap(timer, m_timer);
+    stageTimings.setEnabled(timing);
+    latency.setEnabled(tracking);
+
+    pipeline->resetChain();
+}
+
 void VideoSource::setInputData(const unsigned char* data) {
 
 #if 1
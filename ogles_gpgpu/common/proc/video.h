@@ -13,11 +13,15 @@
 #define OGLES_GPGPU_COMMON_VIDEO
 
 #include "../common_includes.h"
+#include "../latency.h"
 #include "base/procbase.h"
 #include "base/procinterface.h"
 #include "yuv2rgb.h"
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 BEGIN_OGLES_GPGPU
 
@@ -36,6 +40,9 @@ struct FrameInput {
     bool useRawPixels = false;
     GLuint inputTexture = 0;
     GLenum textureFormat = 0;
+
+    std::uint64_t frameId = 0; // passed on to the processors (see LatencyTracker), 0: numbered by VideoSource
+    std::chrono::steady_clock::time_point captureTime; // default: unknown (no queueing)
 };
 
 /**
@@ -62,6 +69,14 @@ public:
 
     void operator()(const Size2d& size, void* pixelBuffer, bool useRawPixels, GLuint inputTexture = 0, GLenum inputPixFormat = OGLES_GPGPU_TEXTURE_FORMAT);
 
+    /**
+     * Configure the pipeline for frames of size <size> and process one blank frame, so that
+     * the lazy driver work (program compilation for the actual draw state, FBO completeness
+     * checks, first use texture allocation) is done before the first real frame.
+     * The temporal state of all processors is reset afterwards (see ProcInterface::resetChain()).
+     */
+    void warmup(const Size2d& size, GLenum inputPixFormat = OGLES_GPGPU_TEXTURE_FORMAT);
+
     virtual void preConfig() {}
 
     virtual void postConfig() {}
@@ -74,6 +89,49 @@ public:
 
     GLuint getInputTexId();
 
+    /**
+     * Get the wall clock times of the stages "upload", "process" and of each processor
+     * (see ProcInterface::getStageName()), i.e. for snapshot(), reset() and setTracer().
+     */
+    StageTimings& getStageTimings() {
+        return stageTimings;
+    }
+
+    /**
+     * Get the frame latency tracking (disabled by default), i.e. to complete() the frames
+     * once their results were read back.
+     */
+    LatencyTracker& getLatencyTracker() {
+        return latency;
+    }
+
+    /**
+     * Get the OpenGL calls of the last frame, if counting is enabled (see GLCounters).
+     */
+    const GLCallCounts& getGLCallCounts() const {
+        return frameGLCalls;
+    }
+
+    /**
+     * Get the GPU memory held by the YUV conversion (if any) and by each processor of the
+     * pipeline (see ProcInterface::getMemoryReport()). getTotal() sums up the report.
+     */
+    MemoryReport getMemoryReport();
+
+    /**
+     * Get the graph of the YUV conversion (if any) and of the pipeline (see
+     * ProcInterface::getGraph()).
+     */
+    PipelineGraph getGraph();
+
+    /**
+     * Get the peak of the GPU memory allocated by ogles_gpgpu while the pipeline was
+     * last (re)configured for a new frame size in bytes (see GPUMemory).
+     */
+    std::size_t getPrepareMemoryPeak() const {
+        return prepareMemoryPeak;
+    }
+
 protected:
     Timer m_timer;
 
@@ -89,6 +147,14 @@ protected:
 
     ProcInterface* pipeline = nullptr;
 
+    StageTimings stageTimings;
+
+    GLCallCounts frameGLCalls; // OpenGL calls of the last frame
+
+    LatencyTracker latency;
+
+    std::size_t prepareMemoryPeak = 0; // see getPrepareMemoryPeak()
+
     std::shared_ptr<ogles_gpgpu::Yuv2RgbProc> yuv2RgbProc;
 };
 
@@ -243,17 +243,17 @@ void Yuv2RgbProc::filterShaderSetup(const char* vShaderSrc, const char* fShaderS
     shParamATexCoord = shader->getParam(ATTR, "aTexCoord");
     yuvConversionPositionAttribute = shParamAPos; // "aPos"
     yuvConversionTextureCoordinateAttribute = shParamATexCoord; // "aTexCoord"
-    yuvConversionLuminanceTextureUniform = shader->getParam(UNIF, "luminanceTexture");
+    yuvConversionLuminanceTextureUniform.init(shader.get(), "luminanceTexture");
     
     if(channelKind == kYUV12) {
-        yuvConversionUTextureUniform = shader->getParam(UNIF, "uTexture");
-        yuvConversionVTextureUniform = shader->getParam(UNIF, "vTexture");
+        yuvConversionUTextureUniform.init(shader.get(), "uTexture");
+        yuvConversionVTextureUniform.init(shader.get(), "vTexture");
     }
     else {
-        yuvConversionChrominanceTextureUniform = shader->getParam(UNIF, "chrominanceTexture");
+        yuvConversionChrominanceTextureUniform.init(shader.get(), "chrominanceTexture");
     }
     
-    yuvConversionMatrixUniform = shader->getParam(UNIF, "colorConversionMatrix");
+    yuvConversionMatrixUniform.init(shader.get(), "colorConversionMatrix");
     Tools::checkGLErr(getProcName(), "getParam()");
 
     // remember used shader source
@@ -320,26 +320,32 @@ void Yuv2RgbProc::filterRenderPrepare() {
 
     glActiveTexture(GL_TEXTURE4);
     glBindTexture(GL_TEXTURE_2D, luminanceTexture);
-    glUniform1i(yuvConversionLuminanceTextureUniform, 4);
+    OG_GL_COUNT(textureBinds);
+    yuvConversionLuminanceTextureUniform.set(4);
 
     if(channelKind >= kYUV12)
     {
         glActiveTexture(GL_TEXTURE5);
         glBindTexture(GL_TEXTURE_2D, uTexture);
-        glUniform1i(yuvConversionUTextureUniform, 5);
+        OG_GL_COUNT(textureBinds);
+        yuvConversionUTextureUniform.set(5);
 
         glActiveTexture(GL_TEXTURE6);
         glBindTexture(GL_TEXTURE_2D, vTexture);
-        glUniform1i(yuvConversionVTextureUniform, 6);
+        OG_GL_COUNT(textureBinds);
+        yuvConversionVTextureUniform.set(6);
     }
     else
     {
         glActiveTexture(GL_TEXTURE5);
         glBindTexture(GL_TEXTURE_2D, chrominanceTexture);
-        glUniform1i(yuvConversionChrominanceTextureUniform, 5);
+        OG_GL_COUNT(textureBinds);
+        yuvConversionChrominanceTextureUniform.set(5);
     }
 
-    glUniformMatrix3fv(yuvConversionMatrixUniform, 1, GL_FALSE, _preferredConversion);
+    Mat33f conversion;
+    memcpy(conversion.data, _preferredConversion, sizeof(conversion.data));
+    yuvConversionMatrixUniform.set(conversion);
 }
 
 int Yuv2RgbProc::render(int position) {
@@ -83,19 +83,19 @@ private:
 
     // For (interleaved) NV{12,21}
     GLuint chrominanceTexture;
-    GLint yuvConversionChrominanceTextureUniform;
+    Uniform<GLint> yuvConversionChrominanceTextureUniform;
     
     // For (planar) YUV12
     GLuint uTexture;
-    GLint yuvConversionUTextureUniform;
+    Uniform<GLint> yuvConversionUTextureUniform;
     GLuint vTexture;
-    GLint yuvConversionVTextureUniform;
+    Uniform<GLint> yuvConversionVTextureUniform;
 
     GLint yuvConversionPositionAttribute;
     GLint yuvConversionTextureCoordinateAttribute;
 
-    GLint yuvConversionLuminanceTextureUniform;
-    GLint yuvConversionMatrixUniform;
+    Uniform<GLint> yuvConversionLuminanceTextureUniform;
+    Uniform<Mat33f> yuvConversionMatrixUniform;
 
     const GLfloat* _preferredConversion;
 
@@ -0,0 +1,264 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+#include "stats.h"
+#include "trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace ogles_gpgpu;
+
+const std::size_t TimingStats::kWindow;
+const int Histogram::kBinsPerOctave;
+const int Histogram::kBins;
+
+static const double kHistogramMinMs = 0.001; // lower edge of the second bin
+
+static thread_local StageTimings* boundStageTimings = nullptr;
+
+void TimingStats::add(double ms) {
+    window[count % kWindow] = ms;
+    count++;
+    last = ms;
+    sum += ms;
+}
+
+void TimingStats::reset() {
+    count = 0;
+    last = 0.0;
+    sum = 0.0;
+}
+
+double TimingStats::getPercentile(double p) const {
+    const std::size_t n = std::min(count, kWindow);
+    if (n == 0) {
+        return 0.0;
+    }
+
+    std::vector<double> samples(window.begin(), window.begin() + n);
+    const double rank = std::ceil(std::max(0.0, std::min(p, 100.0)) / 100.0 * n);
+    const std::size_t k = std::max(rank, 1.0) - 1;
+    std::nth_element(samples.begin(), samples.begin() + k, samples.end());
+    return samples[k];
+}
+
+std::string TimingStats::toString() const {
+    std::stringstream ss;
+    ss << "n=" << count << " last=" << getLast() << "ms mean=" << getMean() << "ms";
+    ss << " p50=" << getP50() << "ms p95=" << getP95() << "ms p99=" << getP99() << "ms";
+    return ss.str();
+}
+
+// ########## Histogram
+
+void Histogram::add(double ms) {
+    int bin = 0;
+    if (ms > kHistogramMinMs) {
+        bin = 1 + static_cast<int>(std::log2(ms / kHistogramMinMs) * kBinsPerOctave);
+        bin = std::min(bin, kBins - 1);
+    }
+    bins[bin]++;
+
+    min = count ? std::min(min, ms) : ms;
+    max = count ? std::max(max, ms) : ms;
+    count++;
+    last = ms;
+    sum += ms;
+}
+
+void Histogram::reset() {
+    bins.fill(0);
+    count = 0;
+    last = sum = min = max = 0.0;
+}
+
+double Histogram::getBinCenter(int bin) {
+    return kHistogramMinMs * std::exp2((bin - 0.5) / kBinsPerOctave);
+}
+
+double Histogram::getPercentile(double p) const {
+    if (count == 0) {
+        return 0.0;
+    }
+
+    const double rank = std::max(std::ceil(std::max(0.0, std::min(p, 100.0)) / 100.0 * count), 1.0);
+
+    std::size_t cumulative = 0;
+    int bin = 0;
+    for (; bin < kBins - 1; bin++) {
+        cumulative += bins[bin];
+        if (cumulative >= rank) {
+            break;
+        }
+    }
+
+    // the extreme bins are open, the samples are never outside [min, max]
+    return std::max(min, std::min(getBinCenter(bin), max));
+}
+
+std::string Histogram::toString() const {
+    std::stringstream ss;
+    ss << "n=" << count << " last=" << getLast() << "ms mean=" << getMean() << "ms";
+    ss << " p50=" << getP50() << "ms p95=" << getP95() << "ms p99=" << getP99() << "ms max=" << getMax() << "ms";
+    return ss.str();
+}
+
+// ########## Mann-Whitney U test
+
+static const std::size_t kUTestExactMax = 20; // max. sample size for exact p values
+
+// Number of orderings of <m> x and <n> y samples, by the number of (x, y) pairs with y < x
+static std::vector<double> getUDistribution(std::size_t m, std::size_t n) {
+    // counts[i][j] for i x and j y samples: the largest sample is either an x, which is
+    // larger than all j y samples, or a y, which is larger than no x sample
+    std::vector<std::vector<std::vector<double>>> counts(m + 1, std::vector<std::vector<double>>(n + 1));
+    for (std::size_t i = 0; i <= m; i++) {
+        for (std::size_t j = 0; j <= n; j++) {
+            std::vector<double>& c = counts[i][j];
+            c.assign(i * j + 1, 0.0);
+            if (i == 0 || j == 0) {
+                c[0] = 1.0;
+                continue;
+            }
+            const std::vector<double>& xLast = counts[i - 1][j];
+            const std::vector<double>& yLast = counts[i][j - 1];
+            for (std::size_t u = 0; u < c.size(); u++) {
+                c[u] = (u >= j ? xLast[u - j] : 0.0) + (u < yLast.size() ? yLast[u] : 0.0);
+            }
+        }
+    }
+    return counts[m][n];
+}
+
+UTestResult ogles_gpgpu::mannWhitneyUTest(const std::vector<double>& x, const std::vector<double>& y) {
+    UTestResult result;
+    const std::size_t m = x.size(), n = y.size(), total = m + n;
+    if (m == 0 || n == 0) {
+        return result;
+    }
+
+    // ranks of all samples (1-based, the mean rank for ties)
+    std::vector<std::pair<double, bool>> samples; // (value, from x)
+    samples.reserve(total);
+    for (double v : x) {
+        samples.emplace_back(v, true);
+    }
+    for (double v : y) {
+        samples.emplace_back(v, false);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    double rankSumX = 0.0;
+    double ties = 0.0; // sum of t^3 - t over all groups of t equal samples
+    for (std::size_t i = 0; i < total;) {
+        std::size_t j = i;
+        while (j < total && samples[j].first == samples[i].first) {
+            j++;
+        }
+        const double t = static_cast<double>(j - i);
+        const double rank = (i + 1 + j) / 2.0;
+        for (std::size_t k = i; k < j; k++) {
+            rankSumX += samples[k].second ? rank : 0.0;
+        }
+        ties += t * t * t - t;
+        i = j;
+    }
+
+    const double mn = static_cast<double>(m) * n;
+    result.u = rankSumX - m * (m + 1) / 2.0;
+
+    if (ties == 0.0 && m <= kUTestExactMax && n <= kUTestExactMax) {
+        const std::vector<double> counts = getUDistribution(m, n);
+        const std::size_t tail = static_cast<std::size_t>(std::min(result.u, mn - result.u));
+        double tailCount = 0.0, allCount = 0.0;
+        for (std::size_t u = 0; u < counts.size(); u++) {
+            tailCount += (u <= tail) ? counts[u] : 0.0;
+            allCount += counts[u];
+        }
+        result.p = std::min(1.0, 2.0 * tailCount / allCount);
+    } else {
+        const double N = static_cast<double>(total);
+        const double sigma = std::sqrt(mn / 12.0 * ((N + 1.0) - ties / (N * (N - 1.0))));
+        if (sigma > 0.0) {
+            const double z = std::max(0.0, std::abs(result.u - mn / 2.0) - 0.5) / sigma; // continuity correction
+            result.p = std::min(1.0, std::erfc(z / std::sqrt(2.0)));
+        }
+    }
+
+    return result;
+}
+
+// ########## StageTimings
+
+StageTimings::Binding::Binding(StageTimings& timings)
+    : previous(boundStageTimings) {
+    if (timings.isEnabled() || timings.getTracer()) {
+        boundStageTimings = &timings;
+    }
+}
+
+StageTimings::Binding::~Binding() {
+    boundStageTimings = previous;
+}
+
+StageTimings::Scope::Scope(const char* name)
+    : timings(boundStageTimings)
+    , name(name) {
+    if (timings) {
+        if ((tracer = timings->getTracer())) {
+            event = tracer->beginEvent(name, timings->getFrame());
+        }
+        start = Clock::now();
+    }
+}
+
+StageTimings::Scope::~Scope() {
+    if (timings) {
+        if (timings->isEnabled()) {
+            timings->add(name, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+        }
+        if (tracer) {
+            tracer->endEvent(event);
+        }
+    }
+}
+
+void StageTimings::add(const char* name, double ms) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (auto& stage : stages) {
+        if (stage.name == name) {
+            stage.histogram.add(ms);
+            return;
+        }
+    }
+
+    stages.push_back({ name, Histogram() });
+    stages.back().histogram.add(ms);
+}
+
+std::vector<StageTimings::Stage> StageTimings::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stages;
+}
+
+void StageTimings::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    stages.clear();
+}
+
+std::string StageTimings::toString() const {
+    std::stringstream ss;
+    for (const auto& stage : snapshot()) {
+        ss << stage.name << ": " << stage.histogram.toString() << "\n";
+    }
+    return ss.str();
+}
@@ -0,0 +1,305 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+/**
+ * Timing statistics.
+ */
+#ifndef OGLES_GPGPU_COMMON_STATS
+#define OGLES_GPGPU_COMMON_STATS
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ogles_gpgpu {
+
+class Tracer;
+
+/**
+ * Statistics of a series of time measurements in milliseconds. The mean covers all
+ * samples since the last reset(), the percentiles cover the last kWindow samples.
+ */
+class TimingStats {
+public:
+    static const std::size_t kWindow = 128; // number of samples kept for the percentiles
+
+    /**
+     * Add the time measurement <ms>.
+     */
+    void add(double ms);
+
+    /**
+     * Remove all samples.
+     */
+    void reset();
+
+    /**
+     * Get the number of samples since the last reset().
+     */
+    std::size_t getCount() const {
+        return count;
+    }
+
+    /**
+     * Get the last sample (0 if there is none).
+     */
+    double getLast() const {
+        return last;
+    }
+
+    /**
+     * Get the mean of all samples (0 if there is none).
+     */
+    double getMean() const {
+        return count ? (sum / count) : 0.0;
+    }
+
+    /**
+     * Get the <p>th percentile (0 <= p <= 100) of the last kWindow samples (nearest rank,
+     * 0 if there is none).
+     */
+    double getPercentile(double p) const;
+
+    double getP50() const {
+        return getPercentile(50.0);
+    }
+
+    double getP95() const {
+        return getPercentile(95.0);
+    }
+
+    double getP99() const {
+        return getPercentile(99.0);
+    }
+
+    /**
+     * Return a human readable summary (i.e. for logging).
+     */
+    std::string toString() const;
+
+private:
+    std::array<double, kWindow> window; // ring buffer of the last samples
+    std::size_t count = 0;
+    double last = 0.0;
+    double sum = 0.0;
+};
+
+/**
+ * Histogram of time measurements in milliseconds with a fixed number of logarithmic bins
+ * (kBinsPerOctave per doubling from 1us, the last bin collects everything above ~16s),
+ * so that it can run for the lifetime of a process. Percentiles are accurate to half a
+ * bin width (about 9%).
+ */
+class Histogram {
+public:
+    static const int kBinsPerOctave = 4;
+    static const int kBins = 96;
+
+    /**
+     * Add the time measurement <ms>.
+     */
+    void add(double ms);
+
+    /**
+     * Remove all samples.
+     */
+    void reset();
+
+    std::size_t getCount() const {
+        return count;
+    }
+
+    double getLast() const {
+        return last;
+    }
+
+    double getMean() const {
+        return count ? (sum / count) : 0.0;
+    }
+
+    double getMin() const {
+        return min;
+    }
+
+    double getMax() const {
+        return max;
+    }
+
+    /**
+     * Get the <p>th percentile (0 <= p <= 100) of all samples (0 if there is none).
+     */
+    double getPercentile(double p) const;
+
+    double getP50() const {
+        return getPercentile(50.0);
+    }
+
+    double getP95() const {
+        return getPercentile(95.0);
+    }
+
+    double getP99() const {
+        return getPercentile(99.0);
+    }
+
+    /**
+     * Return a human readable summary (i.e. for logging).
+     */
+    std::string toString() const;
+
+private:
+    static double getBinCenter(int bin);
+
+    std::array<std::uint32_t, kBins> bins = {};
+    std::size_t count = 0;
+    double last = 0.0;
+    double sum = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+};
+
+/**
+ * Result of a two sided Mann-Whitney U test (see mannWhitneyUTest()).
+ */
+struct UTestResult {
+    double u = 0.0; // U statistic of the first sample
+    double p = 1.0; // probability of a difference at least as large if both samples have the same distribution
+};
+
+/**
+ * Two sided Mann-Whitney U test of the samples <x> and <y>, i.e. of the repeated time
+ * measurements of a benchmark before and after a change. Unlike a t-test it does not
+ * assume normally distributed times and is robust against outliers. The p value is exact
+ * for samples of up to 20 measurements without ties, otherwise it is approximated by the
+ * normal distribution (with tie correction). Returns p = 1 if a sample is empty.
+ */
+UTestResult mannWhitneyUTest(const std::vector<double>& x, const std::vector<double>& y);
+
+/**
+ * Wall clock times (std::chrono::steady_clock) of named pipeline stages, i.e. "upload",
+ * each processor (see ProcInterface::getStageName()), "readback" and "display".
+ *
+ * Core and VideoSource own one instance each and bind it to the calling thread while they
+ * work on a frame, so that the stages record into it with a Scope. All methods are
+ * thread safe, i.e. snapshot() can be called from a telemetry thread.
+ */
+class StageTimings {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Statistics of one stage.
+     */
+    struct Stage {
+        std::string name;
+        Histogram histogram;
+    };
+
+    /**
+     * Binds <timings> to the calling thread for the lifetime of the Binding, if enabled
+     * or if it has a tracer.
+     */
+    class Binding {
+    public:
+        Binding(StageTimings& timings);
+        ~Binding();
+
+    private:
+        StageTimings* previous;
+    };
+
+    /**
+     * Measures the time from construction to destruction as stage <name> (which must
+     * outlive the Scope) into the timings that are bound to the calling thread, if any,
+     * and records it with their tracer.
+     */
+    class Scope {
+    public:
+        Scope(const char* name);
+        ~Scope();
+
+    private:
+        StageTimings* timings;
+        const char* name;
+        Clock::time_point start;
+        Tracer* tracer = nullptr;
+        std::size_t event = 0; // of the tracer
+    };
+
+    /**
+     * Enable or disable the measurements (enabled by default with OGLES_GPGPU_BENCHMARK).
+     */
+    void setEnabled(bool flag) {
+        enabled = flag;
+    }
+
+    bool isEnabled() const {
+        return enabled;
+    }
+
+    /**
+     * Record the stages with <tracer> (nullptr: none), independent of isEnabled().
+     */
+    void setTracer(Tracer* tracer) {
+        this->tracer = tracer;
+    }
+
+    Tracer* getTracer() const {
+        return tracer;
+    }
+
+    /**
+     * Start the next frame, the stages that follow are recorded with its id.
+     */
+    void nextFrame() {
+        frame++;
+    }
+
+    std::uint64_t getFrame() const {
+        return frame;
+    }
+
+    /**
+     * Add the time measurement <ms> to stage <name>.
+     */
+    void add(const char* name, double ms);
+
+    /**
+     * Get a consistent copy of all stages in order of their first measurement.
+     */
+    std::vector<Stage> snapshot() const;
+
+    /**
+     * Remove all stages.
+     */
+    void reset();
+
+    /**
+     * Return a human readable summary of all stages (i.e. for logging).
+     */
+    std::string toString() const;
+
+private:
+    mutable std::mutex mutex;
+    std::vector<Stage> stages;
+
+    std::atomic<Tracer*> tracer{ nullptr };
+    std::atomic<std::uint64_t> frame{ 0 };
+
+#ifdef OGLES_GPGPU_BENCHMARK
+    std::atomic<bool> enabled{ true };
+#else
+    std::atomic<bool> enabled{ false };
+#endif
+};
+}
+
+#endif
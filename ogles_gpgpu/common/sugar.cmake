@@ -19,8 +19,12 @@ sugar_files(
     OGLES_GPGPU_COMMON_PUBLIC_HDRS
     common_includes.h
     core.h
+    graph.h
+    latency.h
     macros.h
+    stats.h
     tools.h
+    trace.h
     types.h
 )
 
@@ -28,6 +32,10 @@ sugar_files(
     OGLES_GPGPU_SRCS
     ${OGLES_GPGPU_COMMON_PUBLIC_HDRS}
     core.cpp
+    graph.cpp
+    latency.cpp
+    stats.cpp
     tools.cpp
+    trace.cpp
     types.cpp
 )
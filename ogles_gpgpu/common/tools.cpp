@@ -10,6 +10,8 @@
 #include "tools.h"
 
 #include "common_includes.h"
+#include "gl/call_counters.h"
+#include "gl/caps.h"
 
 #include <cmath>
 
@@ -17,21 +19,98 @@
 #define log2f(v) logf((v)) / log(2)
 #endif
 
+// clang-format off
+#if defined(OGLES_GPGPU_OPENGL) && defined(GL_VERSION_4_3) && !defined(__APPLE__)
+#  define OGLES_GPGPU_DEBUG_OUTPUT GL_DEBUG_OUTPUT
+#  define OGLES_GPGPU_DEBUG_TYPE_ERROR GL_DEBUG_TYPE_ERROR
+#  define OGLES_GPGPU_DEBUG_MESSAGE_CALLBACK glDebugMessageCallback
+#  define OGLES_GPGPU_DEBUG_APIENTRY APIENTRY
+#elif defined(GL_ES_VERSION_3_2)
+#  define OGLES_GPGPU_DEBUG_OUTPUT GL_DEBUG_OUTPUT
+#  define OGLES_GPGPU_DEBUG_TYPE_ERROR GL_DEBUG_TYPE_ERROR
+#  define OGLES_GPGPU_DEBUG_MESSAGE_CALLBACK glDebugMessageCallback
+#  define OGLES_GPGPU_DEBUG_APIENTRY GL_APIENTRY
+#elif defined(OGLES_GPGPU_ANDROID) && defined(GL_KHR_debug)
+#  include <EGL/egl.h>
+#  define OGLES_GPGPU_DEBUG_OUTPUT GL_DEBUG_OUTPUT_KHR
+#  define OGLES_GPGPU_DEBUG_TYPE_ERROR GL_DEBUG_TYPE_ERROR_KHR
+#  define OGLES_GPGPU_DEBUG_MESSAGE_CALLBACK_PROC PFNGLDEBUGMESSAGECALLBACKKHRPROC // not exported by libGLESv2
+#  define OGLES_GPGPU_DEBUG_MESSAGE_CALLBACK debugMessageCallbackProc
+#  define OGLES_GPGPU_DEBUG_APIENTRY GL_APIENTRY
+#endif
+// clang-format on
+
 using namespace ogles_gpgpu;
 using namespace std;
 
-#ifdef OGLES_GPGPU_BENCHMARK
-clock_t Tools::startTick = 0;
-vector<double> Tools::timeMeasurements;
+Tools::GLErrorPolicy Tools::glErrorPolicy = Tools::GLErrorPolicySync;
+unsigned int Tools::glErrCheckCount = 0;
+
+#if defined(OGLES_GPGPU_DEBUG_MESSAGE_CALLBACK)
+static void OGLES_GPGPU_DEBUG_APIENTRY debugMessageCallback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message, const void* userParam) {
+    if (type == OGLES_GPGPU_DEBUG_TYPE_ERROR) {
+        OG_LOGERR("GL", "%s", message);
+    } else {
+        OG_LOGINF("GL", "%s", message);
+    }
+}
 #endif
 
 void Tools::checkGLErr(const char* cls, const char* msg) {
+    glErrCheckCount++;
+
+    if (glErrorPolicy != GLErrorPolicySync) {
+        return;
+    }
+
     GLenum err = glGetError();
+    OG_GL_COUNT(errorChecks);
     if (err != GL_NO_ERROR) {
         OG_LOGERR(cls, "%s - GL error '%d' occured", msg, err);
     }
 }
 
+bool Tools::setGLErrorPolicy(GLErrorPolicy policy) {
+    if (policy == glErrorPolicy) {
+        return true;
+    }
+
+#if defined(OGLES_GPGPU_DEBUG_MESSAGE_CALLBACK)
+#if defined(OGLES_GPGPU_DEBUG_MESSAGE_CALLBACK_PROC)
+    static const auto debugMessageCallbackProc = reinterpret_cast<OGLES_GPGPU_DEBUG_MESSAGE_CALLBACK_PROC>(eglGetProcAddress("glDebugMessageCallbackKHR"));
+#endif
+
+    if (policy == GLErrorPolicyDebugOutput) {
+        if (!GLCaps::get().debugOutput) {
+            OG_LOGERR("Tools", "KHR_debug is not supported by this context");
+            return false;
+        }
+
+#if defined(OGLES_GPGPU_DEBUG_MESSAGE_CALLBACK_PROC)
+        if (!debugMessageCallbackProc) {
+            OG_LOGERR("Tools", "glDebugMessageCallbackKHR could not be loaded");
+            return false;
+        }
+#endif
+
+        OGLES_GPGPU_DEBUG_MESSAGE_CALLBACK(debugMessageCallback, nullptr);
+        glEnable(OGLES_GPGPU_DEBUG_OUTPUT);
+    } else if (glErrorPolicy == GLErrorPolicyDebugOutput) {
+        glDisable(OGLES_GPGPU_DEBUG_OUTPUT);
+        OGLES_GPGPU_DEBUG_MESSAGE_CALLBACK(nullptr, nullptr);
+    }
+#else
+    if (policy == GLErrorPolicyDebugOutput) {
+        OG_LOGERR("Tools", "KHR_debug is not available on this platform");
+        return false;
+    }
+#endif
+
+    glErrorPolicy = policy;
+
+    return true;
+}
+
 bool Tools::isPOT(float v) {
     float pow = log2f(v);
     return ceilf(pow) == pow;
@@ -64,23 +143,3 @@ void Tools::strReplaceAll(string& str, const string& from, const string& to) {
         start_pos += to.length();
     }
 }
-
-#ifdef OGLES_GPGPU_BENCHMARK
-void Tools::resetTimeMeasurement() {
-    startTick = 0;
-    timeMeasurements.clear();
-}
-
-void Tools::startTimeMeasurement() {
-    startTick = clock();
-}
-
-void Tools::stopTimeMeasurement() {
-    double ms = getTicksDiffInMs(startTick, clock());
-    timeMeasurements.push_back(ms);
-}
-
-double Tools::getTicksDiffInMs(clock_t t1, clock_t t2) {
-    return (((double)(t2 - t1) / CLOCKS_PER_SEC) * 1000.0);
-}
-#endif
\ No newline at end of file
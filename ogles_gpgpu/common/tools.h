@@ -27,12 +27,51 @@ namespace ogles_gpgpu {
  */
 class Tools {
 public:
+    /**
+     * OpenGL error reporting policy used by checkGLErr().
+     */
+    enum GLErrorPolicy {
+        GLErrorPolicySync, // glGetError() on each check (may stall the pipeline, for debugging)
+        GLErrorPolicyDebugOutput, // asynchronous KHR_debug message callback, checks are no-ops
+        GLErrorPolicyOff // no error reporting at all (production)
+    };
+
     /**
      * Check for an OpenGL error in the previous call(s). Produce error
      * message in class <cls> with prefix <msg>.
+     * Behavior depends on the selected GLErrorPolicy.
      */
     static void checkGLErr(const char* cls, const char* msg);
 
+    /**
+     * Set the OpenGL error reporting policy to <policy>. Needs a current OpenGL context
+     * for GLErrorPolicyDebugOutput. Returns false if the policy is not supported, in
+     * which case the current policy is kept.
+     */
+    static bool setGLErrorPolicy(GLErrorPolicy policy);
+
+    /**
+     * Get the OpenGL error reporting policy.
+     */
+    static GLErrorPolicy getGLErrorPolicy() {
+        return glErrorPolicy;
+    }
+
+    /**
+     * Get the number of checkGLErr() calls since the last resetGLErrCheckCount().
+     * VideoSource and Core reset this at the start of each frame.
+     */
+    static unsigned int getGLErrCheckCount() {
+        return glErrCheckCount;
+    }
+
+    /**
+     * Reset the checkGLErr() call counter.
+     */
+    static void resetGLErrCheckCount() {
+        glErrCheckCount = 0;
+    }
+
     /**
      * Check if <v> is a power-of-two (POT) value.
      */
@@ -54,22 +93,9 @@ public:
      */
     static void strReplaceAll(std::string& str, const std::string& from, const std::string& to);
 
-#ifdef OGLES_GPGPU_BENCHMARK
-    static void resetTimeMeasurement();
-    static void startTimeMeasurement();
-    static void stopTimeMeasurement();
-
-    static double getTicksDiffInMs(clock_t t1, clock_t t2);
-    static vector<double> getTimeMeasurements() {
-        return timeMeasurements;
-    }
-#endif
-
 private:
-#ifdef OGLES_GPGPU_BENCHMARK
-    static clock_t startTick;
-    static vector<double> timeMeasurements;
-#endif
+    static GLErrorPolicy glErrorPolicy;
+    static unsigned int glErrCheckCount;
 };
 }
 
@@ -0,0 +1,216 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+#include "trace.h"
+#include "gl/call_counters.h"
+#include "gl/timer_query.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+using namespace std;
+using namespace ogles_gpgpu;
+
+const std::size_t Tracer::kMaxEvents;
+const std::size_t Tracer::kNoEvent;
+
+static const int kGPUThread = 0; // pseudo thread id of the GPU events
+
+static void writeString(std::ostream& os, const std::string& str) {
+    os << '"';
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            os << '\\' << c;
+        } else if (static_cast<unsigned char>(c) >= 0x20) {
+            os << c;
+        }
+    }
+    os << '"';
+}
+
+Tracer::~Tracer() {
+    for (auto& event : events) {
+        for (GLuint query : event.gpuQueries) {
+            if (query) {
+                queryPool.push_back(query);
+            }
+        }
+    }
+
+    for (GLuint query : queryPool) {
+        GPUTimestamp::destroy(query);
+    }
+}
+
+void Tracer::start() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    collect(true);
+    for (auto& event : events) {
+        for (GLuint query : event.gpuQueries) {
+            if (query) {
+                queryPool.push_back(query);
+            }
+        }
+    }
+    events.clear();
+    firstPending = 0;
+    threads.clear();
+
+    gpu = GPUTimestamp::isSupported();
+    if (gpu) {
+        glFinish();
+        OG_GL_COUNT(finishes);
+        gpuOrigin = GPUTimestamp::getCurrent();
+    }
+    cpuOrigin = Clock::now();
+
+    recording = true;
+}
+
+void Tracer::stop() {
+    recording = false;
+}
+
+double Tracer::getCPUTime() const {
+    return std::chrono::duration<double, std::micro>(Clock::now() - cpuOrigin).count();
+}
+
+int Tracer::getThread() {
+    auto thread = threads.insert({ std::this_thread::get_id(), static_cast<int>(threads.size()) + 1 });
+    return thread.first->second;
+}
+
+std::size_t Tracer::beginEvent(const char* name, std::uint64_t frame) {
+    if (!recording) {
+        return kNoEvent;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (events.size() >= kMaxEvents) {
+        recording = false;
+        OG_LOGINF("Tracer", "stopped recording after %u events", static_cast<unsigned int>(events.size()));
+        return kNoEvent;
+    }
+
+    collect(false);
+
+    Event event = { name, frame, getThread(), getCPUTime(), -1.0, { 0, 0 }, { -1, -1 } };
+    if (gpu) {
+        for (GLuint& query : event.gpuQueries) {
+            if (queryPool.empty()) {
+                query = GPUTimestamp::create();
+            } else {
+                query = queryPool.back();
+                queryPool.pop_back();
+            }
+        }
+        GPUTimestamp::record(event.gpuQueries[0]);
+    }
+
+    events.push_back(event);
+    return events.size() - 1;
+}
+
+void Tracer::endEvent(std::size_t event) {
+    if (event == kNoEvent) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (event < events.size()) {
+        auto& e = events[event];
+        if (e.gpuQueries[1]) {
+            GPUTimestamp::record(e.gpuQueries[1]);
+        }
+        e.cpuEnd = getCPUTime();
+    }
+}
+
+std::size_t Tracer::getEventCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return events.size();
+}
+
+// Read the available GPU results (in submission order) and recycle their queries
+void Tracer::collect(bool wait) {
+    for (; firstPending < events.size(); firstPending++) {
+        auto& event = events[firstPending];
+        const bool ended = (event.cpuEnd >= 0.0);
+        if (!ended && !wait) {
+            break;
+        }
+
+        // an event that was not ended has no GPU time (the end query was not recorded)
+        for (int i = 0; ended && (i < 2); i++) {
+            if (event.gpuQueries[i] && (event.gpuTimestamps[i] < 0)) {
+                if (!GPUTimestamp::getResult(event.gpuQueries[i], event.gpuTimestamps[i], wait)) {
+                    return;
+                }
+            }
+        }
+
+        for (GLuint& query : event.gpuQueries) {
+            if (query) {
+                queryPool.push_back(query);
+                query = 0;
+            }
+        }
+    }
+}
+
+void Tracer::write(std::ostream& os) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    collect(true);
+
+    os << std::fixed << std::setprecision(3);
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    // thread names
+    os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"ogles_gpgpu\"}}";
+    if (gpu) {
+        os << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << kGPUThread << ",\"args\":{\"name\":\"GPU\"}}";
+    }
+    for (const auto& thread : threads) {
+        os << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.second << ",\"args\":{\"name\":\"CPU " << thread.second << "\"}}";
+    }
+
+    for (const auto& event : events) {
+        const double cpuEnd = std::max(event.cpuEnd, event.cpuBegin);
+        os << ",\n{\"name\":";
+        writeString(os, event.name);
+        os << ",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread;
+        os << ",\"ts\":" << event.cpuBegin << ",\"dur\":" << (cpuEnd - event.cpuBegin);
+        os << ",\"args\":{\"frame\":" << event.frame << "}}";
+
+        if ((event.gpuTimestamps[0] >= 0) && (event.gpuTimestamps[1] >= event.gpuTimestamps[0])) {
+            const double gpuBegin = (event.gpuTimestamps[0] - gpuOrigin) / 1000.0;
+            const double gpuEnd = (event.gpuTimestamps[1] - gpuOrigin) / 1000.0;
+            os << ",\n{\"name\":";
+            writeString(os, event.name);
+            os << ",\"cat\":\"gpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << kGPUThread;
+            os << ",\"ts\":" << gpuBegin << ",\"dur\":" << (gpuEnd - gpuBegin);
+            os << ",\"args\":{\"frame\":" << event.frame << "}}";
+        }
+    }
+
+    os << "\n]}\n";
+}
+
+bool Tracer::write(const std::string& path) {
+    std::ofstream os(path);
+    if (!os) {
+        OG_LOGERR("Tracer", "could not open %s", path.c_str());
+        return false;
+    }
+
+    write(os);
+    return static_cast<bool>(os);
+}
@@ -0,0 +1,121 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+/**
+ * Pipeline execution tracer.
+ */
+#ifndef OGLES_GPGPU_COMMON_TRACE
+#define OGLES_GPGPU_COMMON_TRACE
+
+#include "common_includes.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ogles_gpgpu {
+
+/**
+ * Records the pipeline stages of StageTimings (upload, each processor, readback, display)
+ * with their frame id as CPU events and, where GL_TIMESTAMP queries are supported, as GPU
+ * events, and writes them as Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+ *
+ * Attach it with StageTimings::setTracer(), i.e. on Core::getStageTimings() or
+ * VideoSource::getStageTimings(). The events are recorded between start() and stop(),
+ * up to kMaxEvents. A GPU event spans from the GPU completing the commands before the
+ * stage to completing the stage's commands, so it includes idle time of the GPU.
+ */
+class Tracer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static const std::size_t kMaxEvents = 1 << 18;
+    static const std::size_t kNoEvent = ~std::size_t(0);
+
+    /**
+     * Deletes the query objects (needs the OpenGL context that recorded the events).
+     */
+    ~Tracer();
+
+    /**
+     * Remove all events and start recording. Needs a current OpenGL context to align
+     * the GPU and CPU clocks.
+     */
+    void start();
+
+    /**
+     * Stop recording.
+     */
+    void stop();
+
+    bool isRecording() const {
+        return recording;
+    }
+
+    /**
+     * Begin event <name> of frame <frame>.
+     * Returns the event for endEvent(), or kNoEvent if not recording.
+     */
+    std::size_t beginEvent(const char* name, std::uint64_t frame);
+
+    /**
+     * End <event> (see beginEvent()).
+     */
+    void endEvent(std::size_t event);
+
+    /**
+     * Get the number of recorded events.
+     */
+    std::size_t getEventCount() const;
+
+    /**
+     * Write all events as Chrome trace JSON to <os>. Waits for the GPU results, so it must
+     * be called with the OpenGL context that recorded them.
+     */
+    void write(std::ostream& os);
+
+    /**
+     * Write all events as Chrome trace JSON to file <path>. Returns false on failure.
+     */
+    bool write(const std::string& path);
+
+private:
+    struct Event {
+        std::string name;
+        std::uint64_t frame;
+        int thread;
+        double cpuBegin; // us since start()
+        double cpuEnd; // -1: not ended yet
+        GLuint gpuQueries[2]; // GPU timestamp queries at begin and end (0: none)
+        std::int64_t gpuTimestamps[2]; // ns, -1: not available yet
+    };
+
+    void collect(bool wait);
+
+    double getCPUTime() const;
+
+    int getThread();
+
+    mutable std::mutex mutex;
+    std::vector<Event> events;
+    std::size_t firstPending = 0; // first event with pending GPU queries
+    std::vector<GLuint> queryPool; // free GPU timestamp queries
+    std::map<std::thread::id, int> threads;
+
+    std::atomic<bool> recording{ false };
+    bool gpu = false; // record GPU events
+    Clock::time_point cpuOrigin;
+    std::int64_t gpuOrigin = 0; // ns of the GPU clock at cpuOrigin
+};
+}
+
+#endif
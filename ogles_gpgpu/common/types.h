@@ -72,6 +72,15 @@ struct Rect2d {
     int x = 0, y = 0, width = 0, height = 0;
 };
 
+struct Vec2f {
+    Vec2f() {}
+    Vec2f(float a, float b) {
+        data[0] = a;
+        data[1] = b;
+    }
+    GLfloat data[2];
+};
+
 struct Vec3f {
     Vec3f() {}
     Vec3f(float a, float b, float c) {
@@ -82,6 +91,10 @@ struct Vec3f {
     GLfloat data[3];
 };
 
+struct Mat33f {
+    GLfloat data[3][3];
+};
+
 struct Mat44f {
     GLfloat data[4][4];
 };
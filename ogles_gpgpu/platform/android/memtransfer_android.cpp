@@ -361,6 +361,7 @@ GLuint MemTransferAndroid::prepareInput(int inTexW, int inTexH, GLenum inputPxFo
     }
 
     preparedInput = true;
+    updateMemoryUsage();
 
     OG_LOGINF("MemTransferAndroid", "successfully prepared input with texture id %d", inputTexId);
 
@@ -431,6 +432,7 @@ GLuint MemTransferAndroid::prepareOutput(int outTexW, int outTexH) {
     }
 
     preparedOutput = true;
+    updateMemoryUsage();
 
     OG_LOGINF("MemTransferAndroid", "successfully prepared output with texture id %d", outputTexId);
 
@@ -69,6 +69,8 @@ void MemTransferIOS::releaseInput() {
     CVOpenGLESTextureCacheFlush(textureCache, 0);
 
     preparedInput = false;
+
+    updateMemoryUsage();
 }
 
 void MemTransferIOS::releaseOutput() {
@@ -85,6 +87,8 @@ void MemTransferIOS::releaseOutput() {
     CVOpenGLESTextureCacheFlush(textureCache, 0);
 
     preparedOutput = false;
+
+    updateMemoryUsage();
 }
 
 void MemTransferIOS::init() {
@@ -343,6 +347,7 @@ GLuint MemTransferIOS::prepareInput(int inTexW, int inTexH, GLenum inputPxFormat
 
     inputTexture = texRef;
     preparedInput = true;
+    updateMemoryUsage();
 
     return inputTexId;
 }
@@ -414,6 +419,7 @@ GLuint MemTransferIOS::prepareOutput(int outTexW, int outTexH) {
     outputPixelBuffer = bufRef;
     outputTexture = texRef;
     preparedOutput = true;
+    updateMemoryUsage();
 
     return outputTexId;
 }
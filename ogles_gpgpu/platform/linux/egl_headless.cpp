@@ -0,0 +1,218 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+#include "egl_headless.h"
+
+#include "../../common/common_includes.h"
+
+#include <EGL/eglext.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace ogles_gpgpu;
+
+// Check if the space separated extension list <extensions> contains <name>
+static bool hasExtension(const char* extensions, const char* name) {
+    if (!extensions) {
+        return false;
+    }
+
+    const std::size_t length = std::strlen(name);
+    for (const char* s = std::strstr(extensions, name); s; s = std::strstr(s + length, name)) {
+        if ((s == extensions || s[-1] == ' ') && (s[length] == ' ' || s[length] == '\0')) {
+            return true;
+        }
+    }
+    return false;
+}
+
+EGLHeadless::API EGLHeadless::getDefaultAPI() {
+    if (const char* name = std::getenv("OGLES_GPGPU_EGL_API")) {
+        for (API api : { kGLES2, kGLES3, kGL }) {
+            if (std::strcmp(name, getAPIName(api)) == 0) {
+                return api;
+            }
+        }
+        OG_LOGERR("EGLHeadless", "unknown OGLES_GPGPU_EGL_API %s", name);
+    }
+
+#if defined(OGLES_GPGPU_OPENGL_ES2)
+    return kGLES2;
+#elif defined(OGLES_GPGPU_OPENGL_ES3)
+    return kGLES3;
+#else
+    return kGL;
+#endif
+}
+
+const char* EGLHeadless::getAPIName(API api) {
+    switch (api) {
+    case kGLES2:
+        return "gles2";
+    case kGLES3:
+        return "gles3";
+    case kGL:
+        return "gl";
+    }
+    return "";
+}
+
+EGLHeadless::~EGLHeadless() {
+    shutdown();
+}
+
+EGLDisplay EGLHeadless::getHeadlessDisplay() {
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay && hasExtension(clientExtensions, "EGL_EXT_platform_base")) {
+        if (hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+            EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (display != EGL_NO_DISPLAY) {
+                OG_LOGINF("EGLHeadless", "using the surfaceless platform");
+                return display;
+            }
+        }
+
+        auto queryDevices = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT"));
+        if (queryDevices && hasExtension(clientExtensions, "EGL_EXT_platform_device")) {
+            EGLDeviceEXT device;
+            EGLint count = 0;
+            if (queryDevices(1, &device, &count) && count > 0) {
+                EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, device, nullptr);
+                if (display != EGL_NO_DISPLAY) {
+                    OG_LOGINF("EGLHeadless", "using the device platform");
+                    return display;
+                }
+            }
+        }
+    }
+
+    OG_LOGINF("EGLHeadless", "using the default display");
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+bool EGLHeadless::setup(API api, int width, int height) {
+    shutdown();
+    this->api = api;
+
+    disp = getHeadlessDisplay();
+    if (disp == EGL_NO_DISPLAY) {
+        OG_LOGERR("EGLHeadless", "no EGL display: %d", eglGetError());
+        return false;
+    }
+
+    EGLint eglMajVers, eglMinVers;
+    if (!eglInitialize(disp, &eglMajVers, &eglMinVers)) {
+        OG_LOGERR("EGLHeadless", "eglInitialize failed: %d", eglGetError());
+        disp = EGL_NO_DISPLAY;
+        return false;
+    }
+
+    OG_LOGINF("EGLHeadless", "EGL init with version %d.%d (%s)", eglMajVers, eglMinVers, eglQueryString(disp, EGL_VENDOR));
+
+    if (!eglBindAPI((api == kGL) ? EGL_OPENGL_API : EGL_OPENGL_ES_API)) {
+        OG_LOGERR("EGLHeadless", "eglBindAPI failed for %s: %d", getAPIName(api), eglGetError());
+        return false;
+    }
+
+    // without surfaceless contexts, a pixelbuffer surface is needed for eglMakeCurrent()
+    const bool pbuffer = (width > 0 && height > 0) || !hasExtension(eglQueryString(disp, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+    const EGLint renderableType = (api == kGL) ? EGL_OPENGL_BIT : ((api == kGLES3) ? EGL_OPENGL_ES3_BIT_KHR : EGL_OPENGL_ES2_BIT);
+
+    // clang-format off
+    const EGLint confAttr[] = {
+        EGL_RENDERABLE_TYPE, renderableType,
+        EGL_SURFACE_TYPE, pbuffer ? EGL_PBUFFER_BIT : 0,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, 8,
+        EGL_NONE
+    };
+    // clang-format on
+
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(disp, confAttr, &conf, 1, &numConfigs) || numConfigs < 1) {
+        OG_LOGERR("EGLHeadless", "eglChooseConfig failed for %s: %d", getAPIName(api), eglGetError());
+        return false;
+    }
+
+    // OpenGL: the default (compatibility) context
+    const EGLint ctxAttrES[] = { EGL_CONTEXT_CLIENT_VERSION, (api == kGLES3) ? 3 : 2, EGL_NONE };
+    const EGLint ctxAttrGL[] = { EGL_NONE };
+
+    ctx = eglCreateContext(disp, conf, EGL_NO_CONTEXT, (api == kGL) ? ctxAttrGL : ctxAttrES);
+    if (ctx == EGL_NO_CONTEXT) {
+        OG_LOGERR("EGLHeadless", "eglCreateContext failed for %s: %d", getAPIName(api), eglGetError());
+        return false;
+    }
+
+    if (pbuffer) {
+        const EGLint surfaceAttr[] = {
+            EGL_WIDTH, (width > 0) ? width : 1,
+            EGL_HEIGHT, (height > 0) ? height : 1,
+            EGL_NONE
+        };
+
+        surface = eglCreatePbufferSurface(disp, conf, surfaceAttr);
+        if (surface == EGL_NO_SURFACE) {
+            OG_LOGERR("EGLHeadless", "eglCreatePbufferSurface failed: %d", eglGetError());
+            shutdown();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool EGLHeadless::activate() {
+    assert(disp != EGL_NO_DISPLAY && ctx != EGL_NO_CONTEXT);
+
+    eglBindAPI((api == kGL) ? EGL_OPENGL_API : EGL_OPENGL_ES_API); // the bound API is per thread
+    if (!eglMakeCurrent(disp, surface, surface, ctx)) {
+        OG_LOGERR("EGLHeadless", "eglMakeCurrent failed: %d", eglGetError());
+        return false;
+    }
+
+    return true;
+}
+
+bool EGLHeadless::deactivate() {
+    if (disp == EGL_NO_DISPLAY || eglGetCurrentContext() != ctx) {
+        return true;
+    }
+
+    if (!eglMakeCurrent(disp, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT)) {
+        OG_LOGERR("EGLHeadless", "eglMakeCurrent failed: %d", eglGetError());
+        return false;
+    }
+
+    return true;
+}
+
+void EGLHeadless::shutdown() {
+    if (disp == EGL_NO_DISPLAY) {
+        return;
+    }
+
+    deactivate();
+
+    if (surface != EGL_NO_SURFACE) {
+        eglDestroySurface(disp, surface);
+        surface = EGL_NO_SURFACE;
+    }
+    if (ctx != EGL_NO_CONTEXT) {
+        eglDestroyContext(disp, ctx);
+        ctx = EGL_NO_CONTEXT;
+    }
+
+    // the display is shared by all contexts of the process, so it is not terminated
+    disp = EGL_NO_DISPLAY;
+    conf = nullptr;
+}
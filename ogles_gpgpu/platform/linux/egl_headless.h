@@ -0,0 +1,109 @@
+//
+// ogles_gpgpu project - GPGPU for mobile devices and embedded systems using OpenGL ES 2.0
+//
+// See LICENSE file in project repository root for the license.
+//
+
+/**
+ * Headless EGL context manager (Linux)
+ */
+
+#ifndef OGLES_GPGPU_LINUX_EGL_HEADLESS
+#define OGLES_GPGPU_LINUX_EGL_HEADLESS
+
+#include <EGL/egl.h>
+
+namespace ogles_gpgpu {
+
+/**
+ * EGL context without a display server, i.e. for servers and CI machines with Mesa
+ * (llvmpipe or a GPU driver) or a vendor driver. The display is taken from the first
+ * available of the EGL_MESA_platform_surfaceless platform, the first device of the
+ * EGL_EXT_platform_device platform and the default display.
+ *
+ * The context has no default framebuffer unless a pbuffer size is given to setup() (the
+ * processors render into their own FBOs). A pbuffer is also created if the driver lacks
+ * EGL_KHR_surfaceless_context.
+ */
+class EGLHeadless {
+public:
+    /**
+     * Client API of the context. The library needs a context of the API that it was built
+     * for (OpenGL ES 3.0 also runs an OpenGL ES 2.0 build).
+     */
+    enum API {
+        kGLES2,
+        kGLES3,
+        kGL
+    };
+
+    /**
+     * Return the API of the OGLES_GPGPU_EGL_API environment variable ("gles2", "gles3" or
+     * "gl"), else the API that the library was built for.
+     */
+    static API getDefaultAPI();
+
+    /**
+     * Return the name of <api>, i.e. "gles3".
+     */
+    static const char* getAPIName(API api);
+
+    EGLHeadless() = default;
+    EGLHeadless(const EGLHeadless&) = delete;
+    EGLHeadless& operator=(const EGLHeadless&) = delete;
+
+    ~EGLHeadless();
+
+    /**
+     * Create a context of API <api> with an RGBA8 config and, if <width> and <height> are
+     * set, a pixelbuffer surface of that size. Returns true on success, otherwise false.
+     */
+    bool setup(API api = getDefaultAPI(), int width = 0, int height = 0);
+
+    /**
+     * Make the context current on the calling thread. setup() must be called first.
+     */
+    bool activate();
+
+    /**
+     * Release the context from the calling thread.
+     */
+    bool deactivate();
+
+    /**
+     * Destroy the context and surface. Also calls deactivate(). The display is shared by
+     * all contexts of the process and stays initialized.
+     */
+    void shutdown();
+
+    bool isValid() const {
+        return ctx != EGL_NO_CONTEXT;
+    }
+
+    API getAPI() const {
+        return api;
+    }
+
+    EGLDisplay getDisplay() const {
+        return disp;
+    }
+
+    EGLContext getContext() const {
+        return ctx;
+    }
+
+private:
+    /**
+     * Get a display of the first available headless platform (see class description).
+     */
+    static EGLDisplay getHeadlessDisplay();
+
+    API api = kGLES2;
+    EGLConfig conf = nullptr;
+    EGLSurface surface = EGL_NO_SURFACE;
+    EGLContext ctx = EGL_NO_CONTEXT;
+    EGLDisplay disp = EGL_NO_DISPLAY;
+};
+}
+
+#endif
@@ -58,6 +58,8 @@ void MemTransferOSX::releaseInput() {
     CVOpenGLTextureCacheFlush(textureCache, 0);
 
     preparedInput = false;
+
+    updateMemoryUsage();
 }
 
 void MemTransferOSX::releaseOutput() {
@@ -74,6 +76,8 @@ void MemTransferOSX::releaseOutput() {
     CVOpenGLTextureCacheFlush(textureCache, 0);
 
     preparedOutput = false;
+
+    updateMemoryUsage();
 }
 
 void MemTransferOSX::init() {
@@ -194,6 +198,7 @@ GLuint MemTransferOSX::prepareInput(int inTexW, int inTexH, GLenum inputPxFormat
     }
     inputTexture = texRef;
     preparedInput = true;
+    updateMemoryUsage();
 
     return inputTexId;
 }
@@ -260,6 +265,7 @@ GLuint MemTransferOSX::prepareOutput(int outTexW, int outTexH) {
     outputPixelBuffer = bufRef;
     outputTexture = texRef;
     preparedOutput = true;
+    updateMemoryUsage();
 
     return outputTexId;
 }
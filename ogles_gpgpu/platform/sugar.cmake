@@ -20,3 +20,8 @@ if(IOS)
 else()
   sugar_include(opengl)
 endif()
+
+# Headless EGL contexts (surfaceless or device platform) for servers without a display
+if(OGLES_GPGPU_USE_EGL AND CMAKE_SYSTEM_NAME STREQUAL "Linux" AND NOT ANDROID)
+  sugar_include(linux)
+endif()
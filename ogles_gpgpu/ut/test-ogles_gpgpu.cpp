@@ -2,9 +2,6 @@
 #undef NDEBUG
 #endif
 
-#include <aglet/GLContext.h>
-#include <aglet/aglet.h>
-
 #include <gtest/gtest.h>
 
 #include <opencv2/core.hpp>
@@ -12,7 +9,19 @@
 
 #define OGLES_GPGPU_DEBUG_YUV 0
 
+#include "../common/gl/call_counters.h"
+#include "../common/gl/memory_usage.h"
 #include "../common/gl/memtransfer_optimized.h"
+#include "../common/gl/program_cache.h"
+#include "../common/gl/shader_cache.h"
+#include "../common/gl/shader_variant.h"
+#include "../common/gl/timer_query.h"
+#include "../common/graph.h"
+#include "../common/latency.h"
+#include "../common/stats.h"
+#include "../common/trace.h"
+
+#include "../app/gl_context.h" // headless EGL or aglet context of the library API
 
 // clang-format off
 
@@ -32,6 +41,7 @@
 #include "../common/proc/gauss.h"        // [0]
 #include "../common/proc/gauss_opt.h"    // [0]
 #include "../common/proc/box_opt.h"      // [0]
+#include "../common/proc/separable.h"    // [0]
 #include "../common/proc/hessian.h"      // [0]
 #include "../common/proc/lbp.h"          // [0]
 #include "../common/proc/median.h"       // [0]
@@ -70,8 +80,17 @@ static cv::Vec3b torgb(const cv::Vec3b &p) { return cv::Vec3b(p[2], p[1], p[0]);
 #endif
 // clang-format off
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
 #include <type_traits>
 
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <dirent.h>
+#include <unistd.h>
+#endif
+
 // https://stackoverflow.com/a/8024562
 template <typename T, bool> struct absdiff_aux;
 
@@ -239,17 +258,36 @@ static cv::Mat getTestImage(int width, int height, int stripe, bool alpha, GLenu
 
 static int gWidth = 640;
 static int gHeight = 480;
-#if defined(OGLES_GPGPU_OPENGL_ES2)
-static aglet::GLContext::GLVersion gVersion = aglet::GLContext::kGLES20;
-#elif defined(OGLES_GPGPU_OPENGL_ES3)
-static aglet::GLContext::GLVersion gVersion = aglet::GLContext::kGLES30;
-#else
-static aglet::GLContext::GLVersion gVersion = aglet::GLContext::kGL;
+
+static ogles_gpgpu::GLContextPtr createContext() {
+    return ogles_gpgpu::createGLContext(gWidth, gHeight);
+}
+
+#if defined(OGLES_GPGPU_EGL_HEADLESS)
+TEST(OGLESGPGPUTest, EGLHeadless) {
+    // independent contexts without a display server, current on one thread at a time
+    ogles_gpgpu::EGLHeadless first, second;
+    ASSERT_TRUE(first.setup());
+    ASSERT_TRUE(second.setup(first.getAPI(), 64, 64));
+    ASSERT_NE(first.getContext(), second.getContext());
+
+    ASSERT_TRUE(first.activate());
+    ASSERT_NE(glGetString(GL_VERSION), nullptr);
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+
+    ASSERT_TRUE(second.activate());
+    ASSERT_EQ(eglGetCurrentContext(), second.getContext());
+    ASSERT_NE(glGetString(GL_VERSION), nullptr);
+
+    second.shutdown();
+    ASSERT_FALSE(second.isValid());
+    ASSERT_EQ(eglGetCurrentContext(), EGL_NO_CONTEXT);
+}
 #endif
 
 #if defined(OGLES_GPGPU_OPENGL_ES3)
 TEST(OGLESGPGPUTest, PingPong) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -290,7 +328,7 @@ inline cv::Vec4b convert(const cv::Scalar &value)
 }
 
 TEST(OGLESGPGPUTest, LetterboxProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     if (context && *context) {
@@ -324,7 +362,7 @@ TEST(OGLESGPGPUTest, LetterboxProc) {
 }
 
 TEST(OGLESGPGPUTest, Rgb2LuvProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     if (context && *context) {
@@ -354,7 +392,7 @@ TEST(OGLESGPGPUTest, Rgb2LuvProc) {
 }
 
 TEST(OGLESGPGPUTest, SwizzleProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     if (context && *context) {
@@ -383,7 +421,7 @@ TEST(OGLESGPGPUTest, SwizzleProc) {
 }
 
 TEST(OGLESGPGPUTest, GrayScaleProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     if (context && *context) {
@@ -409,7 +447,7 @@ TEST(OGLESGPGPUTest, GrayScaleProc) {
 }
 
 TEST(OGLESGPGPUTest, WriteAndRead) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     if (context && *context) {
@@ -449,7 +487,7 @@ TEST(OGLESGPGPUTest, WriteAndRead) {
 }
 
 TEST(OGLESGPGPUTest, Yuv2RgbProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -609,7 +647,7 @@ TEST(OGLESGPGPUTest, Yuv2RgbProc) {
 }
 
 TEST(OGLESGPGPUTest, AdaptThreshProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -629,7 +667,7 @@ TEST(OGLESGPGPUTest, AdaptThreshProc) {
 }
 
 TEST(OGLESGPGPUTest, GainProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -650,8 +688,135 @@ TEST(OGLESGPGPUTest, GainProc) {
     }
 }
 
+TEST(OGLESGPGPUTest, GLErrorPolicy) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        static const int value = 1, g = 10;
+        cv::Mat test(gWidth, gHeight, CV_8UC4, cv::Scalar(value, value, value, 255));
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::GainProc gain(g);
+        video.set(&gain);
+
+        ASSERT_EQ(ogles_gpgpu::Tools::getGLErrorPolicy(), ogles_gpgpu::Tools::GLErrorPolicySync);
+        for (int i = 0; i < 2; i++) {
+            video({ { test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT });
+        }
+        const auto checks = ogles_gpgpu::Tools::getGLErrCheckCount();
+        ASSERT_GT(checks, 0u);
+
+        // checks are still counted (per frame) when error reporting is disabled:
+        ASSERT_TRUE(ogles_gpgpu::Tools::setGLErrorPolicy(ogles_gpgpu::Tools::GLErrorPolicyOff));
+        video({ { test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT });
+        ASSERT_EQ(ogles_gpgpu::Tools::getGLErrCheckCount(), checks);
+
+        cv::Mat result;
+        getImage(gain, result);
+        ASSERT_EQ(static_cast<int>(cv::mean(result)[0]), (value * g));
+
+        ASSERT_TRUE(ogles_gpgpu::Tools::setGLErrorPolicy(ogles_gpgpu::Tools::GLErrorPolicySync));
+    }
+}
+
+TEST(OGLESGPGPUTest, GLCaps) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        const auto& caps = ogles_gpgpu::GLCaps::query();
+        std::cout << caps.toString() << std::endl;
+
+        ASSERT_EQ(glGetError(), GL_NO_ERROR);
+        ASSERT_GT(caps.versionMajor, 1);
+        ASSERT_GE(caps.maxTextureSize, std::max(gWidth, gHeight));
+        ASSERT_GE(caps.maxDrawBuffers, 1);
+
+        // extension lookup is case insensitive:
+        for (const auto& name : caps.extensions) {
+            std::string upper(name);
+            std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+            ASSERT_TRUE(caps.hasExtension(upper));
+        }
+
+#if defined(OGLES_GPGPU_OPENGL_ES3)
+        ASSERT_TRUE(caps.npotMipmaps);
+        ASSERT_TRUE(caps.rgTextures);
+        ASSERT_TRUE(caps.pixelBufferObjects);
+#endif
+    }
+}
+
+#if !defined(_WIN32) && !defined(_WIN64)
+// Unique directory below $TMPDIR (default: /tmp), removed with its files at destruction
+struct TempDirectory {
+    TempDirectory() {
+        const char* tmp = std::getenv("TMPDIR");
+        std::string pattern = std::string(tmp ? tmp : "/tmp") + "/ogles_gpgpu-XXXXXX";
+        if (mkdtemp(&pattern[0])) {
+            path = pattern;
+        }
+    }
+    ~TempDirectory() {
+        if (DIR* dir = opendir(path.c_str())) {
+            while (dirent* entry = readdir(dir)) {
+                if (std::strcmp(entry->d_name, ".") != 0 && std::strcmp(entry->d_name, "..") != 0) {
+                    unlink((path + "/" + entry->d_name).c_str());
+                }
+            }
+            closedir(dir);
+            rmdir(path.c_str());
+        }
+    }
+    std::string path;
+};
+
+TEST(OGLESGPGPUTest, ProgramBinaryCache) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        static const int value = 1, g = 10;
+        cv::Mat test(gWidth, gHeight, CV_8UC4, cv::Scalar(value, value, value, 255));
+
+        TempDirectory cache;
+        ASSERT_FALSE(cache.path.empty());
+
+        ogles_gpgpu::ProgramBinaryCache::setDirectory(cache.path);
+        if (!ogles_gpgpu::ProgramBinaryCache::isEnabled()) {
+            ogles_gpgpu::ProgramBinaryCache::setDirectory("");
+            return; // no program binary support
+        }
+        ogles_gpgpu::ProgramBinaryCache::resetCounts();
+
+        for (int i = 0; i < 2; i++) {
+            glActiveTexture(GL_TEXTURE0);
+            ogles_gpgpu::VideoSource video;
+            ogles_gpgpu::GainProc gain(g);
+            video.set(&gain);
+            video({ { test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT });
+
+            cv::Mat result;
+            getImage(gain, result);
+            ASSERT_EQ(static_cast<int>(cv::mean(result)[0]), (value * g));
+        }
+
+        ogles_gpgpu::ProgramBinaryCache::setDirectory("");
+
+        // the second program is restored from the binary stored by the first one
+        ASSERT_EQ(ogles_gpgpu::ProgramBinaryCache::getMissCount(), 1u);
+        ASSERT_EQ(ogles_gpgpu::ProgramBinaryCache::getHitCount(), 1u);
+    }
+}
+#endif
+
 TEST(OGLESGPGPUTest, BlendProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -680,7 +845,7 @@ TEST(OGLESGPGPUTest, BlendProc) {
 }
 
 TEST(OGLESGPGPUTest, FIFOProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -703,8 +868,8 @@ TEST(OGLESGPGPUTest, FIFOProc) {
     }
 }
 
-TEST(OGLESGPGPUTest, TransformProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+TEST(OGLESGPGPUTest, FIFOProcCopyFree) {
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -712,210 +877,995 @@ TEST(OGLESGPGPUTest, TransformProc) {
         glActiveTexture(GL_TEXTURE0);
         ogles_gpgpu::VideoSource video;
         ogles_gpgpu::GainProc gain(1.f);
-        ogles_gpgpu::TransformProc transform;
-
+        ogles_gpgpu::FifoProc fifo(3);
         video.set(&gain);
-        gain.add(&transform);
-
-        ogles_gpgpu::Mat44f matrix;
-        for (int y = 0; y < 4; y++) {
-            for (int x = 0; x < 4; x++) {
-                matrix.data[y][x] = 0;
-            }
-            matrix.data[y][y] = 1.f;
-        }
-        matrix.data[0][0] = 0.25f;
+        gain.add(&fifo);
 
-        transform.setTransformMatrix(matrix);
+        for (int i = 0; i < 5; i++) {
+            cv::Mat test(gWidth, gHeight, CV_8UC4, cv::Scalar(i, i, i, 255));
+            video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
 
-        cv::Mat test = getTestImage(gWidth, gHeight, 10, true, OGLES_GPGPU_TEXTURE_FORMAT);
-        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+            // The producer renders directly into the newest FIFO slot:
+            auto newest = fifo[static_cast<int>(fifo.getBufferCount()) - 1];
+            ASSERT_EQ(gain.getOutputTexId(), newest->getOutputTexId());
+        }
 
-        cv::Mat result;
-        getImage(transform, result);
-        ASSERT_FALSE(result.empty());
+        for (int i = 0; i < 3; i++) {
+            cv::Mat result;
+            getImage(*fifo[i], result);
+            ASSERT_EQ(cv::mean(result)[0], i + 2);
+        }
     }
 }
 
-TEST(OGLESGPGPUTest, MeshProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+TEST(OGLESGPGPUTest, ShaderCache) {
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
     if (context && *context) {
+        static const int value = 1, g = 2;
+        cv::Mat test(gWidth, gHeight, CV_8UC4, cv::Scalar(value, value, value, 255));
 
-        cv::Mat test = getTestImage(gWidth, gHeight, 10, true, OGLES_GPGPU_TEXTURE_FORMAT);
-
-        const float w = gWidth;
-        const float h = gHeight;
-        std::vector<std::array<float,3>> verticesT, vertices
-        {
-            {{0.f, 0.f, 0.f}},
-            {{w, 0.f, 0.f}},
-            {{w, h, 0.f}},
-            {{0.f, h, 0.f}},
-            {{w/2.f,h/2.f,0.f}} // demonstrate stretching center point
-        };
-
-        std::vector<std::array<float,2>> coordsT, coords
-        {
-            {{0.f, 0.f}},
-            {{1.f, 0.f}},
-            {{1.f, 1.f}},
-            {{0.f, 1.f}},
-            {{0.5f,0.5f}} // center point
-        };
-        
-        // Create explicit GL_TRIANGLES vertices and coords
-        cv::Mat2f xy(gHeight, gWidth);
-        
-        for(int y = 0; y < 4; y++)
+        ogles_gpgpu::ShaderCache::resetCounts();
         {
-            for(const auto &i : {(y+0)%4,(y+1)%4,4})
-            {
-                coordsT.push_back(coords[i]);
-                verticesT.push_back(vertices[i]);
-            }
-        }
-        
-        glActiveTexture(GL_TEXTURE0);
-        ogles_gpgpu::VideoSource video;
-        ogles_gpgpu::MeshShaderProc mesh(verticesT, coordsT);
-        mesh.setTriangleKind(GL_TRIANGLES);
-
-        video.set(&mesh);
+            glActiveTexture(GL_TEXTURE0);
+            ogles_gpgpu::VideoSource video;
+            ogles_gpgpu::GainProc gain1(g), gain2(g * g);
+            ogles_gpgpu::FifoProc fifo(3);
+            video.set(&gain1);
+            gain1.add(&gain2);
+            gain2.add(&fifo);
+            video({ { test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT });
 
-        const cv::Matx33f S(cv::Matx33f::diag({(2.f/gWidth),2.f/gHeight,1.f}));
-        const cv::Matx33f T(1.f,0.f,-1.f,0.f,1.f,-1.f,0.f,0.f,1.f);
-        const cv::Matx33f Ht = (T * S).t();
+            // both gains and the fifo slots share one program, with per instance uniforms:
+            ASSERT_GE(ogles_gpgpu::ShaderCache::getHitCount(), 4u);
 
-        const std::array<int,4> index {{0,1,3}};
-        ogles_gpgpu::Mat44f matrix;
-        for(int y = 0; y < 4; y++) {
-            for(int x = 0; x < 4; x++) {
-                matrix.data[y][x] = 0.f;
-            }
-            matrix.data[y][y] = 1.f;            
-        }
-        
-        for(int y = 0; y < 3; y++) {
-            for(int x = 0; x < 3; x++) {
-                matrix.data[index[y]][index[x]] = Ht(y,x);
-            }
+            cv::Mat result;
+            getImage(*fifo[static_cast<int>(fifo.getBufferCount()) - 1], result);
+            ASSERT_EQ(static_cast<int>(cv::mean(result)[0]), (value * g * g * g));
         }
 
-        mesh.setModelViewProjection(matrix);
+        // programs are released with the last user:
+        ASSERT_EQ(ogles_gpgpu::ShaderCache::size(), 0u);
+    }
+}
 
-        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+TEST(OGLESGPGPUTest, ShaderPrefetch) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        cv::Mat test = getTestImage(gWidth, gHeight, 2, true, OGLES_GPGPU_TEXTURE_FORMAT);
 
-        cv::Mat result;
-        getImage(mesh, result);
-        ASSERT_FALSE(result.empty());
+        ogles_gpgpu::ShaderCache::resetCounts();
+        {
+            glActiveTexture(GL_TEXTURE0);
+            ogles_gpgpu::VideoSource video;
+            ogles_gpgpu::GaussOptProc gauss;
+            ogles_gpgpu::TensorProc tensor;
+            ogles_gpgpu::ShiTomasiProc shiTomasi;
+            video.set(&gauss);
+            gauss.add(&tensor);
+            tensor.add(&shiTomasi);
+            video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
 
-        auto error = cv::norm(result, test, cv::NORM_L1) / static_cast<float>(gWidth*gHeight*4);
-        ASSERT_LE(error, 1);
+            // all programs were submitted ahead of init(), and each of them is in use:
+            ASSERT_EQ(ogles_gpgpu::ShaderCache::getMissCount(), ogles_gpgpu::ShaderCache::size());
+            ASSERT_GE(ogles_gpgpu::ShaderCache::getHitCount(), 3u);
+
+            cv::Mat result;
+            getImage(shiTomasi, result);
+            ASSERT_FALSE(result.empty());
+        }
     }
 }
 
-TEST(OGLESGPGPUTest, DiffProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+TEST(OGLESGPGPUTest, UniformTracking) {
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
     if (context && *context) {
-        const int value = 2;
-        const int a = 1, b = 10;
+        static const int value = 10;
         cv::Mat test(gWidth, gHeight, CV_8UC4, cv::Scalar(value, value, value, 255));
 
         glActiveTexture(GL_TEXTURE0);
         ogles_gpgpu::VideoSource video;
-        ogles_gpgpu::GainProc gain1(a), gain10(b);
-        ogles_gpgpu::DiffProc diff;
-
-        gain1.add(&diff, 1);
-        gain1.add(&gain10);
-        gain10.add(&diff, 0);
-
+        ogles_gpgpu::GainProc gain1(2), gain2(3); // one shared program
         video.set(&gain1);
-        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        gain1.add(&gain2);
 
-        cv::Mat result;
-        getImage(diff, result);
-        ASSERT_EQ(static_cast<int>(cv::mean(result)[0]), static_cast<int>(static_cast<float>((value * a * b) - (value * a))));
+        cv::Mat result1, result2;
+        for (int i = 0; i < 2; i++) {
+            // unchanged uniforms are not uploaded again, but per processor values must be preserved:
+            video({ { test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT });
+            getImage(gain1, result1);
+            getImage(gain2, result2);
+            ASSERT_EQ(static_cast<int>(cv::mean(result1)[0]), value * 2);
+            ASSERT_EQ(static_cast<int>(cv::mean(result2)[0]), value * 2 * 3);
+        }
+
+        gain2.setGain(4);
+        video({ { test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT });
+        getImage(gain2, result2);
+        ASSERT_EQ(static_cast<int>(cv::mean(result2)[0]), value * 2 * 4);
     }
 }
 
-TEST(OGLESGPGPUTest, GaussianProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+#if defined(GL_TEXTURE_EXTERNAL_OES)
+TEST(OGLESGPGPUTest, UniformTrackingTargetChange) {
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
     if (context && *context) {
-        cv::Mat test = getTestImage(gWidth, gHeight, 1, true, OGLES_GPGPU_TEXTURE_FORMAT);
+        static const int value = 10;
+        cv::Mat test(gWidth, gHeight, CV_8UC4, cv::Scalar(value, value, value, 255));
 
         glActiveTexture(GL_TEXTURE0);
         ogles_gpgpu::VideoSource video;
-        ogles_gpgpu::GaussProc gauss1, gauss2;
+        ogles_gpgpu::GainProc gain(2), other(2); // other keeps the GL_TEXTURE_2D program alive
+        video.set(&gain);
+        gain.add(&other);
+        video({ { test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT });
 
-        video.set(&gauss1);
-        gauss1.add(&gauss2);
-        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        // camera input after init(): the program is rebuilt for the external target
+        GLuint external = 0;
+        glGenTextures(1, &external);
+        glBindTexture(GL_TEXTURE_EXTERNAL_OES, external);
+        glBindTexture(GL_TEXTURE_EXTERNAL_OES, 0);
+        gain.useTexture(external, gain.getTextureUnit(), GL_TEXTURE_EXTERNAL_OES);
+        gain.render();
+        ASSERT_EQ(glGetError(), GL_NO_ERROR);
+        glDeleteTextures(1, &external);
 
+        GLint program = 0;
+        GLfloat uploaded = 0.f;
+        glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+        glGetUniformfv(program, glGetUniformLocation(program, "gain"), &uploaded);
+        ASSERT_EQ(uploaded, 2.f);
+
+        // and again for GL_TEXTURE_2D, with the gain uploaded to the new program
         cv::Mat result;
-        getImage(gauss2, result);
-        ASSERT_FALSE(result.empty());
+        video({ { test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT });
+        getImage(gain, result);
+        ASSERT_EQ(static_cast<int>(cv::mean(result)[0]), value * 2);
     }
 }
+#endif
 
-TEST(OGLESGPGPUTest, GaussianOptProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+TEST(OGLESGPGPUTest, Warmup) {
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
     if (context && *context) {
-        cv::Mat test = getTestImage(gWidth, gHeight, 1, true, OGLES_GPGPU_TEXTURE_FORMAT);
+        static const int value = 10, g = 2;
+        cv::Mat test(gWidth, gHeight, CV_8UC4, cv::Scalar(value, value, value, 255));
 
         glActiveTexture(GL_TEXTURE0);
         ogles_gpgpu::VideoSource video;
-        ogles_gpgpu::GaussOptProc gauss;
+        ogles_gpgpu::GainProc gain(g);
+        ogles_gpgpu::FifoProc fifo(3);
+        ogles_gpgpu::IirFilterProc iir(ogles_gpgpu::IirFilterProc::kLowPass, 0.5f);
+        video.set(&gain);
+        gain.add(&fifo);
+        gain.add(&iir);
+
+        video.warmup({ test.cols, test.rows });
+
+        // the blank warmup frame must not be part of the frame history:
+        ASSERT_EQ(fifo.getBufferCount(), 0u);
+        ASSERT_TRUE(iir.isFirst);
 
-        video.set(&gauss);
         video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        ASSERT_EQ(fifo.getBufferCount(), 1u);
 
         cv::Mat result;
-        getImage(gauss, result);
-        ASSERT_FALSE(result.empty());
+        getImage(*fifo[0], result);
+        ASSERT_EQ(static_cast<int>(cv::mean(result)[0]), value * g);
+
+        getImage(iir, result);
+        ASSERT_EQ(static_cast<int>(cv::mean(result)[0]), value * g);
     }
 }
 
-TEST(OGLESGPGPUTest, BoxOptProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+TEST(OGLESGPGPUTest, GPUTiming) {
+    ogles_gpgpu::TimingStats stats;
+    for (int i = 1; i <= 100; i++) {
+        stats.add(static_cast<double>(i));
+    }
+    ASSERT_EQ(stats.getLast(), 100.0);
+    ASSERT_EQ(stats.getMean(), 50.5);
+    ASSERT_EQ(stats.getP50(), 50.0);
+    ASSERT_EQ(stats.getP95(), 95.0);
+    ASSERT_EQ(stats.getP99(), 99.0);
+
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
     if (context && *context) {
-        cv::Mat test = getTestImage(gWidth, gHeight, 1, true, OGLES_GPGPU_TEXTURE_FORMAT);
+        cv::Mat test = getTestImage(gWidth, gHeight, 10, true, OGLES_GPGPU_TEXTURE_FORMAT);
 
         glActiveTexture(GL_TEXTURE0);
         ogles_gpgpu::VideoSource video;
-        ogles_gpgpu::BoxOptProc box;
+        ogles_gpgpu::GaussOptProc gauss(2.0f);
+        ogles_gpgpu::GrayscaleProc gray;
+        video.set(&gauss);
+        gauss.add(&gray);
+        gauss.setGPUTiming(true);
+        gray.setGPUTiming(true);
 
-        video.set(&box);
+        static const int frames = 10;
+        for (int i = 0; i < frames; i++) {
+            video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        }
+        glFinish();
         video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
-
-        cv::Mat result;
-        getImage(box, result);
-        ASSERT_FALSE(result.empty());
+        ASSERT_EQ(glGetError(), GL_NO_ERROR);
+
+        // the results of earlier frames are available after glFinish() (frames with too many
+        // pending results are skipped)
+        for (auto proc : { static_cast<ogles_gpgpu::ProcInterface*>(&gauss), static_cast<ogles_gpgpu::ProcInterface*>(&gray) }) {
+            const auto& timing = proc->getGPUTimingStats();
+            if (ogles_gpgpu::GPUTimer::isSupported()) {
+                ASSERT_GE(timing.getCount(), 1u);
+                ASSERT_LE(timing.getCount(), static_cast<std::size_t>(frames));
+                ASSERT_GT(timing.getMean(), 0.0);
+            } else {
+                ASSERT_EQ(timing.getCount(), 0u);
+            }
+        }
     }
 }
 
-TEST(OGLESGPGPUTest, HessianProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+TEST(OGLESGPGPUTest, StageTimings) {
+    ogles_gpgpu::Histogram histogram;
+    for (int i = 1; i <= 1000; i++) {
+        histogram.add(i * 0.01);
+    }
+    ASSERT_EQ(histogram.getCount(), 1000u);
+    ASSERT_EQ(histogram.getMax(), 10.0);
+    ASSERT_NEAR(histogram.getP50(), 5.0, 5.0 * 0.1); // half a bin width
+    ASSERT_NEAR(histogram.getP95(), 9.5, 9.5 * 0.1);
+
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
     if (context && *context) {
-        cv::Mat test(gWidth, gHeight, CV_8UC1, cv::Scalar::all(0));
+        cv::Mat test = getTestImage(gWidth, gHeight, 10, true, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::GaussOptProc gauss(2.0f);
+        ogles_gpgpu::GrayscaleProc gray;
+        gray.setProcTitle("gray");
+        video.set(&gauss);
+        gauss.add(&gray);
+
+        auto& timings = video.getStageTimings();
+        timings.setEnabled(true);
+        video.warmup({ test.cols, test.rows });
+
+        static const int frames = 10;
+        for (int i = 0; i < frames; i++) {
+            video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        }
+
+        // the warmup frame is not measured
+        const auto stages = timings.snapshot();
+        ASSERT_EQ(stages.size(), 4u);
+        for (const auto& name : { "upload", gauss.getProcName(), "gray", "process" }) {
+            auto stage = std::find_if(stages.begin(), stages.end(), [&](const ogles_gpgpu::StageTimings::Stage& s) { return s.name == name; });
+            ASSERT_NE(stage, stages.end());
+            ASSERT_EQ(stage->histogram.getCount(), static_cast<std::size_t>(frames));
+        }
+
+        timings.reset();
+        ASSERT_TRUE(timings.snapshot().empty());
+    }
+}
+
+TEST(OGLESGPGPUTest, MannWhitneyUTest) {
+    // exact p values without ties
+    auto result = ogles_gpgpu::mannWhitneyUTest({ 1, 2, 3, 4, 5 }, { 6, 7, 8, 9, 10 });
+    ASSERT_EQ(result.u, 0.0);
+    ASSERT_NEAR(result.p, 2.0 / 252.0, 1e-9);
+    result = ogles_gpgpu::mannWhitneyUTest({ 1, 3, 5, 7, 9 }, { 2, 4, 6, 8, 10 });
+    ASSERT_EQ(result.u, 10.0);
+    ASSERT_NEAR(result.p, 174.0 / 252.0, 1e-9);
+
+    // normal approximation with ties
+    result = ogles_gpgpu::mannWhitneyUTest({ 1, 2, 2, 3, 4 }, { 3, 5, 5, 6, 7 });
+    ASSERT_EQ(result.u, 1.5);
+    ASSERT_NEAR(result.p, 0.0269, 1e-4);
+
+    // no difference can be found without samples
+    ASSERT_EQ(ogles_gpgpu::mannWhitneyUTest({}, { 1, 2 }).p, 1.0);
+}
+
+TEST(OGLESGPGPUTest, Tracer) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        cv::Mat test = getTestImage(gWidth, gHeight, 10, true, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::GaussOptProc gauss(2.0f);
+        ogles_gpgpu::GrayscaleProc gray;
+        video.set(&gauss);
+        gauss.add(&gray);
+
+        ogles_gpgpu::Tracer tracer;
+        video.getStageTimings().setTracer(&tracer);
+        video.warmup({ test.cols, test.rows });
+
+        static const int frames = 5;
+        tracer.start();
+        for (int i = 0; i < frames; i++) {
+            video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        }
+        tracer.stop();
+
+        // frames outside of start() / stop() are not recorded
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        video.getStageTimings().setTracer(nullptr);
+
+        // upload, process, gauss and gray per frame
+        ASSERT_EQ(tracer.getEventCount(), static_cast<std::size_t>(frames * 4));
+
+        std::stringstream json;
+        tracer.write(json);
+        ASSERT_NE(json.str().find("\"traceEvents\""), std::string::npos);
+        ASSERT_NE(json.str().find("\"name\":\"upload\""), std::string::npos);
+    }
+}
+
+TEST(OGLESGPGPUTest, MemoryUsage) {
+    ogles_gpgpu::MemoryUsage usage;
+    usage.addTexture(GL_RGBA, 640, 480);
+    usage.addTexture(GL_LUMINANCE, 640, 480);
+    usage.pixelBuffers = 1024;
+    ASSERT_EQ(usage.getTextureBytes(), 640u * 480u * 5u);
+    ASSERT_EQ(usage.getTotal(), 640u * 480u * 5u + 1024u);
+
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        cv::Mat test = getTestImage(gWidth, gHeight, 10, true, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        const std::size_t before = ogles_gpgpu::GPUMemory::getCurrent();
+        {
+            glActiveTexture(GL_TEXTURE0);
+            ogles_gpgpu::VideoSource video;
+            ogles_gpgpu::GaussOptProc gauss(2.0f);
+            ogles_gpgpu::GrayscaleProc gray;
+            video.set(&gauss);
+            gauss.add(&gray);
+
+            video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+
+            // the two passes of the gaussian are counted for the multipass processor
+            const std::size_t frameBytes = static_cast<std::size_t>(test.cols) * test.rows * 4;
+            const auto report = video.getMemoryReport();
+            ASSERT_EQ(report.size(), 2u);
+            ASSERT_GE(report[0].second.getTextureBytes(), frameBytes * 3); // input and two outputs
+            ASSERT_GE(report[1].second.getTextureBytes(), frameBytes);
+            ASSERT_EQ(gauss.getMemoryUsage().getTotal(), report[0].second.getTotal());
+
+            // all allocations are reported to GPUMemory
+            const std::size_t total = ogles_gpgpu::getTotal(report).getTotal();
+            ASSERT_EQ(ogles_gpgpu::GPUMemory::getCurrent() - before, total);
+            ASSERT_GE(video.getPrepareMemoryPeak() - before, total);
+        }
+        ASSERT_EQ(ogles_gpgpu::GPUMemory::getCurrent(), before);
+    }
+}
+
+TEST(OGLESGPGPUTest, GLCallCounts) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        cv::Mat test = getTestImage(gWidth, gHeight, 10, true, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::GaussOptProc gauss(2.0f);
+        ogles_gpgpu::GrayscaleProc gray;
+        video.set(&gauss);
+        gauss.add(&gray);
+
+        // nothing is counted unless enabled
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        ASSERT_EQ(video.getGLCallCounts(), ogles_gpgpu::GLCallCounts());
+
+        ogles_gpgpu::GLCounters::setEnabled(true);
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        const ogles_gpgpu::GLCallCounts frame = video.getGLCallCounts();
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        ogles_gpgpu::GLCounters::setEnabled(false);
+
+        // one draw call per pass, the same calls for each frame
+        ASSERT_EQ(gauss.getGLCallCounts().drawCalls, 2u);
+        ASSERT_EQ(gray.getGLCallCounts().drawCalls, 1u);
+        ASSERT_EQ(frame.drawCalls, 3u);
+        ASSERT_EQ(frame.finishes, 0u);
+        ASSERT_EQ(video.getGLCallCounts(), frame);
+    }
+}
+
+TEST(OGLESGPGPUTest, FrameLatency) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        cv::Mat test = getTestImage(gWidth, gHeight, 10, true, OGLES_GPGPU_TEXTURE_FORMAT);
+        cv::Mat result(test.size(), CV_8UC4);
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::GaussOptProc gauss(2.0f);
+        ogles_gpgpu::GrayscaleProc gray;
+        video.set(&gauss);
+        gauss.add(&gray);
+        video.getLatencyTracker().setEnabled(true);
+
+        static const int frames = 5;
+        for (int i = 1; i <= frames; i++) {
+            ogles_gpgpu::FrameInput frame({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+            frame.frameId = 100 + i;
+            frame.captureTime = std::chrono::steady_clock::now() - std::chrono::milliseconds(2);
+            video(frame);
+
+            // the frame id is passed on to the processors and to the result data
+            ASSERT_EQ(gauss.getFrameId(), frame.frameId);
+            ASSERT_EQ(gray.getFrameId(), frame.frameId);
+            gray.getResultData(result.ptr<unsigned char>());
+            ASSERT_EQ(gray.getResultFrameId(), frame.frameId);
+
+            ogles_gpgpu::FrameLatency latency;
+            ASSERT_TRUE(video.getLatencyTracker().complete(gray.getResultFrameId(), &latency));
+            ASSERT_EQ(latency.frameId, frame.frameId);
+            ASSERT_GE(latency.queue, 2.0);
+            ASSERT_GE(latency.getTotal(), latency.queue);
+        }
+
+        // frames can be completed once
+        ASSERT_FALSE(video.getLatencyTracker().complete(101));
+        ASSERT_EQ(video.getLatencyTracker().getTotalStats().getCount(), static_cast<std::size_t>(frames));
+        ASSERT_GE(video.getLatencyTracker().getTotalStats().getP50(), 2.0);
+    }
+}
+
+#if defined(OGLES_GPGPU_OPENGL_ES3)
+TEST(OGLESGPGPUTest, FrameLatencyAsync) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        cv::Mat test = getTestImage(gWidth, gHeight, 10, true, OGLES_GPGPU_TEXTURE_FORMAT);
+        cv::Mat result(test.size(), CV_8UC4);
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::GaussOptProc gauss(2.0f);
+        ogles_gpgpu::GrayscaleProc gray;
+        video.set(&gauss);
+        gauss.add(&gray);
+        video.getLatencyTracker().setEnabled(true);
+
+        // start the readback of the first frame
+        ogles_gpgpu::FrameInput first({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        first.frameId = 201;
+        video(first);
+        gray.getResultData(nullptr);
+        ASSERT_TRUE(gray.getMemTransferObj()->isReadingAsynchronously(0));
+
+        // and finish it after the second frame: the data is from the first one
+        ogles_gpgpu::FrameInput second({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        second.frameId = 202;
+        video(second);
+        ASSERT_EQ(gray.getFrameId(), second.frameId);
+        gray.getResultData(result.ptr<unsigned char>());
+        ASSERT_EQ(gray.getResultFrameId(), first.frameId);
+        ASSERT_TRUE(video.getLatencyTracker().complete(gray.getResultFrameId()));
+
+        // a synchronous read delivers the current frame
+        gray.getResultData(result.ptr<unsigned char>());
+        ASSERT_EQ(gray.getResultFrameId(), second.frameId);
+    }
+}
+#endif
+
+TEST(OGLESGPGPUTest, ShaderCost) {
+    const char* vsh = "attribute vec4 position;\n"
+                      "varying vec2 uv;\n"
+                      "void main() { uv = position.xy * 0.5 + 0.5; gl_Position = position; }\n";
+    const char* fsh = "precision mediump float;\n"
+                      "#define OG_READ(coord) texture2D(t, coord)\n"
+                      "uniform sampler2D t;\n"
+                      "varying vec2 uv;\n"
+                      "varying vec2 taps[2]; // unused\n"
+                      "void main() {\n"
+                      "    vec4 a = OG_READ(uv) + texture2D(t, uv.yx); /* texture2D(t, uv) */\n"
+                      "    ivec2 size = textureSize(t, 0);\n"
+                      "    gl_FragColor = sqrt(a * OG_READ(uv + vec2(-1.0 / 640.0, 0.0)));\n"
+                      "}\n";
+
+    const auto cost = ogles_gpgpu::ShaderCost::analyze(vsh, fsh);
+    ASSERT_EQ(cost.textureFetches, 3);
+    ASSERT_EQ(cost.dependentReads, 1);
+    ASSERT_EQ(cost.aluOps, 4 + ogles_gpgpu::ShaderCost::kTranscendentalWeight); // + * + / and sqrt()
+    ASSERT_EQ(cost.vertexAluOps, 2);
+    ASSERT_EQ(cost.varyings, 1);
+    ASSERT_EQ(cost.precision, "mediump");
+    ASSERT_GT(cost.getCostPerPixel(), double(cost.aluOps + cost.textureFetches));
+
+    // the predicted cost of the separable gaussian grows with its radius
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    if (context && *context) {
+        cv::Mat test = getTestImage(gWidth, gHeight, 10, true, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::GaussOptProc small(2.0f), large(8.0f);
+        small.setProcTitle("small");
+        large.setProcTitle("large");
+        video.set(&small);
+        small.add(&large);
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        const auto graph = video.getGraph();
+        double smallCost = -1.0, largeCost = -1.0;
+        for (const auto& node : graph.getNodes()) {
+            if (node.name == "small") {
+                smallCost = node.cost;
+            } else if (node.name == "large") {
+                largeCost = node.cost;
+            }
+        }
+        ASSERT_GT(smallCost, 0.0);
+        ASSERT_GT(largeCost, smallCost);
+    }
+}
+
+TEST(OGLESGPGPUTest, PipelineGraph) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        cv::Mat test = getTestImage(gWidth, gHeight, 10, true, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::GaussOptProc gauss(2.0f);
+        ogles_gpgpu::FifoProc fifo(2);
+        ogles_gpgpu::DiffProc diff;
+        ogles_gpgpu::GrayscaleProc gray;
+        video.set(&gauss);
+        gauss.add(&diff, 0);
+        gauss.add(&fifo);
+        fifo.add(&diff, 1);
+        fifo.addWithDelay(&gray, 0, 1);
+
+        for (int i = 0; i < 3; i++) {
+            video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        }
+
+        const auto graph = video.getGraph();
+        const auto& nodes = graph.getNodes();
+        auto find = [&](ogles_gpgpu::ProcInterface& proc) {
+            for (int i = 0; i < int(nodes.size()); i++) {
+                if (nodes[i].name == proc.getStageName() && nodes[i].parent < 0) {
+                    return i;
+                }
+            }
+            return -1;
+        };
+
+        // gaussian, its two passes, fifo, diff and gray
+        ASSERT_EQ(nodes.size(), 6u);
+        const int g = find(gauss), f = find(fifo), d = find(diff), y = find(gray);
+        ASSERT_TRUE(g >= 0 && f >= 0 && d >= 0 && y >= 0);
+
+        // the passes are children of the multipass processor, which sums up their costs
+        ASSERT_EQ(nodes[g].passes, 2);
+        ASSERT_GE(nodes[g].cpuMs, 0.0);
+        ASSERT_EQ(nodes[g].bytes, gauss.getMemoryUsage().getTotal());
+        ASSERT_FALSE(nodes[g].format.empty());
+        double fetches = 0.0;
+        for (const auto& node : nodes) {
+            if (node.parent == g) {
+                ASSERT_GT(node.fetches, 1);
+                ASSERT_LT(node.cpuMs, 0.0);
+                fetches += node.fetchesPerFrame;
+            }
+        }
+        ASSERT_GT(fetches, 0.0);
+        ASSERT_EQ(nodes[g].fetchesPerFrame, fetches);
+
+        // the gaussian renders into the fifo, so that it doesn't copy
+        ASSERT_EQ(nodes[f].passes, 0);
+        ASSERT_EQ(nodes[d].passes, 1);
+        ASSERT_EQ(nodes[d].fetches, diff.getShaderCost().textureFetches);
+        ASSERT_DOUBLE_EQ(nodes[d].cost, diff.getShaderCost().getCostPerPixel() * nodes[d].width * nodes[d].height);
+
+        auto hasEdge = [&](int from, int to, ogles_gpgpu::PipelineGraph::EdgeType type, int position, int delay) {
+            for (const auto& edge : graph.getEdges()) {
+                if (edge.from == from && edge.to == to && edge.type == type && edge.position == position && edge.delay == delay) {
+                    return true;
+                }
+            }
+            return false;
+        };
+        ASSERT_TRUE(hasEdge(g, d, ogles_gpgpu::PipelineGraph::kSubscriber, 0, 0));
+        ASSERT_TRUE(hasEdge(f, d, ogles_gpgpu::PipelineGraph::kSubscriber, 1, 0));
+        ASSERT_TRUE(hasEdge(f, y, ogles_gpgpu::PipelineGraph::kDelayed, 0, 1));
+
+        const std::string dot = graph.toDot();
+        ASSERT_NE(dot.find("digraph"), std::string::npos);
+        ASSERT_NE(dot.find("subgraph cluster_" + std::to_string(g)), std::string::npos);
+        ASSERT_NE(graph.toJSON().find("\"type\":\"delayed\""), std::string::npos);
+    }
+}
+
+TEST(OGLESGPGPUTest, TransformProc) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::GainProc gain(1.f);
+        ogles_gpgpu::TransformProc transform;
+
+        video.set(&gain);
+        gain.add(&transform);
+
+        ogles_gpgpu::Mat44f matrix;
+        for (int y = 0; y < 4; y++) {
+            for (int x = 0; x < 4; x++) {
+                matrix.data[y][x] = 0;
+            }
+            matrix.data[y][y] = 1.f;
+        }
+        matrix.data[0][0] = 0.25f;
+
+        transform.setTransformMatrix(matrix);
+
+        cv::Mat test = getTestImage(gWidth, gHeight, 10, true, OGLES_GPGPU_TEXTURE_FORMAT);
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        cv::Mat result;
+        getImage(transform, result);
+        ASSERT_FALSE(result.empty());
+    }
+}
+
+TEST(OGLESGPGPUTest, MeshProc) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+
+        cv::Mat test = getTestImage(gWidth, gHeight, 10, true, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        const float w = gWidth;
+        const float h = gHeight;
+        std::vector<std::array<float,3>> verticesT, vertices
+        {
+            {{0.f, 0.f, 0.f}},
+            {{w, 0.f, 0.f}},
+            {{w, h, 0.f}},
+            {{0.f, h, 0.f}},
+            {{w/2.f,h/2.f,0.f}} // demonstrate stretching center point
+        };
+
+        std::vector<std::array<float,2>> coordsT, coords
+        {
+            {{0.f, 0.f}},
+            {{1.f, 0.f}},
+            {{1.f, 1.f}},
+            {{0.f, 1.f}},
+            {{0.5f,0.5f}} // center point
+        };
+        
+        // Create explicit GL_TRIANGLES vertices and coords
+        cv::Mat2f xy(gHeight, gWidth);
+        
+        for(int y = 0; y < 4; y++)
+        {
+            for(const auto &i : {(y+0)%4,(y+1)%4,4})
+            {
+                coordsT.push_back(coords[i]);
+                verticesT.push_back(vertices[i]);
+            }
+        }
+        
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::MeshShaderProc mesh(verticesT, coordsT);
+        mesh.setTriangleKind(GL_TRIANGLES);
+
+        video.set(&mesh);
+
+        const cv::Matx33f S(cv::Matx33f::diag({(2.f/gWidth),2.f/gHeight,1.f}));
+        const cv::Matx33f T(1.f,0.f,-1.f,0.f,1.f,-1.f,0.f,0.f,1.f);
+        const cv::Matx33f Ht = (T * S).t();
+
+        const std::array<int,4> index {{0,1,3}};
+        ogles_gpgpu::Mat44f matrix;
+        for(int y = 0; y < 4; y++) {
+            for(int x = 0; x < 4; x++) {
+                matrix.data[y][x] = 0.f;
+            }
+            matrix.data[y][y] = 1.f;            
+        }
+        
+        for(int y = 0; y < 3; y++) {
+            for(int x = 0; x < 3; x++) {
+                matrix.data[index[y]][index[x]] = Ht(y,x);
+            }
+        }
+
+        mesh.setModelViewProjection(matrix);
+
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        cv::Mat result;
+        getImage(mesh, result);
+        ASSERT_FALSE(result.empty());
+
+        auto error = cv::norm(result, test, cv::NORM_L1) / static_cast<float>(gWidth*gHeight*4);
+        ASSERT_LE(error, 1);
+    }
+}
+
+TEST(OGLESGPGPUTest, DiffProc) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        const int value = 2;
+        const int a = 1, b = 10;
+        cv::Mat test(gWidth, gHeight, CV_8UC4, cv::Scalar(value, value, value, 255));
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::GainProc gain1(a), gain10(b);
+        ogles_gpgpu::DiffProc diff;
+
+        gain1.add(&diff, 1);
+        gain1.add(&gain10);
+        gain10.add(&diff, 0);
+
+        video.set(&gain1);
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        cv::Mat result;
+        getImage(diff, result);
+        ASSERT_EQ(static_cast<int>(cv::mean(result)[0]), static_cast<int>(static_cast<float>((value * a * b) - (value * a))));
+    }
+}
+
+TEST(OGLESGPGPUTest, GaussianProc) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        cv::Mat test = getTestImage(gWidth, gHeight, 1, true, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::GaussProc gauss1, gauss2;
+
+        video.set(&gauss1);
+        gauss1.add(&gauss2);
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        cv::Mat result;
+        getImage(gauss2, result);
+        ASSERT_FALSE(result.empty());
+    }
+}
+
+TEST(OGLESGPGPUTest, GaussianOptProc) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        cv::Mat test = getTestImage(gWidth, gHeight, 1, true, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::GaussOptProc gauss;
+
+        video.set(&gauss);
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        cv::Mat result;
+        getImage(gauss, result);
+        ASSERT_FALSE(result.empty());
+    }
+}
+
+TEST(OGLESGPGPUTest, BoxOptProc) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        cv::Mat test = getTestImage(gWidth, gHeight, 1, true, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::BoxOptProc box;
+
+        video.set(&box);
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        cv::Mat result;
+        getImage(box, result);
+        ASSERT_FALSE(result.empty());
+    }
+}
+
+TEST(OGLESGPGPUTest, SeparableFilterProc) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        // horizontal ramp with a slope of 1 (per pixel)
+        cv::Mat test(gHeight, 256, CV_8UC4);
+        for (int x = 0; x < test.cols; x++) {
+            test.col(x).setTo(cv::Scalar(x, x, x, 255));
+        }
+
+        // derivative of gaussian reads: no center read, neighbouring weights are merged
+        const auto dx = ogles_gpgpu::SeparableKernel::gaussianDerivative(4, 2.f);
+        ASSERT_EQ(dx.getTaps().size(), 4u);
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::SeparableFilterProc gradient(dx, ogles_gpgpu::SeparableKernel::gaussian(4, 2.f), 0.5f);
+
+        video.set(&gradient);
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        cv::Mat result;
+        getImage(gradient, result);
+        ASSERT_FALSE(result.empty());
+
+        // 0.5 + 1/255 inside of the image
+        const cv::Vec4b value = result.at<cv::Vec4b>(result.rows / 2, result.cols / 2);
+        ASSERT_NEAR(static_cast<int>(value[0]), 128 + 1, 1);
+    }
+}
+
+TEST(OGLESGPGPUTest, SeparableFilterProcIntegerTaps) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        // horizontal ramp with a slope of 1 (per pixel)
+        cv::Mat test(gHeight, 256, CV_8UC4);
+        for (int x = 0; x < test.cols; x++) {
+            test.col(x).setTo(cv::Scalar(x, x, x, 255));
+        }
+
+        // a shift by one pixel and an identity: offsets and weights are written as "1.00000"
+        const ogles_gpgpu::SeparableKernel shift(std::vector<GLfloat>{ 0.f, 0.f, 1.f });
+        const ogles_gpgpu::SeparableKernel identity(std::vector<GLfloat>{ 1.f });
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::SeparableFilterProc shifted(shift, identity);
+
+        video.set(&shifted);
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        ASSERT_EQ(glGetError(), GL_NO_ERROR);
+
+        cv::Mat result;
+        getImage(shifted, result);
+        ASSERT_FALSE(result.empty());
+
+        const cv::Vec4b value = result.at<cv::Vec4b>(result.rows / 2, result.cols / 2);
+        ASSERT_EQ(static_cast<int>(value[0]), result.cols / 2 + 1);
+    }
+}
+
+TEST(OGLESGPGPUTest, ComputeBackend) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        cv::Mat test = getTestImage(gWidth, gHeight, 10, true, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        cv::Mat results[2];
+        for (int compute = 0; compute < 2; compute++) {
+            glActiveTexture(GL_TEXTURE0);
+            ogles_gpgpu::VideoSource video;
+            ogles_gpgpu::GaussOptProc gauss(2.0f);
+            gauss.setBackend(compute ? ogles_gpgpu::FilterProcBase::kComputeBackend : ogles_gpgpu::FilterProcBase::kFragmentBackend);
+
+            video.set(&gauss);
+            video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+            ASSERT_EQ(glGetError(), GL_NO_ERROR);
+
+#if defined(OGLES_GPGPU_COMPUTE)
+            auto pass = dynamic_cast<ogles_gpgpu::FilterProcBase*>(gauss[1]);
+            ASSERT_EQ(pass->getBackend() == ogles_gpgpu::FilterProcBase::kComputeBackend, compute && ogles_gpgpu::GLCaps::get().computeShaders);
+#endif
+
+            getImage(gauss, results[compute]);
+            ASSERT_FALSE(results[compute].empty());
+        }
+
+        // the fragment shaders read neighbouring pixels with one bilinear read
+        ASSERT_LE(cv::norm(results[0], results[1], cv::NORM_INF), 2.0);
+    }
+}
+
+#if defined(OGLES_GPGPU_COMPUTE)
+TEST(OGLESGPGPUTest, ComputeBackendTargetChange) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context && ogles_gpgpu::GLCaps::get().computeShaders) {
+        cv::Mat test = getTestImage(gWidth, gHeight, 10, true, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::GaussOptProc gauss(2.0f);
+        gauss.setBackend(ogles_gpgpu::FilterProcBase::kComputeBackend);
+        video.set(&gauss);
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        auto pass = dynamic_cast<ogles_gpgpu::FilterProcBase*>(gauss[0]);
+        ASSERT_EQ(pass->getBackend(), ogles_gpgpu::FilterProcBase::kComputeBackend);
+
+        // the compute shaders take GL_TEXTURE_2D input only
+        gauss.useTexture(video.getInputTexId(), gauss.getTextureUnit(), GL_TEXTURE_RECTANGLE);
+        ASSERT_EQ(pass->getBackend(), ogles_gpgpu::FilterProcBase::kFragmentBackend);
+
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        ASSERT_EQ(pass->getBackend(), ogles_gpgpu::FilterProcBase::kComputeBackend);
+    }
+}
+#endif
+
+TEST(OGLESGPGPUTest, HessianProc) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        cv::Mat test(gWidth, gHeight, CV_8UC1, cv::Scalar::all(0));
 
         static const int tic = 20;
         for (int y = tic; y <= test.rows - tic; y += tic) {
@@ -942,7 +1892,7 @@ TEST(OGLESGPGPUTest, HessianProc) {
 }
 
 TEST(OGLESGPGPUTest, LbpProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -963,7 +1913,7 @@ TEST(OGLESGPGPUTest, LbpProc) {
 }
 
 TEST(OGLESGPGPUTest, Fir3Proc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -1009,7 +1959,7 @@ TEST(OGLESGPGPUTest, Fir3Proc) {
 }
 
 TEST(OGLESGPGPUTest, GradProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -1030,7 +1980,7 @@ TEST(OGLESGPGPUTest, GradProc) {
 }
 
 TEST(OGLESGPGPUTest, LowPassProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -1057,7 +2007,7 @@ TEST(OGLESGPGPUTest, LowPassProc) {
 }
 
 TEST(OGLESGPGPUTest, HighPassProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -1084,7 +2034,7 @@ TEST(OGLESGPGPUTest, HighPassProc) {
 }
 
 TEST(OGLESGPGPUTest, ThreshProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -1105,7 +2055,7 @@ TEST(OGLESGPGPUTest, ThreshProc) {
 }
 
 TEST(OGLESGPGPUTest, PyramidProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -1125,8 +2075,37 @@ TEST(OGLESGPGPUTest, PyramidProc) {
     }
 }
 
+TEST(OGLESGPGPUTest, PyramidProcLevels) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        cv::Mat test = getTestImage(gWidth, gHeight, 2, true, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::PyramidProc pyramid(3);
+        video.set(&pyramid);
+
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        cv::Mat result;
+        getImage(pyramid, result);
+        ASSERT_FALSE(result.empty());
+
+        // all levels are rendered in a single draw, each one must match a bilinear resize of the input:
+        for (const auto& crop : pyramid.getLevelCrops()) {
+            cv::Mat level;
+            cv::resize(test, level, { crop.width, crop.height }, 0, 0, cv::INTER_LINEAR);
+            cv::Mat roi = result(cv::Rect(crop.x, crop.y, crop.width, crop.height));
+            ASSERT_TRUE(almost_equal(cv::Mat4b(level), cv::Mat4b(roi), static_cast<std::uint8_t>(2)));
+        }
+    }
+}
+
 TEST(OGLESGPGPUTest, IxytProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -1159,7 +2138,7 @@ TEST(OGLESGPGPUTest, IxytProc) {
 }
 
 TEST(OGLESGPGPUTest, TensorProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -1180,7 +2159,7 @@ TEST(OGLESGPGPUTest, TensorProc) {
 }
 
 TEST(OGLESGPGPUTest, ShiTomasiProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -1214,7 +2193,7 @@ TEST(OGLESGPGPUTest, ShiTomasiProc) {
 }
 
 TEST(OGLESGPGPUTest, HarrisProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -1248,7 +2227,7 @@ TEST(OGLESGPGPUTest, HarrisProc) {
 }
 
 TEST(OGLESGPGPUTest, NmsProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -1281,8 +2260,50 @@ TEST(OGLESGPGPUTest, NmsProc) {
     }
 }
 
+TEST(OGLESGPGPUTest, ShaderVariants) {
+    ASSERT_NE(ogles_gpgpu::ShaderVariants::find("NmsProc", "bb"), nullptr);
+    ASSERT_NE(ogles_gpgpu::ShaderVariants::find("GaussProcPass", "7r"), nullptr);
+    ASSERT_EQ(ogles_gpgpu::ShaderVariants::find("NmsProc", "xy"), nullptr);
+    ASSERT_GE(ogles_gpgpu::ShaderVariants::getAll().size(), 20u);
+
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        cv::Mat test = getTestImage(gWidth, gHeight, 10, true, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::GaussProc gauss(ogles_gpgpu::GaussProcPass::k7Tap, true);
+        ogles_gpgpu::NmsProc nms, reference; // R to B and R to R
+        nms.swizzle(0, 2);
+
+        video.set(&gauss);
+        gauss.add(&nms);
+        gauss.add(&reference);
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        ASSERT_EQ(glGetError(), GL_NO_ERROR);
+
+        cv::Mat result, expected;
+        getImage(nms, result);
+        getImage(reference, expected);
+        ASSERT_FALSE(result.empty());
+
+#if OGLES_GPGPU_RGBA_FORMAT
+        cv::extractChannel(result, result, 2);
+        cv::extractChannel(expected, expected, 0);
+#else
+        cv::extractChannel(result, result, 0);
+        cv::extractChannel(expected, expected, 2);
+#endif
+        ASSERT_GT(cv::countNonZero(expected), 0);
+        ASSERT_EQ(cv::countNonZero(result != expected), 0);
+    }
+}
+
 TEST(OGLESGPGPUTest, FlowProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -1310,8 +2331,52 @@ TEST(OGLESGPGPUTest, FlowProc) {
     }
 }
 
+#if !defined(OGLES_GPGPU_OPENGL_ES2)
+TEST(OGLESGPGPUTest, FlowImplXYProc) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    ASSERT_EQ(glGetError(), GL_NO_ERROR);
+    if (context && *context) {
+        cv::Mat test = getTestImage(gWidth, gHeight, 3, true, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::GainProc gain(1.f);
+        ogles_gpgpu::FlowImplProc flowX(true), flowY(false);
+        ogles_gpgpu::FlowImplXYProc flowXY;
+        ogles_gpgpu::GainProc gainX(1.f), gainY(1.f);
+
+        video.set(&gain);
+        gain.add(&flowX);
+        gain.add(&flowY);
+        gain.add(&flowXY);
+        flowXY.addToOutput(&gainX, 0);
+        flowXY.addToOutput(&gainY, 1);
+
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        // Each render target must match the corresponding single output pass:
+        cv::Mat resultX, resultY, resultXY[2];
+        getImage(flowX, resultX);
+        getImage(flowY, resultY);
+        for (int i = 0; i < 2; i++) {
+            resultXY[i].create(flowXY.getOutFrameH(), flowXY.getOutFrameW(), CV_8UC4);
+            flowXY.getOutputData(i, resultXY[i].ptr());
+        }
+        ASSERT_EQ(cv::countNonZero(resultX.reshape(1) != resultXY[0].reshape(1)), 0);
+        ASSERT_EQ(cv::countNonZero(resultY.reshape(1) != resultXY[1].reshape(1)), 0);
+
+        // Subscribers receive the output they were attached to:
+        cv::Mat resultGainY;
+        getImage(gainY, resultGainY);
+        ASSERT_EQ(cv::countNonZero(resultY.reshape(1) != resultGainY.reshape(1)), 0);
+    }
+}
+#endif // !defined(OGLES_GPGPU_OPENGL_ES2)
+
 TEST(OGLESGPGPUTest, Rgb2HsvProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -1332,7 +2397,7 @@ TEST(OGLESGPGPUTest, Rgb2HsvProc) {
 }
 
 TEST(OGLESGPGPUTest, Hsv2RgbProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -1353,7 +2418,7 @@ TEST(OGLESGPGPUTest, Hsv2RgbProc) {
 }
 
 TEST(OGLESGPGPUTest, LNormProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     ASSERT_EQ(glGetError(), GL_NO_ERROR);
@@ -1380,7 +2445,7 @@ TEST(OGLESGPGPUTest, LNormProc) {
 // > could not compile shader program.  error log:
 // > 0:1(380): preprocessor error: syntax error, unexpected HASH_TOKEN
 TEST(OGLESGPGPUTest, MedianProc) {
-    auto context = aglet::GLContext::create(aglet::GLContext::kAuto, {}, gWidth, gHeight, gVersion);
+    auto context = createContext();
     (*context)();
     ASSERT_TRUE(context && (*context));
     if (context && *context) {
@@ -1402,8 +2467,80 @@ TEST(OGLESGPGPUTest, MedianProc) {
         cv::Mat result;
         getImage(median, result);
         ASSERT_FALSE(result.empty());
+
+        // the 3x3 neighborhood is read through the OG_TEXEL() macro
+        ASSERT_EQ(median.getGraph().getNodes()[0].fetches, 9);
     }
 }
+
+TEST(OGLESGPGPUTest, Filter3x3TexelFetch) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    if (context && *context) {
+        cv::Mat test = getTestImage(gWidth, gHeight, 10, true, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        // texelFetch() and interpolated reads of the 3x3 neighborhood are equal
+        cv::Mat results[2];
+        for (int texelFetch = 0; texelFetch < 2; texelFetch++) {
+            glActiveTexture(GL_TEXTURE0);
+            ogles_gpgpu::VideoSource video;
+            ogles_gpgpu::MedianProc median;
+            median.setTexelFetch(texelFetch);
+
+            video.set(&median);
+            video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+            ASSERT_EQ(median.useTexelFetch(), texelFetch && ogles_gpgpu::GLCaps::get().glsl3Shaders);
+
+            getImage(median, results[texelFetch]);
+            ASSERT_FALSE(results[texelFetch].empty());
+        }
+
+        ASSERT_EQ(cv::countNonZero(results[0].reshape(1) != results[1].reshape(1)), 0);
+    }
+}
+
+#if defined(GL_TEXTURE_EXTERNAL_OES)
+TEST(OGLESGPGPUTest, Filter3x3TexelFetchTargetChange) {
+    auto context = createContext();
+    (*context)();
+    ASSERT_TRUE(context && (*context));
+    if (context && *context) {
+        cv::Mat test = getTestImage(gWidth, gHeight, 10, true, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        glActiveTexture(GL_TEXTURE0);
+        ogles_gpgpu::VideoSource video;
+        ogles_gpgpu::MedianProc median;
+        video.set(&median);
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+
+        cv::Mat expected;
+        getImage(median, expected);
+
+        // camera input after init(): texelFetch() does not apply to external textures
+        GLuint external = 0;
+        glGenTextures(1, &external);
+        glBindTexture(GL_TEXTURE_EXTERNAL_OES, external);
+        glBindTexture(GL_TEXTURE_EXTERNAL_OES, 0);
+        median.useTexture(external, median.getTextureUnit(), GL_TEXTURE_EXTERNAL_OES);
+        ASSERT_FALSE(median.useTexelFetch());
+        median.render();
+        ASSERT_EQ(glGetError(), GL_NO_ERROR);
+        glDeleteTextures(1, &external);
+
+        GLint program = 0; // interpolated reads with texel steps
+        glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+        ASSERT_GE(glGetUniformLocation(program, "texelWidth"), 0);
+
+        // and back to GL_TEXTURE_2D
+        cv::Mat result;
+        video({ test.cols, test.rows }, test.ptr<void>(), true, 0, OGLES_GPGPU_TEXTURE_FORMAT);
+        ASSERT_EQ(median.useTexelFetch(), ogles_gpgpu::GLCaps::get().glsl3Shaders);
+        getImage(median, result);
+        ASSERT_EQ(cv::countNonZero(expected.reshape(1) != result.reshape(1)), 0);
+    }
+}
+#endif
 #endif
 
 static cv::Vec3f cvtColorRgb2Luv(const cv::Vec3f& rgb)